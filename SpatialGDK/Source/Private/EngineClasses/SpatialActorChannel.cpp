@@ -13,10 +13,12 @@
 #include "EngineClasses/SpatialNetConnection.h"
 #include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
+#include "Interop/SpatialEntityPool.h"
 #include "Interop/SpatialSender.h"
 #include "Interop/SpatialReceiver.h"
 #include "Interop/GlobalStateManager.h"
 #include "SpatialConstants.h"
+#include "SpatialGDKSettings.h"
 #include "Utils/EntityRegistry.h"
 #include "Utils/RepLayoutUtils.h"
 
@@ -65,6 +67,10 @@ USpatialActorChannel::USpatialActorChannel(const FObjectInitializer& ObjectIniti
 	, NetDriver(nullptr)
 	, LastSpatialPosition(FVector::ZeroVector)
 	, LastSpatialRotation(FRotator::ZeroRotator)
+	, LastSpatialPositionUpdateTime(0.0f)
+	, bUsePushModel(false)
+	, bIsPushModelFullCompare(false)
+	, LastPushModelFullCompareTime(-1.0f)
 	, bCreatingNewEntity(false)
 {
 }
@@ -129,6 +135,15 @@ bool USpatialActorChannel::CleanUp(const bool bForDestroy)
 	}
 #endif
 
+	if (bUsePushModel && Actor != nullptr)
+	{
+		NetDriver->PushModelTracker.Remove(Actor);
+		for (UActorComponent* ActorComponent : Actor->GetReplicatedComponents())
+		{
+			NetDriver->PushModelTracker.Remove(ActorComponent);
+		}
+	}
+
 	return UActorChannel::CleanUp(bForDestroy);
 }
 
@@ -207,11 +222,12 @@ int64 USpatialActorChannel::ReplicateActor()
 	check(Connection);
 	check(Connection->PackageMap);
 
-	const UWorld* const ActorWorld = Actor->GetWorld();
-
 	// Time how long it takes to replicate this particular actor
 	STAT(FScopeCycleCounterUObject FunctionScope(Actor));
 
+	// Everything the sender sends from here on is on behalf of this actor, including its Position and Rotation updates.
+	const uint64 BytesSentBefore = Sender->GetBytesSent();
+
 	// Create an outgoing bunch (to satisfy some of the functions below).
 	FOutBunch Bunch(this, 0);
 	if (Bunch.IsError())
@@ -220,31 +236,21 @@ int64 USpatialActorChannel::ReplicateActor()
 	}
 
 	bIsReplicatingActor = true;
-	FReplicationFlags RepFlags;
+	const FReplicationFlags RepFlags = GetReplicationFlags();
 
 	// Send initial stuff.
-	if (OpenPacketId.First == INDEX_NONE)
+	if (RepFlags.bNetInitial)
 	{
-		RepFlags.bNetInitial = true;
 		Bunch.bClose = Actor->bNetTemporary;
 		Bunch.bReliable = true; // Net temporary sends need to be reliable as well to force them to retry
 	}
 
-	// Here, Unreal would have determined if this connection belongs to this actor's Outer.
-	// We don't have this concept when it comes to connections, our ownership-based logic is in the interop layer.
-	// Setting this to true, but should not matter in the end.
-	RepFlags.bNetOwner = true;
-
 	// If initial, send init data.
 	if (RepFlags.bNetInitial && OpenedLocally)
 	{
 		Actor->OnSerializeNewActor(Bunch);
 	}
 
-	RepFlags.bNetSimulated = (Actor->GetRemoteRole() == ROLE_SimulatedProxy);
-	RepFlags.bRepPhysics = Actor->ReplicatedMovement.bRepPhysics;
-	RepFlags.bReplay = ActorWorld && (ActorWorld->DemoNetDriver == Connection->GetDriver());
-
 	UE_LOG(LogNetTraffic, Log, TEXT("Replicate %s, bNetInitial: %d, bNetOwner: %d"), *Actor->GetName(), RepFlags.bNetInitial, RepFlags.bNetOwner);
 
 	FMemMark MemMark(FMemStack::Get());	// The calls to ReplicateProperties will allocate memory on FMemStack::Get(), and use it in ::PostSendBunch. we free it below
@@ -268,10 +274,23 @@ int64 USpatialActorChannel::ReplicateActor()
 		UpdateSpatialRotation();
 	}
 	
+	if (bUsePushModel)
+	{
+		// Unmarked properties, e.g. engine properties of the actor, are picked up by periodic full comparisons.
+		const float FullCompareInterval = GetDefault<USpatialGDKSettings>()->PushModelFullCompareInterval;
+		bIsPushModelFullCompare = bCreatingNewEntity || bForceCompareProperties || LastPushModelFullCompareTime < 0.0f
+			|| (FullCompareInterval > 0.0f && NetDriver->Time - LastPushModelFullCompareTime >= FullCompareInterval);
+
+		if (bIsPushModelFullCompare)
+		{
+			LastPushModelFullCompareTime = NetDriver->Time;
+		}
+	}
+
 	// Update the replicated property change list.
 	FRepChangelistState* ChangelistState = ActorReplicator->ChangelistMgr->GetRepChangelistState();
 	bool bWroteSomethingImportant = false;
-	ActorReplicator->ChangelistMgr->Update(Actor, Connection->Driver->ReplicationFrame, ActorReplicator->RepState->LastCompareIndex, RepFlags, bForceCompareProperties);
+	CompareObjectProperties(Actor, *ActorReplicator, RepFlags);
 
 	const int32 PossibleNewHistoryIndex = ActorReplicator->RepState->HistoryEnd % FRepState::MAX_CHANGE_HISTORY;
 	FRepChangedHistory& PossibleNewHistoryItem = ActorReplicator->RepState->ChangeHistory[PossibleNewHistoryIndex];
@@ -310,7 +329,14 @@ int64 USpatialActorChannel::ReplicateActor()
 	{
 		if (bCreatingNewEntity)
 		{
-			Sender->SendCreateEntityRequest(this);
+			if (GetDefault<USpatialGDKSettings>()->bBatchSpawnWaveEntityCreation)
+			{
+				Sender->QueueCreateEntityRequest(this);
+			}
+			else
+			{
+				Sender->SendCreateEntityRequest(this);
+			}
 
 			// Since we've tried to create this Actor in Spatial, we no longer have authority over the actor since it hasn't been delegated to us.
 			Actor->Role = ROLE_SimulatedProxy;
@@ -387,7 +413,51 @@ int64 USpatialActorChannel::ReplicateActor()
 
 	bForceCompareProperties = false;		// Only do this once per frame when set
 
-	return (bWroteSomethingImportant) ? 1 : 0;	// TODO: return number of bits written (UNR-664)
+	// Queued entity creations are sent, and measured, later in the tick. They still count as a write, as do updates left
+	// waiting on unresolved references, so the net driver treats the actor as replicated.
+	const int64 BitsWritten = (int64)(Sender->GetBytesSent() - BytesSentBefore) * 8;
+	return (BitsWritten > 0) ? BitsWritten : (bWroteSomethingImportant ? 1 : 0);
+}
+
+FReplicationFlags USpatialActorChannel::GetReplicationFlags() const
+{
+	const UWorld* const ActorWorld = Actor->GetWorld();
+
+	FReplicationFlags RepFlags;
+	RepFlags.bNetInitial = OpenPacketId.First == INDEX_NONE;
+
+	// Here, Unreal would have determined if this connection belongs to this actor's Outer.
+	// We don't have this concept when it comes to connections, our ownership-based logic is in the interop layer.
+	// Setting this to true, but should not matter in the end.
+	RepFlags.bNetOwner = true;
+
+	RepFlags.bNetSimulated = (Actor->GetRemoteRole() == ROLE_SimulatedProxy);
+	RepFlags.bRepPhysics = Actor->ReplicatedMovement.bRepPhysics;
+	RepFlags.bReplay = ActorWorld && (ActorWorld->DemoNetDriver == Connection->GetDriver());
+
+	return RepFlags;
+}
+
+void USpatialActorChannel::AddParallelPropertyComparisons(FParallelPropertyComparer& Comparer)
+{
+	// New entities, forced comparisons and push model actors are compared on the game thread in ReplicateActor.
+	if (Actor == nullptr || Closing || !IsReadyForReplication() || bCreatingNewEntity || bForceCompareProperties || bUsePushModel)
+	{
+		return;
+	}
+
+	const FReplicationFlags RepFlags = GetReplicationFlags();
+
+	Comparer.AddObject(Actor, *ActorReplicator, RepFlags);
+
+	for (UActorComponent* ActorComponent : Actor->GetReplicatedComponents())
+	{
+		// Replicators can only be created on the game thread, so components replicating for the first time are compared in ReplicateActor.
+		if (TSharedRef<FObjectReplicator>* ComponentReplicator = ReplicationMap.Find(ActorComponent))
+		{
+			Comparer.AddObject(ActorComponent, ComponentReplicator->Get(), RepFlags);
+		}
+	}
 }
 
 bool USpatialActorChannel::ReplicateSubobject(UObject* Object, FClassInfo* Info, const FReplicationFlags& RepFlags)
@@ -399,7 +469,7 @@ bool USpatialActorChannel::ReplicateSubobject(UObject* Object, FClassInfo* Info,
 
 	FObjectReplicator& Replicator = FindOrCreateReplicator(Object).Get();
 	FRepChangelistState* ChangelistState = Replicator.ChangelistMgr->GetRepChangelistState();
-	Replicator.ChangelistMgr->Update(Object, Replicator.Connection->Driver->ReplicationFrame, Replicator.RepState->LastCompareIndex, RepFlags, bForceCompareProperties);
+	CompareObjectProperties(Object, Replicator, RepFlags);
 
 	const int32 PossibleNewHistoryIndex = Replicator.RepState->HistoryEnd % FRepState::MAX_CHANGE_HISTORY;
 	FRepChangedHistory& PossibleNewHistoryItem = Replicator.RepState->ChangeHistory[PossibleNewHistoryIndex];
@@ -443,6 +513,44 @@ bool USpatialActorChannel::ReplicateSubobject(UObject* Obj, FOutBunch& Bunch, co
 	return ReplicateSubobject(Obj, NetDriver->TypebindingManager->FindClassInfoByObject(Obj), RepFlags);
 }
 
+void USpatialActorChannel::CompareObjectProperties(UObject* Object, FObjectReplicator& Replicator, const FReplicationFlags& RepFlags)
+{
+	if (!bUsePushModel)
+	{
+		Replicator.ChangelistMgr->Update(Object, Replicator.Connection->Driver->ReplicationFrame, Replicator.RepState->LastCompareIndex, RepFlags, bForceCompareProperties);
+		return;
+	}
+
+	FPushModelTracker& PushModelTracker = NetDriver->PushModelTracker;
+	FPushModelStats& Stats = PushModelTracker.GetStats();
+
+	const bool bIsDirty = PushModelTracker.ConsumeDirtyState(Object);
+
+	if (!bIsDirty && !bIsPushModelFullCompare)
+	{
+		Stats.NumSkippedObjects++;
+		return;
+	}
+
+	// Dirty objects go through the same rep layout comparison as polled ones, so role swapping, replication conditions
+	// and RepNotify conditions behave identically. FRepLayout can't compare a subset of parents without engine changes,
+	// so the saving comes from skipping clean objects, and only which objects are dirty is tracked.
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	Replicator.ChangelistMgr->Update(Object, Replicator.Connection->Driver->ReplicationFrame, Replicator.RepState->LastCompareIndex, RepFlags, bForceCompareProperties);
+	const uint64 CompareCycles = FPlatformTime::Cycles64() - StartCycles;
+
+	if (bIsPushModelFullCompare)
+	{
+		Stats.NumFullCompares++;
+		Stats.FullCompareCycles += CompareCycles;
+	}
+	else
+	{
+		Stats.NumPushCompares++;
+		Stats.PushCompareCycles += CompareCycles;
+	}
+}
+
 TMap<UObject*, FClassInfo*> USpatialActorChannel::GetHandoverSubobjects()
 {
 	FClassInfo* Info = NetDriver->TypebindingManager->FindClassInfoByClass(Actor->GetClass());
@@ -540,6 +648,11 @@ void USpatialActorChannel::SetChannelActor(AActor* InActor)
 {
 	Super::SetChannelActor(InActor);
 
+	TransformUpdateSettings = GetDefault<USpatialGDKSettings>()->GetTransformUpdateSettings(InActor->GetClass());
+
+	bUsePushModel = NetDriver->IsServer() && NetDriver->PushModelTracker.IsPushModelClass(InActor->GetClass());
+	LastPushModelFullCompareTime = -1.0f;
+
 	if (NetDriver->TypebindingManager->FindClassInfoByClass(InActor->GetClass()) == nullptr)
 	{
 		return;
@@ -553,7 +666,19 @@ void USpatialActorChannel::SetChannelActor(AActor* InActor)
 	if (EntityId == 0)
 	{
 		bCreatingNewEntity = true;
-		Sender->SendReserveEntityIdRequest(this);
+
+		// Take an entity ID from the pool if there is one available, so the entity can be created on the next replication tick.
+		// Otherwise fall back to reserving a single entity ID and waiting for the response.
+		Worker_EntityId PooledEntityId = NetDriver->EntityPool != nullptr ? NetDriver->EntityPool->GetNextEntityId() : SpatialConstants::INVALID_ENTITY_ID;
+		if (PooledEntityId != SpatialConstants::INVALID_ENTITY_ID)
+		{
+			UE_LOG(LogSpatialActorChannel, Verbose, TEXT("Took entity id (%lld) from the entity pool for: %s."), PooledEntityId, *InActor->GetName());
+			OnEntityIdReserved(PooledEntityId);
+		}
+		else
+		{
+			Sender->SendReserveEntityIdRequest(this);
+		}
 	}
 	else
 	{
@@ -593,6 +718,11 @@ FObjectReplicator& USpatialActorChannel::PreReceiveSpatialUpdate(UObject* Target
 	TargetObject->PreNetReceive();
 	Replicator.RepLayout->InitShadowData(Replicator.RepState->StaticBuffer, TargetObject->GetClass(), (uint8*)TargetObject);
 
+	// The entity now holds values another worker sent, so what this worker last sent no longer says what's on the entity.
+	// Dropping the array delta states makes the next write of each array a full send, with fresh delta state.
+	FieldValueHashesMap.Remove(TargetObject);
+	ArrayDeltaStatesMap.Remove(TargetObject);
+
 	return Replicator;
 }
 
@@ -647,7 +777,12 @@ void USpatialActorChannel::OnReserveEntityIdResponse(const Worker_ReserveEntityI
 
 	UE_LOG(LogSpatialActorChannel, Verbose, TEXT("Reserved entity id (%lld) for: %s."), Op.entity_id, *Actor->GetName());
 
-	EntityId = Op.entity_id;
+	OnEntityIdReserved(Op.entity_id);
+}
+
+void USpatialActorChannel::OnEntityIdReserved(Worker_EntityId ReservedEntityId)
+{
+	EntityId = ReservedEntityId;
 	RegisterEntityId(EntityId);
 
 	// Register Actor with package map since we know what the entity id is.
@@ -691,14 +826,31 @@ void USpatialActorChannel::UpdateSpatialPosition()
 	// of the PlayerController and PlayerState at the same time as the pawn.
 
 	// Check that it has moved sufficiently far to be updated
-	const float SpatialPositionThreshold = 100.0f * 100.0f; // 1m (100cm)
+	const float SpatialPositionThreshold = FMath::Square(TransformUpdateSettings.PositionDistanceThreshold);
 	FVector ActorSpatialPosition = GetActorSpatialPosition(Actor);
-	if (FVector::DistSquared(ActorSpatialPosition, LastSpatialPosition) < SpatialPositionThreshold)
+	const float DistanceSquared = FVector::DistSquared(ActorSpatialPosition, LastSpatialPosition);
+	if (DistanceSquared < SpatialPositionThreshold)
+	{
+		// Actors that haven't moved at all are not counted, as there was nothing to send.
+		if (DistanceSquared > 0.0f)
+		{
+			Sender->RecordSkippedPositionUpdate(/* bRateLimited */ false);
+		}
+		return;
+	}
+
+	// Check that enough time has passed since the last update. LastSpatialPosition is kept as is,
+	// so the update goes out as soon as the rate limit allows.
+	const float CurrentTime = NetDriver->Time;
+	if (TransformUpdateSettings.MaxPositionUpdateFrequency > 0.0f
+		&& CurrentTime - LastSpatialPositionUpdateTime < 1.0f / TransformUpdateSettings.MaxPositionUpdateFrequency)
 	{
+		Sender->RecordSkippedPositionUpdate(/* bRateLimited */ true);
 		return;
 	}
 
 	LastSpatialPosition = ActorSpatialPosition;
+	LastSpatialPositionUpdateTime = CurrentTime;
 	Sender->SendPositionUpdate(EntityId, LastSpatialPosition);
 
 	// If we're a pawn and are controlled by a player controller, update the player controller and the player state positions too.
@@ -732,11 +884,16 @@ void USpatialActorChannel::UpdateSpatialRotation()
 	FRotator ActorSpatialRotation = Actor->GetActorRotation();
 
 	// Only update the Actor's rotation if it has rotated far enough
-	const float SpatialRotationThreshold = 0.1f;  // 0.1 radian (~5.7 degrees)
+	const float SpatialRotationThreshold = TransformUpdateSettings.RotationAngleThreshold;
 	FQuat RotationDelta = (ActorSpatialRotation - LastSpatialRotation).Quaternion();
 	RotationDelta.Normalize();
-	if (RotationDelta.GetAngle() < SpatialRotationThreshold)
+	const float RotationAngle = RotationDelta.GetAngle();
+	if (RotationAngle < SpatialRotationThreshold)
 	{
+		if (RotationAngle > 0.0f)
+		{
+			Sender->RecordSkippedRotationUpdate();
+		}
 		return;
 	}
 
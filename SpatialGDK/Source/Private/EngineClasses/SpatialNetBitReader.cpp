@@ -5,6 +5,7 @@
 #include "UObject/WeakObjectPtr.h"
 
 #include "EngineClasses/SpatialPackageMapClient.h"
+#include "Interop/ObjectRefPathDictionary.h"
 #include "SpatialConstants.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialNetBitReader);
@@ -22,10 +23,22 @@ void FSpatialNetBitReader::DeserializeObjectRef(FUnrealObjectRef& ObjectRef)
 	SerializeBits(&HasPath, 1);
 	if (HasPath)
 	{
-		FString Path;
-		*this << Path;
+		uint8 IsPathId;
+		SerializeBits(&IsPathId, 1);
+		if (IsPathId)
+		{
+			uint32 PathId;
+			SerializeIntPacked(PathId);
+
+			ObjectRef.Path = UObjectRefPathDictionary::MakePlaceholderPath(PathId);
+		}
+		else
+		{
+			FString Path;
+			*this << Path;
 
-		ObjectRef.Path = Path;
+			ObjectRef.Path = Path;
+		}
 	}
 
 	uint8 HasOuter;
@@ -5,12 +5,14 @@
 #include "UObject/WeakObjectPtr.h"
 
 #include "EngineClasses/SpatialPackageMapClient.h"
+#include "Interop/ObjectRefPathDictionary.h"
 #include "UObject/improbable/UnrealObjectRef.h"
 #include "SpatialConstants.h"
 
-FSpatialNetBitWriter::FSpatialNetBitWriter(USpatialPackageMapClient* InPackageMap, TSet<const UObject*>& InUnresolvedObjects)
+FSpatialNetBitWriter::FSpatialNetBitWriter(USpatialPackageMapClient* InPackageMap, TSet<const UObject*>& InUnresolvedObjects, UObjectRefPathDictionary* InPathDictionary /*= nullptr*/)
 	: FNetBitWriter(InPackageMap, 0)
 	, UnresolvedObjects(InUnresolvedObjects)
+	, PathDictionary(InPathDictionary)
 {}
 
 void FSpatialNetBitWriter::SerializeObjectRef(FUnrealObjectRef& ObjectRef)
@@ -22,7 +24,17 @@ void FSpatialNetBitWriter::SerializeObjectRef(FUnrealObjectRef& ObjectRef)
 	SerializeBits(&HasPath, 1);
 	if (HasPath)
 	{
-		*this << ObjectRef.Path.GetValue();
+		uint32 PathId = 0;
+		uint8 IsPathId = PathDictionary != nullptr && PathDictionary->FindOrRequestPathId(ObjectRef.Path.GetValue(), PathId);
+		SerializeBits(&IsPathId, 1);
+		if (IsPathId)
+		{
+			SerializeIntPacked(PathId);
+		}
+		else
+		{
+			*this << ObjectRef.Path.GetValue();
+		}
 	}
 
 	uint8 HasOuter = ObjectRef.Outer.IsSet();
@@ -4,6 +4,7 @@
 
 #include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
+#include "Interop/SpatialReplicationScheduler.h"
 
 USpatialNetConnection::USpatialNetConnection(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -63,3 +64,15 @@ void USpatialNetConnection::Tick()
 	}
 	Super::Tick();
 }
+
+void USpatialNetConnection::FlushDormancy(AActor* Actor)
+{
+	Super::FlushDormancy(Actor);
+
+	// The actor is active again, so make it due now rather than when the scheduler's resync sweep gets to it.
+	USpatialNetDriver* SpatialNetDriver = Cast<USpatialNetDriver>(Driver);
+	if (SpatialNetDriver != nullptr && SpatialNetDriver->ReplicationScheduler != nullptr)
+	{
+		SpatialNetDriver->ReplicationScheduler->ScheduleImmediate(Actor);
+	}
+}
@@ -7,6 +7,7 @@
 #include "Engine/ChildConnection.h"
 #include "Engine/Engine.h"
 #include "Engine/NetworkObjectList.h"
+#include "Misc/Paths.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameNetworkManager.h"
 #include "Net/DataReplication.h"
@@ -16,9 +17,12 @@
 
 #include "Interop/Connection/SpatialWorkerConnection.h"
 #include "Interop/GlobalStateManager.h"
+#include "Interop/ObjectRefPathDictionary.h"
 #include "Interop/SnapshotManager.h"
+#include "Interop/SpatialEntityPool.h"
 #include "Interop/SpatialPlayerSpawner.h"
 #include "Interop/SpatialReceiver.h"
+#include "Interop/SpatialReplicationScheduler.h"
 #include "Interop/SpatialSender.h"
 #include "Interop/SpatialTypebindingManager.h"
 #include "Interop/SpatialDispatcher.h"
@@ -28,7 +32,9 @@
 #include "EngineClasses/SpatialPackageMapClient.h"
 #include "EngineClasses/SpatialPendingNetGame.h"
 #include "SpatialConstants.h"
+#include "SpatialGDKSettings.h"
 #include "Utils/EntityRegistry.h"
+#include "Utils/PayloadCompression.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialOSNetDriver);
 
@@ -41,6 +47,8 @@ bool USpatialNetDriver::InitBase(bool bInitAsClient, FNetworkNotify* InNotify, c
 
 	bConnectAsClient = bInitAsClient;
 	bAuthoritativeDestruction = true;
+	ReplicationBitsThisTick = 0;
+	AverageReplicationBitsPerActor = 0.0f;
 
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &USpatialNetDriver::OnMapLoaded);
 
@@ -220,6 +228,39 @@ void USpatialNetDriver::OnMapLoadedAndConnected()
 	GlobalStateManager->Init(this, TimerManager);
 	SnapshotManager->Init(this);
 
+	// Only server workers create entities, so only they need a pool of reserved entity IDs.
+	if (!ServerConnection && GetDefault<USpatialGDKSettings>()->bEnableEntityPool)
+	{
+		EntityPool = NewObject<USpatialEntityPool>();
+		EntityPool->Init(this, TimerManager);
+	}
+
+	if (!ServerConnection && GetDefault<USpatialGDKSettings>()->bUseReplicationScheduler)
+	{
+		ReplicationScheduler = NewObject<USpatialReplicationScheduler>();
+		ReplicationScheduler->Init(this);
+	}
+
+	// The dictionary lives on the GSM entity, which only servers can read.
+	if (!ServerConnection)
+	{
+		ObjectRefPathDictionary = NewObject<UObjectRefPathDictionary>();
+		ObjectRefPathDictionary->Init(this);
+	}
+
+	ParallelPropertyComparer.SetMaxTasks(GetDefault<USpatialGDKSettings>()->ParallelPropertyComparisonMaxTasks);
+
+	if (GetDefault<USpatialGDKSettings>()->bPreRegisterStablyNamedObjects)
+	{
+		PackageMap->QueueStablyNamedObjectRegistration(GetWorld());
+
+		// Without a budget everything is registered before the first ops are processed, otherwise it continues in TickDispatch.
+		if (GetDefault<USpatialGDKSettings>()->StablyNamedObjectRegistrationBudgetMs <= 0.0f)
+		{
+			PackageMap->RegisterQueuedStablyNamedObjects(0.0);
+		}
+	}
+
 	// Bind the ProcessServerTravel delegate to the spatial variant. This ensures that if ServerTravel is called and Spatial networking is enabled, we can travel properly.
 	GetWorld()->SpatialProcessServerTravelDelegate.BindStatic(SpatialProcessServerTravel);
 
@@ -387,6 +428,18 @@ bool USpatialNetDriver::IsLevelInitializedForActor(const AActor* InActor, const
 	return true;
 }
 
+void USpatialNetDriver::NotifyActorDormancyChange(AActor* Actor, ENetDormancy OldDormancyState)
+{
+	Super::NotifyActorDormancyChange(Actor, OldDormancyState);
+
+	// An actor going dormant needs one more replication to be marked dormant, and one waking up should replicate straight
+	// away, so either way it's due on this tick rather than when the scheduler's resync sweep gets to it.
+	if (ReplicationScheduler != nullptr && Actor->GetIsReplicated())
+	{
+		ReplicationScheduler->ScheduleImmediate(Actor);
+	}
+}
+
 void USpatialNetDriver::NotifyActorDestroyed(AActor* ThisActor, bool IsSeamlessTravel /*= false*/)
 {
 	// Intentionally does not call Super::NotifyActorDestroyed, but most of the functionality is copied here 
@@ -420,6 +473,11 @@ void USpatialNetDriver::NotifyActorDestroyed(AActor* ThisActor, bool IsSeamlessT
 		}
 	}
 
+	if (ReplicationScheduler != nullptr)
+	{
+		ReplicationScheduler->RemoveActor(ThisActor);
+	}
+
 	// Remove this actor from the network object list
 	GetNetworkObjectList().Remove(ThisActor);
 
@@ -427,6 +485,22 @@ void USpatialNetDriver::NotifyActorDestroyed(AActor* ThisActor, bool IsSeamlessT
 	RenamedStartupActors.Remove(ThisActor->GetFName());
 }
 
+void USpatialNetDriver::Shutdown()
+{
+	if (OutgoingByteProfiler.IsEnabled())
+	{
+		const FString WorkerId = Connection != nullptr ? Connection->GetWorkerId() : FString(TEXT("Unknown"));
+		const FString FilePath = FPaths::ProfilingDir() / TEXT("SpatialGDK") / FString::Printf(TEXT("OutgoingBytes-%s-%s.csv"), *WorkerId, *FDateTime::Now().ToString());
+
+		if (OutgoingByteProfiler.WriteCSV(FilePath))
+		{
+			UE_LOG(LogSpatialOSNetDriver, Log, TEXT("Wrote outgoing byte profile to %s"), *FilePath);
+		}
+	}
+
+	Super::Shutdown();
+}
+
 //SpatialGDK: Functions in the ifdef block below are modified versions of the UNetDriver:: implementations.
 #if WITH_SERVER_CODE
 
@@ -523,6 +597,65 @@ int32 USpatialNetDriver::ServerReplicateActors_PrepConnections(const float Delta
 	return bFoundReadyConnection ? NumClientsToTick : 0;
 }
 
+// SpatialGDK: Same per-actor checks as UNetDriver::ServerReplicateActors_BuildConsiderList, but only for the actors the
+// replication scheduler says are due, and without adaptive net update frequency. The scheduler owns NextUpdateTime.
+void USpatialNetDriver::ServerReplicateActors_BuildScheduledConsiderList(TArray<FNetworkObjectInfo*>& OutConsiderList)
+{
+	TArray<FNetworkObjectInfo*> DueActors;
+	ReplicationScheduler->GatherDueActors(World->TimeSeconds, DueActors);
+
+	TArray<AActor*> ActorsToRemove;
+
+	for (FNetworkObjectInfo* ActorInfo : DueActors)
+	{
+		AActor* Actor = ActorInfo->Actor;
+
+		if (Actor->IsPendingKillPending() || Actor->GetRemoteRole() == ROLE_None)
+		{
+			ActorsToRemove.Add(Actor);
+			continue;
+		}
+
+		if (Actor->GetNetDriverName() != NetDriverName)
+		{
+			ReplicationScheduler->RemoveActor(Actor);
+			continue;
+		}
+
+		// Actors that aren't initialized yet, or are in a level that is still streaming, are retried next tick.
+		ULevel* Level = Actor->GetLevel();
+		if (!Actor->IsActorInitialized() || Level->HasVisibilityChangeRequestPending() || Level->bIsAssociatingLevel)
+		{
+			ReplicationScheduler->ScheduleImmediate(Actor);
+			continue;
+		}
+
+		if (Actor->NetDormancy == DORM_Initial && Actor->IsNetStartupActor())
+		{
+			continue;
+		}
+
+		if (ActorInfo->LastNetReplicateTime == 0)
+		{
+			ActorInfo->LastNetReplicateTime = World->TimeSeconds;
+			ActorInfo->OptimalNetUpdateDelta = 1.0f / Actor->NetUpdateFrequency;
+		}
+
+		ActorInfo->LastNetUpdateTime = Time;
+		ActorInfo->bPendingNetUpdate = false;
+
+		OutConsiderList.Add(ActorInfo);
+
+		Actor->CallPreReplication(this);
+	}
+
+	for (AActor* Actor : ActorsToRemove)
+	{
+		ReplicationScheduler->RemoveActor(Actor);
+		RemoveNetworkActor(Actor);
+	}
+}
+
 int32 USpatialNetDriver::ServerReplicateActors_PrioritizeActors(UNetConnection* InConnection, const TArray<FNetViewer>& ConnectionViewers, const TArray<FNetworkObjectInfo*> ConsiderList, const bool bCPUSaturated, FActorPriority*& OutPriorityList, FActorPriority**& OutPriorityActors)
 {
 	// Get list of visible/relevant actors.
@@ -562,6 +695,13 @@ int32 USpatialNetDriver::ServerReplicateActors_PrioritizeActors(UNetConnection*
 				continue;
 			}
 
+			// SpatialGDK: Dormant channels are kept open, so an actor that is considered again with a dormant channel
+			// has had its dormancy flushed. Its replicators still hold the state last sent, so only changes are sent.
+			if (Channel != nullptr && Channel->Dormant)
+			{
+				Channel->Dormant = false;
+			}
+
 			// See of actor wants to try and go dormant
 			if (ShouldActorGoDormant(Actor, ConnectionViewers, Channel, Time, bLowNetBandwidth))
 			{
@@ -638,6 +778,45 @@ int32 USpatialNetDriver::ServerReplicateActors_PrioritizeActors(UNetConnection*
 	return FinalSortedCount;
 }
 
+// SpatialGDK: Runs the property comparisons of the prioritized actors' channels up front, spread over task graph worker threads.
+// ReplicateActor then only has to serialize and send the changes, which relies on the package map and so stays on the game thread.
+void USpatialNetDriver::ServerReplicateActors_CompareProperties(FActorPriority** PriorityActors, const int32 FinalSortedCount)
+{
+	// With a replication budget, only the actors it is expected to reach are compared up front. The estimate is doubled so
+	// that a tick of smaller than average updates rarely runs past it; any actor past it that does get replicated is compared
+	// on the game thread by ReplicateActor, as usual.
+	int32 NumActorsToCompare = FinalSortedCount;
+	const uint32 MaxBytesPerTick = GetDefault<USpatialGDKSettings>()->MaxReplicationBytesPerTick;
+	if (MaxBytesPerTick > 0 && AverageReplicationBitsPerActor > 0.0f)
+	{
+		const float BudgetEstimateSafetyFactor = 2.0f;
+		const int64 RemainingBits = FMath::Max<int64>((int64)MaxBytesPerTick * 8 - ReplicationBitsThisTick, 0);
+		const float ExpectedActors = RemainingBits / AverageReplicationBitsPerActor * BudgetEstimateSafetyFactor;
+		if (ExpectedActors < FinalSortedCount)
+		{
+			NumActorsToCompare = FMath::CeilToInt(ExpectedActors);
+		}
+	}
+
+	for (int32 j = 0; j < NumActorsToCompare; j++)
+	{
+		// Skip deletion entries and actors that don't have a channel yet.
+		if (PriorityActors[j]->ActorInfo == nullptr)
+		{
+			continue;
+		}
+
+		if (USpatialActorChannel* Channel = Cast<USpatialActorChannel>(PriorityActors[j]->Channel))
+		{
+			Channel->AddParallelPropertyComparisons(ParallelPropertyComparer);
+		}
+	}
+
+	BandwidthStats.NumActorsNotPrecompared += FinalSortedCount - NumActorsToCompare;
+
+	ParallelPropertyComparer.Run(ReplicationFrame);
+}
+
 int32 USpatialNetDriver::ServerReplicateActors_ProcessPrioritizedActors(UNetConnection* InConnection, const TArray<FNetViewer>& ConnectionViewers, FActorPriority** PriorityActors, const int32 FinalSortedCount, int32& OutUpdated)
 {
 	if (!InConnection->IsNetReady(0))
@@ -758,7 +937,29 @@ int32 USpatialNetDriver::ServerReplicateActors_ProcessPrioritizedActors(UNetConn
 							LastRelevantActors.Add(Actor);
 						}
 
-						if (Channel->ReplicateActor())
+						const uint64 ReplicateStartCycles = FPlatformTime::Cycles64();
+						const int64 ReplicateResult = Channel->ReplicateActor();
+
+						if (ReplicationScheduler != nullptr)
+						{
+							ReplicationScheduler->RecordReplication(Actor, FPlatformTime::Cycles64() - ReplicateStartCycles);
+						}
+
+						// SpatialGDK: Unreal closes the channels of actors going dormant, which for us would delete their entities.
+						// Instead, the channel stays open and the actor is moved out of the active network object list, so it isn't
+						// considered for replication at all until FlushNetDormancy moves it back.
+						if (Channel->bPendingDormancy && Channel->IsReadyForSpatialDormancy())
+						{
+							UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("Actor %s is now dormant"), *Actor->GetName());
+							Channel->bPendingDormancy = false;
+							Channel->Dormant = true;
+							GetNetworkObjectList().MarkDormant(Actor, InConnection, 1, NetDriverName);
+						}
+
+						ReplicationBitsThisTick += ReplicateResult;
+						AverageReplicationBitsPerActor = AverageReplicationBitsPerActor > 0.0f ? FMath::Lerp(AverageReplicationBitsPerActor, (float)ReplicateResult, 0.05f) : (float)ReplicateResult;
+
+						if (ReplicateResult)
 						{
 							ActorUpdatesThisConnectionSent++;
 							if (DebugRelevantActors)
@@ -785,6 +986,17 @@ int32 USpatialNetDriver::ServerReplicateActors_ProcessPrioritizedActors(UNetConn
 						// We can bail out now since this connection is saturated, we'll return how far we got though
 						return j;
 					}
+
+					// SpatialGDK: The SpatialOS connection never saturates, so the send budget takes its place. Actors are sorted
+					// by priority, so the ones left over when the budget runs out are the lowest priority ones, and are deferred.
+					const uint32 MaxBytesPerTick = GetDefault<USpatialGDKSettings>()->MaxReplicationBytesPerTick;
+					if (MaxBytesPerTick > 0 && ReplicationBitsThisTick >= (int64)MaxBytesPerTick * 8)
+					{
+						// Only the remaining actors that are rescheduled by ServerReplicateActors count as deferred.
+						UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("Replication budget of %u bytes used up, deferring remaining actors to the next tick"), MaxBytesPerTick);
+						BandwidthStats.NumTicksOverBudget++;
+						return j + 1;
+					}
 				}
 			}
 
@@ -825,6 +1037,8 @@ int32 USpatialNetDriver::ServerReplicateActors(float DeltaSeconds)
 	// Bump the ReplicationFrame value to invalidate any properties marked as "unchanged" for this frame.
 	ReplicationFrame++;
 
+	ReplicationBitsThisTick = 0;
+
 	const int32 NumClientsToTick = ServerReplicateActors_PrepConnections(DeltaSeconds);
 
 	//SpatialGDK: This is a formality as there is at least one "perfect" Spatial connection in our design.
@@ -834,6 +1048,9 @@ int32 USpatialNetDriver::ServerReplicateActors(float DeltaSeconds)
 		return 0;
 	}
 
+	// Dirty marks on actors that aren't replicated through a channel are never consumed, so drop them before they accumulate.
+	PushModelTracker.PruneObjectsWithoutChannels(this);
+
 	AWorldSettings* WorldSettings = World->GetWorldSettings();
 
 	bool bCPUSaturated = false;
@@ -852,7 +1069,14 @@ int32 USpatialNetDriver::ServerReplicateActors(float DeltaSeconds)
 	ConsiderList.Reserve(GetNetworkObjectList().GetActiveObjects().Num());
 
 	// Build the consider list (actors that are ready to replicate)
-	ServerReplicateActors_BuildConsiderList(ConsiderList, ServerTickTime);
+	if (ReplicationScheduler != nullptr)
+	{
+		ServerReplicateActors_BuildScheduledConsiderList(ConsiderList);
+	}
+	else
+	{
+		ServerReplicateActors_BuildConsiderList(ConsiderList, ServerTickTime);
+	}
 	FMemMark Mark(FMemStack::Get());
 
 	for (int32 i = 0; i < ClientConnections.Num(); i++)
@@ -913,6 +1137,11 @@ int32 USpatialNetDriver::ServerReplicateActors(float DeltaSeconds)
 			// Get a sorted list of actors for this connection
 			const int32 FinalSortedCount = ServerReplicateActors_PrioritizeActors(SpatialConnection, ConnectionViewers, ConsiderList, bCPUSaturated, PriorityList, PriorityActors);
 
+			if (GetDefault<USpatialGDKSettings>()->bEnableParallelPropertyComparison)
+			{
+				ServerReplicateActors_CompareProperties(PriorityActors, FinalSortedCount);
+			}
+
 			// Process the sorted list of actors for this connection
 			const int32 LastProcessedActor = ServerReplicateActors_ProcessPrioritizedActors(SpatialConnection, ConnectionViewers, PriorityActors, FinalSortedCount, Updated);
 
@@ -934,16 +1163,26 @@ int32 USpatialNetDriver::ServerReplicateActors(float DeltaSeconds)
 				{
 					UE_LOG(LogNetTraffic, Log, TEXT(" Saturated. Mark %s NetUpdateTime to be checked for next tick"), *Actor->GetName());
 					PriorityActors[k]->ActorInfo->bPendingNetUpdate = true;
+					if (ReplicationScheduler != nullptr)
+					{
+						ReplicationScheduler->ScheduleImmediate(Actor);
+					}
+					BandwidthStats.NumActorsDeferred++;
 				}
 				else if (IsActorRelevantToConnection(Actor, ConnectionViewers))
 				{
 					// If this actor was relevant but didn't get processed, force another update for next frame
 					UE_LOG(LogNetTraffic, Log, TEXT(" Saturated. Mark %s NetUpdateTime to be checked for next tick"), *Actor->GetName());
 					PriorityActors[k]->ActorInfo->bPendingNetUpdate = true;
+					if (ReplicationScheduler != nullptr)
+					{
+						ReplicationScheduler->ScheduleImmediate(Actor);
+					}
 					if (Channel != NULL)
 					{
 						Channel->RelevantTime = Time + 0.5f * FMath::SRand();
 					}
+					BandwidthStats.NumActorsDeferred++;
 				}
 			}
 			RelevantActorMark.Pop();
@@ -951,6 +1190,11 @@ int32 USpatialNetDriver::ServerReplicateActors(float DeltaSeconds)
 		}
 	}
 
+	const uint64 BytesReplicated = ReplicationBitsThisTick / 8;
+	BandwidthStats.NumTicks++;
+	BandwidthStats.BytesReplicated += BytesReplicated;
+	BandwidthStats.PeakBytesPerTick = FMath::Max(BandwidthStats.PeakBytesPerTick, BytesReplicated);
+
 	// shuffle the list of connections if not all connections were ticked
 	if (NumClientsToTick < ClientConnections.Num())
 	{
@@ -988,6 +1232,11 @@ void USpatialNetDriver::TickDispatch(float DeltaTime)
 	// Not calling Super:: on purpose.
 	UNetDriver::TickDispatch(DeltaTime);
 
+	if (PackageMap != nullptr && PackageMap->HasQueuedStablyNamedObjects())
+	{
+		PackageMap->RegisterQueuedStablyNamedObjects(GetDefault<USpatialGDKSettings>()->StablyNamedObjectRegistrationBudgetMs / 1000.0);
+	}
+
 	if (Connection != nullptr && Connection->IsConnected())
 	{
 		Worker_OpList* OpList = Connection->GetOpList();
@@ -1035,7 +1284,16 @@ void USpatialNetDriver::ProcessRemoteFunction(
 
 	if (Function->FunctionFlags & FUNC_Net)
 	{
-		Sender->SendRPC(MakeShared<FPendingRPCParams>(CallingObject, Function, Parameters));
+		TSharedRef<FPendingRPCParams> RPCParams = MakeShared<FPendingRPCParams>(CallingObject, Function, Parameters);
+
+		if (!Function->HasAnyFunctionFlags(FUNC_NetReliable) && GetDefault<USpatialGDKSettings>()->bQueueUnreliableRPCs)
+		{
+			UnreliableRPCQueue.Enqueue(RPCParams);
+		}
+		else
+		{
+			Sender->SendRPC(RPCParams);
+		}
 	}
 }
 
@@ -1044,6 +1302,15 @@ void USpatialNetDriver::TickFlush(float DeltaTime)
 	// Super::TickFlush() will not call ReplicateActors() because Spatial connections have InternalAck set to true.
 	// In our case, our Spatial actor interop is triggered through ReplicateActors() so we want to call it regardless.
 
+	if (Sender != nullptr)
+	{
+		// Sent before coalesced multicasts are flushed, so unreliable multicasts among them still go out this tick.
+		UnreliableRPCQueue.Flush(GetDefault<USpatialGDKSettings>()->MaxUnreliableRPCsPerTick, [this](TSharedRef<FPendingRPCParams> RPCParams)
+		{
+			Sender->SendRPC(RPCParams);
+		});
+	}
+
 #if USE_SERVER_PERF_COUNTERS
 	double ServerReplicateActorsTimeMs = 0.0f;
 #endif // USE_SERVER_PERF_COUNTERS
@@ -1052,12 +1319,19 @@ void USpatialNetDriver::TickFlush(float DeltaTime)
 		// Update all clients.
 #if WITH_SERVER_CODE
 
+		// Send the multicast RPCs collected during the frame ahead of this tick's property updates,
+		// matching the order they'd have gone out in without coalescing.
+		Sender->FlushPendingMulticastRPCs();
+
 #if USE_SERVER_PERF_COUNTERS
 		double ServerReplicateActorsTimeStart = FPlatformTime::Seconds();
 #endif // USE_SERVER_PERF_COUNTERS
 
 		int32 Updated = ServerReplicateActors(DeltaTime);
 
+		// Send any entity creations that were queued up while replicating actors.
+		Sender->ProcessQueuedCreateEntityRequests();
+
 #if USE_SERVER_PERF_COUNTERS
 		ServerReplicateActorsTimeMs = (FPlatformTime::Seconds() - ServerReplicateActorsTimeStart) * 1000.0;
 #endif // USE_SERVER_PERF_COUNTERS
@@ -1072,6 +1346,12 @@ void USpatialNetDriver::TickFlush(float DeltaTime)
 #endif // WITH_SERVER_CODE
 	}
 
+	if (ObjectRefPathDictionary != nullptr)
+	{
+		// Paths first written this tick, by replication above or by RPCs during the frame.
+		ObjectRefPathDictionary->Flush();
+	}
+
 	Super::TickFlush(DeltaTime);
 }
 
@@ -1195,6 +1475,70 @@ bool USpatialNetDriver::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& A
 	{
 		return HandleNetDumpCrossServerRPCCommand(Cmd, Ar);
 	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALENTITYPOOL")))
+	{
+		return HandleDumpEntityPoolCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALTRANSFORMSTATS")))
+	{
+		return HandleDumpTransformUpdateStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALARRAYDELTASTATS")))
+	{
+		return HandleDumpArrayDeltaStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALPUSHMODELSTATS")))
+	{
+		return HandleDumpPushModelStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALREPLICATIONSCHEDULER")))
+	{
+		return HandleDumpReplicationSchedulerCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALPARALLELCOMPARESTATS")))
+	{
+		return HandleDumpParallelCompareStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("SPATIALPARALLELCOMPARETASKS")))
+	{
+		return HandleSetParallelCompareTasksCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALBANDWIDTHSTATS")))
+	{
+		return HandleDumpBandwidthStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALOUTGOINGBYTES")))
+	{
+		return HandleDumpOutgoingBytesCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALFIELDHASHSTATS")))
+	{
+		return HandleDumpFieldValueHashStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALMULTICASTSTATS")))
+	{
+		return HandleDumpMulticastRPCStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALUNRELIABLERPCSTATS")))
+	{
+		return HandleDumpUnreliableRPCStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALCOMPRESSIONSTATS")))
+	{
+		return HandleDumpCompressionStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALOBJECTREFPATHSTATS")))
+	{
+		return HandleDumpObjectRefPathStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALNETGUIDCACHESTATS")))
+	{
+		return HandleDumpNetGUIDCacheStatsCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMPSPATIALTYPEBINDINGSTATS")))
+	{
+		return HandleDumpTypebindingStatsCommand(Cmd, Ar);
+	}
 #endif // !UE_BUILD_SHIPPING
 	return UNetDriver::Exec(InWorld, Cmd, Ar);
 }
@@ -1281,6 +1625,265 @@ bool USpatialNetDriver::HandleNetDumpCrossServerRPCCommand(const TCHAR* Cmd, FOu
 #endif
 	return true;
 }
+
+bool USpatialNetDriver::HandleDumpEntityPoolCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (EntityPool == nullptr)
+	{
+		Ar.Logf(TEXT("Entity pool is not in use on this worker."));
+		return true;
+	}
+
+	EntityPool->DumpStats(Ar);
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpTransformUpdateStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (Sender == nullptr)
+	{
+		Ar.Logf(TEXT("Not connected to SpatialOS."));
+		return true;
+	}
+
+	Sender->DumpTransformUpdateStats(Ar);
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpArrayDeltaStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (Sender == nullptr)
+	{
+		Ar.Logf(TEXT("Not connected to SpatialOS."));
+		return true;
+	}
+
+	Sender->DumpArrayDeltaStats(Ar);
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpPushModelStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (!GetDefault<USpatialGDKSettings>()->bEnablePushModel)
+	{
+		Ar.Logf(TEXT("Push model replication is not enabled."));
+		return true;
+	}
+
+	PushModelTracker.DumpStats(Ar);
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpReplicationSchedulerCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (ReplicationScheduler == nullptr)
+	{
+		Ar.Logf(TEXT("Replication scheduler is not in use on this worker."));
+		return true;
+	}
+
+	ReplicationScheduler->DumpStats(Ar);
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpParallelCompareStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (!GetDefault<USpatialGDKSettings>()->bEnableParallelPropertyComparison)
+	{
+		Ar.Logf(TEXT("Parallel property comparison is disabled."));
+		return true;
+	}
+
+	ParallelPropertyComparer.DumpStats(Ar);
+
+	if (FParse::Command(&Cmd, TEXT("RESET")))
+	{
+		ParallelPropertyComparer.ResetStats();
+	}
+
+	return true;
+}
+
+// Changes the number of comparison tasks and resets the stats, so scaling can be measured by stepping from 1 task to the number of cores.
+bool USpatialNetDriver::HandleSetParallelCompareTasksCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	const FString MaxTasksString = FParse::Token(Cmd, false);
+	if (MaxTasksString.IsEmpty() || !MaxTasksString.IsNumeric())
+	{
+		Ar.Logf(TEXT("Usage: SPATIALPARALLELCOMPARETASKS <max tasks, 0 for all worker threads>"));
+		return true;
+	}
+
+	ParallelPropertyComparer.SetMaxTasks(FCString::Atoi(*MaxTasksString));
+	ParallelPropertyComparer.ResetStats();
+
+	Ar.Logf(TEXT("Parallel property comparison now uses up to %d tasks. Stats have been reset."), ParallelPropertyComparer.GetNumTasks());
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpBandwidthStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (Sender == nullptr)
+	{
+		Ar.Logf(TEXT("Not connected to SpatialOS."));
+		return true;
+	}
+
+	const uint64 SenderBytes = Sender->GetBytesSent() - BandwidthStats.SenderBytesAtReset;
+	const uint32 MaxBytesPerTick = GetDefault<USpatialGDKSettings>()->MaxReplicationBytesPerTick;
+
+	Ar.Logf(TEXT("Replication: %llu bytes over %llu ticks, %.1f bytes per tick on average, %llu bytes peak"),
+		BandwidthStats.BytesReplicated, BandwidthStats.NumTicks, BandwidthStats.NumTicks > 0 ? (double)BandwidthStats.BytesReplicated / BandwidthStats.NumTicks : 0.0, BandwidthStats.PeakBytesPerTick);
+	Ar.Logf(TEXT("Other sends (RPCs, queued entity creations, resolved references): %llu bytes"),
+		SenderBytes > BandwidthStats.BytesReplicated ? SenderBytes - BandwidthStats.BytesReplicated : 0);
+
+	if (MaxBytesPerTick > 0)
+	{
+		Ar.Logf(TEXT("Budget: %u bytes per tick, exceeded on %llu ticks, %llu actors deferred"), MaxBytesPerTick, BandwidthStats.NumTicksOverBudget, BandwidthStats.NumActorsDeferred);
+		Ar.Logf(TEXT("Actors left out of parallel comparison: %llu, %.1f bytes per replicated actor on average"), BandwidthStats.NumActorsNotPrecompared, AverageReplicationBitsPerActor / 8.0f);
+	}
+	else
+	{
+		Ar.Logf(TEXT("Budget: unlimited"));
+	}
+
+	if (FParse::Command(&Cmd, TEXT("RESET")))
+	{
+		BandwidthStats = FReplicationBandwidthStats();
+		BandwidthStats.SenderBytesAtReset = Sender->GetBytesSent();
+	}
+
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpOutgoingBytesCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (!OutgoingByteProfiler.IsEnabled())
+	{
+		Ar.Logf(TEXT("Outgoing byte profiling is disabled. Enable bEnableOutgoingByteProfiling in the SpatialOS GDK settings."));
+		return true;
+	}
+
+	// Usage: DUMPSPATIALOUTGOINGBYTES [number of entries, default 20] [RESET]
+	int32 NumEntries = 20;
+	const FString NumEntriesString = FParse::Token(Cmd, false);
+	if (NumEntriesString.IsNumeric())
+	{
+		NumEntries = FMath::Max(FCString::Atoi(*NumEntriesString), 1);
+	}
+
+	OutgoingByteProfiler.DumpTop(Ar, NumEntries);
+
+	if (NumEntriesString == TEXT("RESET") || FParse::Command(&Cmd, TEXT("RESET")))
+	{
+		OutgoingByteProfiler.Reset();
+	}
+
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpFieldValueHashStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (Sender == nullptr)
+	{
+		Ar.Logf(TEXT("Not connected to SpatialOS."));
+		return true;
+	}
+
+	Sender->DumpFieldValueHashStats(Ar);
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpMulticastRPCStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (Sender == nullptr)
+	{
+		Ar.Logf(TEXT("Not connected to SpatialOS."));
+		return true;
+	}
+
+	Sender->DumpMulticastRPCStats(Ar);
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpUnreliableRPCStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (!GetDefault<USpatialGDKSettings>()->bQueueUnreliableRPCs)
+	{
+		Ar.Logf(TEXT("Unreliable RPC queueing is disabled."));
+		return true;
+	}
+
+	UnreliableRPCQueue.DumpStats(Ar);
+
+	if (FParse::Command(&Cmd, TEXT("RESET")))
+	{
+		UnreliableRPCQueue.ResetStats();
+	}
+
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpCompressionStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (!GetDefault<USpatialGDKSettings>()->bEnablePayloadCompression)
+	{
+		Ar.Logf(TEXT("Payload compression is disabled."));
+		return true;
+	}
+
+	improbable::DumpPayloadCompressionStats(Ar);
+
+	if (FParse::Command(&Cmd, TEXT("RESET")))
+	{
+		improbable::GetPayloadCompressionStats() = FPayloadCompressionStats();
+	}
+
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpObjectRefPathStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (!GetDefault<USpatialGDKSettings>()->bEnableObjectRefPathInterning)
+	{
+		Ar.Logf(TEXT("Object ref path interning is disabled."));
+		return true;
+	}
+
+	if (ObjectRefPathDictionary == nullptr)
+	{
+		Ar.Logf(TEXT("Object ref paths are only interned by server workers."));
+		return true;
+	}
+
+	ObjectRefPathDictionary->DumpStats(Ar);
+
+	if (FParse::Command(&Cmd, TEXT("RESET")))
+	{
+		ObjectRefPathDictionary->ResetStats();
+	}
+
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpNetGUIDCacheStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	FSpatialNetGUIDCache* SpatialGuidCache = static_cast<FSpatialNetGUIDCache*>(GuidCache.Get());
+	SpatialGuidCache->DumpStats(Ar);
+
+	if (FParse::Command(&Cmd, TEXT("RESET")))
+	{
+		SpatialGuidCache->ResetStats();
+	}
+
+	return true;
+}
+
+bool USpatialNetDriver::HandleDumpTypebindingStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	TypebindingManager->DumpStats(Ar);
+	return true;
+}
 #endif // !UE_BUILD_SHIPPING
 
 USpatialPendingNetGame::USpatialPendingNetGame(const FObjectInitializer& ObjectInitializer)
@@ -4,15 +4,18 @@
 
 #include "EngineUtils.h"
 #include "Engine/Engine.h"
+#include "Engine/Level.h"
 #include "GameFramework/Actor.h"
 
 #include "EngineClasses/SpatialActorChannel.h"
 #include "EngineClasses/SpatialNetDriver.h"
 #include "Interop/Connection/SpatialWorkerConnection.h"
+#include "Interop/ObjectRefPathDictionary.h"
 #include "Interop/SpatialReceiver.h"
 #include "Interop/SpatialSender.h"
 #include "UObject/improbable/UnrealObjectRef.h"
 #include "SpatialConstants.h"
+#include "SpatialGDKSettings.h"
 #include "Utils/EntityRegistry.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialPackageMap);
@@ -78,6 +81,83 @@ FNetworkGUID USpatialPackageMapClient::ResolveStablyNamedObject(UObject* Object)
 	return SpatialGuidCache->AssignNewStablyNamedObjectNetGUID(Object);
 }
 
+void USpatialPackageMapClient::QueueStablyNamedObjectRegistration(UWorld* World)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	QueuedStablyNamedObjects.Reset();
+	NextQueuedStablyNamedObject = 0;
+	StablyNamedRegisterSeconds = 0.0;
+	StablyNamedRegistrationSlices = 0;
+
+	for (ULevel* Level : World->GetLevels())
+	{
+		if (Level == nullptr)
+		{
+			continue;
+		}
+
+		for (AActor* Actor : Level->Actors)
+		{
+			// Replicated actors are referred to by their entity once it exists, so they're left to be resolved when first referenced.
+			if (Actor == nullptr || Actor->IsPendingKill() || Actor->GetIsReplicated() || !Actor->IsFullNameStableForNetworking())
+			{
+				continue;
+			}
+
+			QueuedStablyNamedObjects.Add(Actor);
+
+			for (UActorComponent* Component : Actor->GetComponents())
+			{
+				if (Component != nullptr && Component->IsFullNameStableForNetworking())
+				{
+					QueuedStablyNamedObjects.Add(Component);
+				}
+			}
+		}
+	}
+
+	StablyNamedGatherSeconds = FPlatformTime::Seconds() - StartTime;
+}
+
+void USpatialPackageMapClient::RegisterQueuedStablyNamedObjects(double TimeBudgetSeconds)
+{
+	if (!HasQueuedStablyNamedObjects())
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	StablyNamedRegistrationSlices++;
+
+	// Outers are registered along with the first object inside them, so later objects in the same level are cheaper.
+	while (HasQueuedStablyNamedObjects())
+	{
+		if (UObject* Object = QueuedStablyNamedObjects[NextQueuedStablyNamedObject].Get())
+		{
+			ResolveStablyNamedObject(Object);
+		}
+		NextQueuedStablyNamedObject++;
+
+		// Checking the clock every object would cost more than registering most of them.
+		if (TimeBudgetSeconds > 0.0 && NextQueuedStablyNamedObject % 32 == 0 && FPlatformTime::Seconds() - StartTime >= TimeBudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	StablyNamedRegisterSeconds += FPlatformTime::Seconds() - StartTime;
+
+	if (!HasQueuedStablyNamedObjects())
+	{
+		UE_LOG(LogSpatialPackageMap, Log, TEXT("Registered %d stably named objects: %.2f ms gathering, %.2f ms registering over %d ticks."),
+			QueuedStablyNamedObjects.Num(), StablyNamedGatherSeconds * 1000.0, StablyNamedRegisterSeconds * 1000.0, StablyNamedRegistrationSlices);
+
+		QueuedStablyNamedObjects.Empty();
+		NextQueuedStablyNamedObject = 0;
+	}
+}
+
 FUnrealObjectRef USpatialPackageMapClient::GetUnrealObjectRefFromNetGUID(const FNetworkGUID & NetGUID) const
 {
 	FSpatialNetGUIDCache* SpatialGuidCache = static_cast<FSpatialNetGUIDCache*>(GuidCache.Get());
@@ -128,6 +208,22 @@ bool USpatialPackageMapClient::SerializeObject(FArchive& Ar, UClass* InClass, UO
 	return true;
 }
 
+namespace
+{
+
+// Stably named objects inside an entity have the entity's ref at the root of their outer chain.
+Worker_EntityId GetRootEntityId(const FUnrealObjectRef& ObjectRef)
+{
+	const FUnrealObjectRef* Root = &ObjectRef;
+	while (Root->Outer.IsSet())
+	{
+		Root = &Root->Outer.GetValue();
+	}
+	return Root->Entity;
+}
+
+}
+
 FSpatialNetGUIDCache::FSpatialNetGUIDCache(USpatialNetDriver* InDriver)
 	: FNetGUIDCache(InDriver)
 {
@@ -143,7 +239,7 @@ FNetworkGUID FSpatialNetGUIDCache::AssignNewEntityActorNetGUID(AActor* Actor, co
 	USpatialReceiver* Receiver = SpatialNetDriver->Receiver;
 
 	// Set up the NetGUID and ObjectRef for this actor.
-	FNetworkGUID NetGUID = GetOrAssignNetGUID_SpatialGDK(Actor);
+	FNetworkGUID NetGUID = GetOrAssignEntityObjectNetGUID(Actor);
 	FUnrealObjectRef ObjectRef(EntityId, 0);
 	RegisterObjectRef(NetGUID, ObjectRef);
 	UE_LOG(LogSpatialPackageMap, Verbose, TEXT("Registered new object ref for actor: %s. NetGUID: %s, entity ID: %lld"),
@@ -162,7 +258,7 @@ FNetworkGUID FSpatialNetGUIDCache::AssignNewEntityActorNetGUID(AActor* Actor, co
 		UObject* Subobject = Pair.Key;
 		uint32 Offset = Pair.Value;
 
-		FNetworkGUID SubobjectNetGUID = GetOrAssignNetGUID_SpatialGDK(Subobject);
+		FNetworkGUID SubobjectNetGUID = GetOrAssignEntityObjectNetGUID(Subobject);
 		FUnrealObjectRef SubobjectRef(EntityId, Offset);
 		RegisterObjectRef(SubobjectNetGUID, SubobjectRef);
 
@@ -209,41 +305,85 @@ FNetworkGUID FSpatialNetGUIDCache::AssignNewStablyNamedObjectNetGUID(UObject* Ob
 
 void FSpatialNetGUIDCache::RemoveEntityNetGUID(Worker_EntityId EntityId)
 {
-	// Remove actor subobjects.
-	USpatialNetDriver* SpatialNetDriver = Cast<USpatialNetDriver>(Driver);
-
-	AActor* Actor = SpatialNetDriver->EntityRegistry->GetActorFromEntityId(EntityId);
-	if (Actor == nullptr)
+	TArray<FNetworkGUID> NetGUIDs;
+	if (!EntityNetGUIDs.RemoveAndCopyValue(EntityId, NetGUIDs))
 	{
-		UE_LOG(LogSpatialPackageMap, Warning, TEXT("Trying to clean up Actor for EntityId %lld but Actor does not exist! Will not cleanup subobjects for this Entity"), EntityId);
+		UE_LOG(LogSpatialPackageMap, Warning, TEXT("Trying to clean up NetGUIDs for EntityId %lld but none were registered."), EntityId);
 		return;
 	}
 
-	UClass* Class = Actor->GetClass();
-	FClassInfo* Info = SpatialNetDriver->TypebindingManager->FindClassInfoByClass(Class);
-
-	for (auto& SubobjectInfoPair : Info->SubobjectInfo)
+	// Removes the actor, its subobjects and any stably named objects registered inside it.
+	for (const FNetworkGUID& NetGUID : NetGUIDs)
 	{
-		FUnrealObjectRef SubobjectRef(EntityId, SubobjectInfoPair.Key);
-		if (FNetworkGUID* SubobjectNetGUID = UnrealObjectRefToNetGUID.Find(SubobjectRef))
+		FUnrealObjectRef ObjectRef;
+		if (NetGUIDToUnrealObjectRef.RemoveAndCopyValue(NetGUID, ObjectRef))
 		{
-			NetGUIDToUnrealObjectRef.Remove(*SubobjectNetGUID);
-			UnrealObjectRefToNetGUID.Remove(SubobjectRef);
+			UnrealObjectRefToNetGUID.Remove(ObjectRef);
 		}
+		ReleaseNetGUID(NetGUID);
 	}
 
-	// Remove actor.
-	FNetworkGUID EntityNetGUID = GetNetGUIDFromEntityId(EntityId);
-	FUnrealObjectRef* ActorRef = NetGUIDToUnrealObjectRef.Find(EntityNetGUID);
-	NetGUIDToUnrealObjectRef.Remove(EntityNetGUID);
-	UnrealObjectRefToNetGUID.Remove(*ActorRef);
+	Stats.NumEntitiesRemoved++;
+}
+
+void FSpatialNetGUIDCache::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("NetGUID cache: %d objects, %d object to NetGUID entries, %d object refs, %d received path refs cached"),
+		ObjectLookup.Num(), NetGUIDLookup.Num(), NetGUIDToUnrealObjectRef.Num(), ReceivedPathRefToNetGUID.Num());
+	Ar.Logf(TEXT("    Entities: %d registered, %llu removed"), EntityNetGUIDs.Num(), Stats.NumEntitiesRemoved);
+	Ar.Logf(TEXT("    Recycling: %llu NetGUIDs released, %llu recycled, %llu still in use and %llu still referenced after quarantine, %d quarantined, %d free"),
+		Stats.NumNetGUIDsReleased, Stats.NumNetGUIDsRecycled, Stats.NumNetGUIDsStillInUse, Stats.NumNetGUIDsStillReferenced, NumQuarantinedNetGUIDs, FreeNetGUIDs.Num());
+}
+
+void FSpatialNetGUIDCache::ResetStats()
+{
+	Stats = FSpatialNetGUIDCacheStats();
 }
 
 FNetworkGUID FSpatialNetGUIDCache::GetNetGUIDFromUnrealObjectRef(const FUnrealObjectRef& ObjectRef)
 {
+	// Refs without a path need no remapping, and are registered as they are received.
+	if (!ObjectRef.Path.IsSet())
+	{
+		return GetNetGUIDFromUnrealObjectRefInternal(ObjectRef);
+	}
+
+	// Refs with paths are cached by their received form, so placeholder substitution and path remapping
+	// only happen the first time a ref is seen.
+	if (const FNetworkGUID* CachedGUID = ReceivedPathRefToNetGUID.Find(ObjectRef))
+	{
+		return *CachedGUID;
+	}
+
 	FUnrealObjectRef NetRemappedObjectRef = ObjectRef;
+
+	// Interned paths arrive as placeholders. Until their IDs are in the dictionary, the ref is treated as unresolved.
+	UObjectRefPathDictionary* PathDictionary = Cast<USpatialNetDriver>(Driver)->ObjectRefPathDictionary;
+	if (PathDictionary != nullptr && !PathDictionary->ResolvePlaceholderPaths(ObjectRef, NetRemappedObjectRef))
+	{
+		return FNetworkGUID();
+	}
+
+	const bool bHadPlaceholderPaths = NetRemappedObjectRef != ObjectRef;
+
 	NetworkRemapObjectRefPaths(NetRemappedObjectRef);
-	return GetNetGUIDFromUnrealObjectRefInternal(NetRemappedObjectRef);
+
+	FNetworkGUID NetGUID = GetNetGUIDFromUnrealObjectRefInternal(NetRemappedObjectRef);
+	if (NetGUID.IsValid() && !bHadPlaceholderPaths && GetRootEntityId(ObjectRef) == 0)
+	{
+		// A path that hasn't loaded yet may still be registered under a different NetGUID once it does.
+		const FNetGuidCacheObject* CacheObject = ObjectLookup.Find(NetGUID);
+		if (CacheObject != nullptr && CacheObject->Object.IsValid())
+		{
+			ReceivedPathRefToNetGUID.Add(ObjectRef, NetGUID);
+		}
+	}
+	return NetGUID;
+}
+
+void FSpatialNetGUIDCache::ClearReceivedPathRefs()
+{
+	ReceivedPathRefToNetGUID.Empty();
 }
 
 FNetworkGUID FSpatialNetGUIDCache::GetNetGUIDFromUnrealObjectRefInternal(const FUnrealObjectRef& ObjectRef)
@@ -255,7 +395,8 @@ FNetworkGUID FSpatialNetGUIDCache::GetNetGUIDFromUnrealObjectRefInternal(const F
 		FNetworkGUID OuterGUID;
 		if (ObjectRef.Outer.IsSet())
 		{
-			OuterGUID = GetNetGUIDFromUnrealObjectRef(ObjectRef.Outer.GetValue());
+			// The whole outer chain has already been remapped.
+			OuterGUID = GetNetGUIDFromUnrealObjectRefInternal(ObjectRef.Outer.GetValue());
 		}
 		NetGUID = RegisterNetGUIDFromPath(ObjectRef.Path.GetValue(), OuterGUID);
 		RegisterObjectRef(NetGUID, ObjectRef);
@@ -276,9 +417,7 @@ void FSpatialNetGUIDCache::NetworkRemapObjectRefPaths(FUnrealObjectRef& ObjectRe
 	{
 		if (Iterator->Path.IsSet())
 		{
-			FString TempPath(*Iterator->Path);
-			GEngine->NetworkRemapPath(Driver, TempPath, true);
-			Iterator->Path = TempPath;
+			GEngine->NetworkRemapPath(Driver, Iterator->Path.GetValue(), true);
 		}
 		if (!Iterator->Outer.IsSet())
 		{
@@ -334,12 +473,7 @@ FNetworkGUID FSpatialNetGUIDCache::GetOrAssignNetGUID_SpatialGDK(UObject* Object
 	if (Object != nullptr && NetGUID == FNetworkGUID::GetDefault() && !IsNetGUIDAuthority())
 	{
 		NetGUID = GenerateNewNetGUID(IsDynamicObject(Object) ? 0 : 1);
-
-		FNetGuidCacheObject CacheObject;
-		CacheObject.Object = MakeWeakObjectPtr(const_cast<UObject*>(Object));
-		CacheObject.PathName = Object->GetFName();
-		CacheObject.OuterGUID = GetOrAssignNetGUID_SpatialGDK(Object->GetOuter());
-		RegisterNetGUID_Internal(NetGUID, CacheObject);
+		RegisterLocalNetGUID(NetGUID, Object);
 
 		UE_LOG(LogSpatialPackageMap, Log, TEXT("%s: NetGUID for object %s was not found in the cache. Generated new NetGUID %s."),
 			*Cast<USpatialNetDriver>(Driver)->Connection->GetWorkerId(),
@@ -351,10 +485,121 @@ FNetworkGUID FSpatialNetGUIDCache::GetOrAssignNetGUID_SpatialGDK(UObject* Object
 	return NetGUID;
 }
 
+void FSpatialNetGUIDCache::RegisterLocalNetGUID(const FNetworkGUID& NetGUID, UObject* Object)
+{
+	FNetGuidCacheObject CacheObject;
+	CacheObject.Object = MakeWeakObjectPtr(Object);
+	CacheObject.PathName = Object->GetFName();
+	CacheObject.OuterGUID = GetOrAssignNetGUID_SpatialGDK(Object->GetOuter());
+	RegisterNetGUID_Internal(NetGUID, CacheObject);
+}
+
+FNetworkGUID FSpatialNetGUIDCache::GetOrAssignEntityObjectNetGUID(UObject* Object)
+{
+	// Only dynamic NetGUIDs are recycled, stably named objects keep theirs for the lifetime of the level.
+	FNetworkGUID NetGUID;
+	if (GetDefault<USpatialGDKSettings>()->bRecycleEntityNetGUIDs && IsDynamicObject(Object) && !NetGUIDLookup.Contains(Object) && PopRecycledNetGUID(NetGUID))
+	{
+		if (IsNetGUIDAuthority())
+		{
+			RegisterNetGUID_Server(NetGUID, Object);
+		}
+		else
+		{
+			RegisterLocalNetGUID(NetGUID, Object);
+		}
+
+		Stats.NumNetGUIDsRecycled++;
+		return NetGUID;
+	}
+
+	return GetOrAssignNetGUID_SpatialGDK(Object);
+}
+
+void FSpatialNetGUIDCache::ReleaseNetGUID(const FNetworkGUID& NetGUID)
+{
+	if (!GetDefault<USpatialGDKSettings>()->bRecycleEntityNetGUIDs || !NetGUID.IsDynamic())
+	{
+		return;
+	}
+
+	QuarantinedNetGUIDs.Enqueue(FQuarantinedNetGUID{ NetGUID, FPlatformTime::Seconds() + GetDefault<USpatialGDKSettings>()->NetGUIDRecycleDelay });
+	NumQuarantinedNetGUIDs++;
+	Stats.NumNetGUIDsReleased++;
+}
+
+bool FSpatialNetGUIDCache::PopRecycledNetGUID(FNetworkGUID& OutNetGUID)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// The engine's lookups keep the removed objects until their NetGUIDs come out of quarantine, for anything still
+	// referring to them by NetGUID in the meantime.
+	//
+	// Nothing in the GDK keeps an unresolved reference by NetGUID: the receiver's pending updates and RPCs, the sender's
+	// pending outgoing refs and the path dictionary's pending refs are keyed by FUnrealObjectRef or object pointer,
+	// and entity IDs aren't reused, so those can't resolve to a recycled NetGUID's new object. The only references by
+	// NetGUID that can outlive the quarantine are replicators the engine tracks in GuidToReplicatorMap, which would map
+	// the NetGUID to whatever object is registered with it next. A NetGUID still in there is never recycled.
+	while (const FQuarantinedNetGUID* Quarantined = QuarantinedNetGUIDs.Peek())
+	{
+		if (Quarantined->ReleaseTime > Now)
+		{
+			break;
+		}
+
+		const FNetworkGUID NetGUID = Quarantined->NetGUID;
+		QuarantinedNetGUIDs.Pop();
+		NumQuarantinedNetGUIDs--;
+
+		if (NetGUIDToUnrealObjectRef.Contains(NetGUID))
+		{
+			continue;
+		}
+
+		if (Driver != nullptr && Driver->GuidToReplicatorMap.Contains(NetGUID))
+		{
+			Stats.NumNetGUIDsStillReferenced++;
+			continue;
+		}
+
+		if (FNetGuidCacheObject* CacheObject = ObjectLookup.Find(NetGUID))
+		{
+			UObject* Object = CacheObject->Object.Get();
+			if (Object != nullptr && !Object->IsPendingKill())
+			{
+				Stats.NumNetGUIDsStillInUse++;
+				continue;
+			}
+
+			if (NetGUIDLookup.FindRef(CacheObject->Object) == NetGUID)
+			{
+				NetGUIDLookup.Remove(CacheObject->Object);
+			}
+			ObjectLookup.Remove(NetGUID);
+		}
+
+		FreeNetGUIDs.Add(NetGUID);
+	}
+
+	if (FreeNetGUIDs.Num() == 0)
+	{
+		return false;
+	}
+
+	OutNetGUID = FreeNetGUIDs.Pop(false);
+	return true;
+}
+
 void FSpatialNetGUIDCache::RegisterObjectRef(FNetworkGUID NetGUID, const FUnrealObjectRef& ObjectRef)
 {
 	checkSlow(!NetGUIDToUnrealObjectRef.Contains(NetGUID) || (NetGUIDToUnrealObjectRef.Contains(NetGUID) && NetGUIDToUnrealObjectRef.FindChecked(NetGUID) == ObjectRef));
 	checkSlow(!UnrealObjectRefToNetGUID.Contains(ObjectRef) || (UnrealObjectRefToNetGUID.Contains(ObjectRef) && UnrealObjectRefToNetGUID.FindChecked(ObjectRef) == NetGUID));
 	NetGUIDToUnrealObjectRef.Emplace(NetGUID, ObjectRef);
 	UnrealObjectRefToNetGUID.Emplace(ObjectRef, NetGUID);
+
+	const Worker_EntityId EntityId = GetRootEntityId(ObjectRef);
+	if (EntityId != 0)
+	{
+		EntityNetGUIDs.FindOrAdd(EntityId).AddUnique(NetGUID);
+	}
 }
@@ -0,0 +1,367 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/ObjectRefPathDictionary.h"
+
+#include "Misc/ScopeLock.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "EngineClasses/SpatialPackageMapClient.h"
+#include "Interop/Connection/SpatialWorkerConnection.h"
+#include "Interop/SpatialReceiver.h"
+#include "Interop/SpatialStaticComponentView.h"
+#include "SpatialConstants.h"
+#include "SpatialGDKSettings.h"
+#include "Utils/SchemaUtils.h"
+
+DEFINE_LOG_CATEGORY(LogObjectRefPathDictionary);
+
+using namespace improbable;
+
+namespace
+{
+
+// ':' can't be part of an object name, so no real path segment starts with this.
+const TCHAR* PlaceholderPathPrefix = TEXT("SpatialPathId:");
+const int32 PlaceholderPathPrefixLength = FCString::Strlen(PlaceholderPathPrefix);
+
+uint32 GetVarintSize(uint32 Value)
+{
+	uint32 Size = 1;
+	while (Value >= 0x80)
+	{
+		Value >>= 7;
+		Size++;
+	}
+	return Size;
+}
+
+TArray<FString> GetPathsFromSchema(const Schema_Object* Object)
+{
+	const uint32 PathCount = Schema_GetBytesCount(Object, SpatialConstants::OBJECT_REF_PATH_DICTIONARY_PATHS_ID);
+
+	TArray<FString> Paths;
+	Paths.Reserve(PathCount);
+	for (uint32 i = 0; i < PathCount; i++)
+	{
+		Paths.Add(IndexStringFromSchema(Object, SpatialConstants::OBJECT_REF_PATH_DICTIONARY_PATHS_ID, i));
+	}
+	return Paths;
+}
+
+}
+
+void UObjectRefPathDictionary::Init(USpatialNetDriver* InNetDriver)
+{
+	NetDriver = InNetDriver;
+}
+
+bool UObjectRefPathDictionary::IsAvailable() const
+{
+	return bHasData && GetDefault<USpatialGDKSettings>()->bEnableObjectRefPathInterning;
+}
+
+bool UObjectRefPathDictionary::HasAuthority() const
+{
+	return bHasData && NetDriver->StaticComponentView->HasAuthority(DictionaryEntityId, SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID);
+}
+
+bool UObjectRefPathDictionary::FindOrRequestPathId(const FString& Path, uint32& OutPathId)
+{
+	if (!IsAvailable())
+	{
+		return false;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+
+	if (const uint32* PathId = PathToId.Find(Path))
+	{
+		OutPathId = *PathId;
+
+		Stats.NumPathsInterned++;
+		Stats.PathBytesReplaced += FTCHARToUTF8(*Path).Length();
+		Stats.PathIdBytesWritten += GetVarintSize(*PathId);
+		return true;
+	}
+
+	Stats.NumPathsWrittenInFull++;
+
+	if (!RequestedPaths.Contains(Path) && (uint32)(Paths.Num() + RequestedPaths.Num()) < GetDefault<USpatialGDKSettings>()->MaxInternedObjectRefPaths)
+	{
+		RequestedPaths.Add(Path);
+		PathsToRequest.Add(Path);
+		Stats.NumPathsRequested++;
+	}
+
+	return false;
+}
+
+FString UObjectRefPathDictionary::MakePlaceholderPath(uint32 PathId)
+{
+	return FString::Printf(TEXT("%s%u"), PlaceholderPathPrefix, PathId);
+}
+
+bool UObjectRefPathDictionary::ParsePlaceholderPath(const FString& Path, uint32& OutPathId)
+{
+	if (!Path.StartsWith(PlaceholderPathPrefix, ESearchCase::CaseSensitive))
+	{
+		return false;
+	}
+
+	OutPathId = (uint32)FCString::Strtoui64(*Path + PlaceholderPathPrefixLength, nullptr, 10);
+	return true;
+}
+
+bool UObjectRefPathDictionary::ResolvePlaceholderPaths(const FUnrealObjectRef& ObjectRef, FUnrealObjectRef& OutObjectRef)
+{
+	OutObjectRef = ObjectRef;
+
+	bool bResolvedAll = true;
+	for (FUnrealObjectRef* Iterator = &OutObjectRef; Iterator != nullptr; Iterator = Iterator->Outer.IsSet() ? &Iterator->Outer.GetValue() : nullptr)
+	{
+		uint32 PathId;
+		if (Iterator->Path.IsSet() && ParsePlaceholderPath(*Iterator->Path, PathId))
+		{
+			if (Paths.IsValidIndex(PathId))
+			{
+				Iterator->Path = Paths[PathId];
+			}
+			else
+			{
+				bResolvedAll = false;
+			}
+		}
+	}
+
+	if (!bResolvedAll)
+	{
+		bool bAlreadyPending = false;
+		PendingRefs.Add(ObjectRef, &bAlreadyPending);
+		if (!bAlreadyPending)
+		{
+			Stats.NumUnknownPathIdsReceived++;
+		}
+	}
+
+	return bResolvedAll;
+}
+
+void UObjectRefPathDictionary::ApplyData(Worker_EntityId EntityId, const Worker_ComponentData& Data)
+{
+	DictionaryEntityId = EntityId;
+	bHasData = true;
+
+	SetPaths(GetPathsFromSchema(Schema_GetComponentDataFields(Data.schema_type)));
+
+	UE_LOG(LogObjectRefPathDictionary, Log, TEXT("Received the object ref path dictionary with %d paths."), Paths.Num());
+}
+
+void UObjectRefPathDictionary::ApplyUpdate(const Worker_ComponentUpdate& Update)
+{
+	Schema_Object* ComponentObject = Schema_GetComponentUpdateFields(Update.schema_type);
+
+	if (Schema_GetBytesCount(ComponentObject, SpatialConstants::OBJECT_REF_PATH_DICTIONARY_PATHS_ID) > 0)
+	{
+		SetPaths(GetPathsFromSchema(ComponentObject));
+	}
+}
+
+void UObjectRefPathDictionary::SetPaths(TArray<FString>&& NewPaths)
+{
+	// Paths are only appended, so only new entries need to be indexed. A shorter list means the GSM was recreated.
+	if (NewPaths.Num() < Paths.Num())
+	{
+		UE_LOG(LogObjectRefPathDictionary, Warning, TEXT("The object ref path dictionary shrank from %d to %d paths. Rebuilding it."), Paths.Num(), NewPaths.Num());
+		Paths.Reset();
+		PathToId.Reset();
+
+		static_cast<FSpatialNetGUIDCache*>(NetDriver->GuidCache.Get())->ClearReceivedPathRefs();
+	}
+
+	const int32 FirstNewPath = Paths.Num();
+	Paths = MoveTemp(NewPaths);
+
+	for (int32 PathId = FirstNewPath; PathId < Paths.Num(); PathId++)
+	{
+		PathToId.Add(Paths[PathId], PathId);
+		RequestedPaths.Remove(Paths[PathId]);
+	}
+
+	if (Paths.Num() > FirstNewPath)
+	{
+		ResolvePendingRefs();
+	}
+}
+
+bool UObjectRefPathDictionary::AddPaths(const TArray<FString>& NewPaths)
+{
+	const uint32 MaxPaths = GetDefault<USpatialGDKSettings>()->MaxInternedObjectRefPaths;
+
+	bool bAddedPaths = false;
+	for (const FString& Path : NewPaths)
+	{
+		if ((uint32)Paths.Num() >= MaxPaths)
+		{
+			UE_LOG(LogObjectRefPathDictionary, Warning, TEXT("The object ref path dictionary is full (%u paths). New paths will be written in full."), MaxPaths);
+			break;
+		}
+
+		if (PathToId.Contains(Path))
+		{
+			continue;
+		}
+
+		PathToId.Add(Path, Paths.Add(Path));
+		RequestedPaths.Remove(Path);
+		Stats.NumPathsAdded++;
+		bAddedPaths = true;
+	}
+
+	return bAddedPaths;
+}
+
+void UObjectRefPathDictionary::SendPathsUpdate()
+{
+	// A list field can only be updated as a whole, so every update carries the full list.
+	Worker_ComponentUpdate Update = {};
+	Update.component_id = SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID;
+	Update.schema_type = Schema_CreateComponentUpdate(SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID);
+	Schema_Object* UpdateObject = Schema_GetComponentUpdateFields(Update.schema_type);
+
+	for (const FString& Path : Paths)
+	{
+		AddStringToSchema(UpdateObject, SpatialConstants::OBJECT_REF_PATH_DICTIONARY_PATHS_ID, Path);
+	}
+
+	NetDriver->Connection->SendComponentUpdate(DictionaryEntityId, &Update);
+}
+
+void UObjectRefPathDictionary::ReceiveAddPathsRequest(const Worker_CommandRequestOp& Op)
+{
+	Schema_Object* RequestObject = Schema_GetCommandRequestObject(Op.request.schema_type);
+
+	// The paths are added on the next flush, along with the ones requested by this worker.
+	for (FString& Path : GetPathsFromSchema(RequestObject))
+	{
+		if (!PathToId.Contains(Path) && !RequestedPaths.Contains(Path))
+		{
+			RequestedPaths.Add(Path);
+			PathsToRequest.Add(MoveTemp(Path));
+		}
+	}
+
+	Worker_CommandResponse Response = {};
+	Response.component_id = SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID;
+	Response.schema_type = Schema_CreateCommandResponse(SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID, SpatialConstants::OBJECT_REF_PATH_DICTIONARY_ADD_PATHS_COMMAND_ID);
+
+	NetDriver->Connection->SendCommandResponse(Op.request_id, &Response);
+}
+
+void UObjectRefPathDictionary::ReceiveAddPathsResponse(const Worker_CommandResponseOp& Op)
+{
+	TArray<FString> RequestPaths;
+	if (!InFlightRequests.RemoveAndCopyValue(Op.request_id, RequestPaths))
+	{
+		return;
+	}
+
+	if (Op.status_code != WORKER_STATUS_CODE_SUCCESS)
+	{
+		// Forget the paths, so they're requested again the next time they're written.
+		UE_LOG(LogObjectRefPathDictionary, Warning, TEXT("Request to add %d paths to the object ref path dictionary failed: %s"), RequestPaths.Num(), UTF8_TO_TCHAR(Op.message));
+		for (const FString& Path : RequestPaths)
+		{
+			RequestedPaths.Remove(Path);
+		}
+	}
+}
+
+void UObjectRefPathDictionary::Flush()
+{
+	if (PathsToRequest.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FString> NewPaths = MoveTemp(PathsToRequest);
+	PathsToRequest.Reset();
+
+	if (HasAuthority())
+	{
+		if (AddPaths(NewPaths))
+		{
+			SendPathsUpdate();
+
+			// Updates to components this worker is authoritative over aren't received back.
+			ResolvePendingRefs();
+		}
+		return;
+	}
+
+	Worker_CommandRequest Request = {};
+	Request.component_id = SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID;
+	Request.schema_type = Schema_CreateCommandRequest(SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID, SpatialConstants::OBJECT_REF_PATH_DICTIONARY_ADD_PATHS_COMMAND_ID);
+	Schema_Object* RequestObject = Schema_GetCommandRequestObject(Request.schema_type);
+
+	for (const FString& Path : NewPaths)
+	{
+		AddStringToSchema(RequestObject, SpatialConstants::OBJECT_REF_PATH_DICTIONARY_PATHS_ID, Path);
+	}
+
+	Worker_RequestId RequestId = NetDriver->Connection->SendCommandRequest(DictionaryEntityId, &Request, SpatialConstants::OBJECT_REF_PATH_DICTIONARY_ADD_PATHS_COMMAND_ID);
+	InFlightRequests.Add(RequestId, MoveTemp(NewPaths));
+}
+
+void UObjectRefPathDictionary::ResolvePendingRefs()
+{
+	TArray<FUnrealObjectRef> ResolvableRefs;
+	for (auto It = PendingRefs.CreateIterator(); It; ++It)
+	{
+		bool bAllPathsKnown = true;
+		for (const FUnrealObjectRef* Iterator = &*It; Iterator != nullptr; Iterator = Iterator->Outer.IsSet() ? &Iterator->Outer.GetValue() : nullptr)
+		{
+			uint32 PathId;
+			if (Iterator->Path.IsSet() && ParsePlaceholderPath(*Iterator->Path, PathId) && !Paths.IsValidIndex(PathId))
+			{
+				bAllPathsKnown = false;
+				break;
+			}
+		}
+
+		if (bAllPathsKnown)
+		{
+			ResolvableRefs.Add(*It);
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const FUnrealObjectRef& ObjectRef : ResolvableRefs)
+	{
+		UObject* Object = NetDriver->PackageMap->GetObjectFromUnrealObjectRef(ObjectRef);
+		if (Object == nullptr)
+		{
+			UE_LOG(LogObjectRefPathDictionary, Warning, TEXT("Interned object ref %s did not map to a valid object once its paths arrived."), *ObjectRef.ToString());
+			continue;
+		}
+
+		Stats.NumPendingRefsResolved++;
+		NetDriver->Receiver->ResolvePendingOperations(Object, ObjectRef);
+	}
+}
+
+void UObjectRefPathDictionary::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Object ref path dictionary: %s, %d paths, %s on this worker"), IsAvailable() ? TEXT("available") : TEXT("unavailable"), Paths.Num(),
+		HasAuthority() ? TEXT("authoritative") : TEXT("not authoritative"));
+	Ar.Logf(TEXT("    Written: %llu paths interned, %llu written in full"), Stats.NumPathsInterned, Stats.NumPathsWrittenInFull);
+	Ar.Logf(TEXT("    Estimated savings: %llu path bytes replaced by %llu ID bytes (%lld bytes saved)"), Stats.PathBytesReplaced, Stats.PathIdBytesWritten,
+		(int64)Stats.PathBytesReplaced - (int64)Stats.PathIdBytesWritten);
+	Ar.Logf(TEXT("    Received: %llu refs with unknown path IDs, %llu resolved once their paths arrived, %d still pending"),
+		Stats.NumUnknownPathIdsReceived, Stats.NumPendingRefsResolved, PendingRefs.Num());
+	Ar.Logf(TEXT("    Additions: %llu paths requested, %llu added by this worker, %d requests in flight"), Stats.NumPathsRequested, Stats.NumPathsAdded, InFlightRequests.Num());
+}
+
+void UObjectRefPathDictionary::ResetStats()
+{
+	Stats = FObjectRefPathDictionaryStats();
+}
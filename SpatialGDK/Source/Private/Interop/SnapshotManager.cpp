@@ -164,6 +164,12 @@ void USnapshotManager::LoadSnapshot(const FString& SnapshotName)
 	ReserveEntityIDsDelegate SpawnEntitiesDelegate;
 	SpawnEntitiesDelegate.BindLambda([EntitiesToSpawn, this](Worker_ReserveEntityIdsResponseOp& Op)
 	{
+		if (Op.status_code != WORKER_STATUS_CODE_SUCCESS)
+		{
+			UE_LOG(LogSnapshotManager, Error, TEXT("Failed to reserve entity IDs for snapshot entities. Aborting load snapshot: %s"), UTF8_TO_TCHAR(Op.message));
+			return;
+		}
+
 		UE_LOG(LogSnapshotManager, Log, TEXT("Creating entities in snapshot, number of entities to spawn: %i"), Op.number_of_entity_ids);
 
 		// Ensure we have the same number of reserved IDs as we have entities to spawn
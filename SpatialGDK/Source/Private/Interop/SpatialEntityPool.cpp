@@ -0,0 +1,165 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/SpatialEntityPool.h"
+
+#include "TimerManager.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "Interop/Connection/SpatialWorkerConnection.h"
+#include "Interop/SpatialReceiver.h"
+#include "SpatialConstants.h"
+#include "SpatialGDKSettings.h"
+
+DEFINE_LOG_CATEGORY(LogSpatialEntityPool);
+
+void USpatialEntityPool::Init(USpatialNetDriver* InNetDriver, FTimerManager* InTimerManager)
+{
+	NetDriver = InNetDriver;
+	Receiver = InNetDriver->Receiver;
+	TimerManager = InTimerManager;
+
+	NumAvailableEntityIds = 0;
+	bIsReady = false;
+	bIsAwaitingResponse = false;
+	NumFailedAttempts = 0;
+
+	const USpatialGDKSettings* Settings = GetDefault<USpatialGDKSettings>();
+	const uint32 InitialReservationCount = FMath::Max(Settings->EntityPoolInitialReservationCount, 1u);
+	LowWatermark = FMath::Min(Settings->EntityPoolLowWatermark, InitialReservationCount - 1);
+	HighWatermark = FMath::Max(Settings->EntityPoolHighWatermark, LowWatermark + 1);
+
+	if (LowWatermark != Settings->EntityPoolLowWatermark || HighWatermark != Settings->EntityPoolHighWatermark)
+	{
+		UE_LOG(LogSpatialEntityPool, Warning, TEXT("Entity pool watermarks %u - %u don't fit the initial reservation count of %u. Using %u - %u."),
+			Settings->EntityPoolLowWatermark, Settings->EntityPoolHighWatermark, InitialReservationCount, LowWatermark, HighWatermark);
+	}
+
+	ReserveEntityIds(InitialReservationCount);
+}
+
+void USpatialEntityPool::ReserveEntityIds(uint32 NumEntityIds)
+{
+	if (NumEntityIds == 0)
+	{
+		return;
+	}
+
+	const double RequestTime = FPlatformTime::Seconds();
+
+	ReserveEntityIDsDelegate CacheEntityIdsDelegate;
+	CacheEntityIdsDelegate.BindLambda([this, NumEntityIds, RequestTime](Worker_ReserveEntityIdsResponseOp& Op)
+	{
+		OnEntityIdsReserved(Op, NumEntityIds, RequestTime);
+	});
+
+	UE_LOG(LogSpatialEntityPool, Verbose, TEXT("Sending bulk entity ID reservation request for %u entity IDs"), NumEntityIds);
+
+	Worker_RequestId RequestId = NetDriver->Connection->SendReserveEntityIdsRequest(NumEntityIds);
+	Receiver->AddReserveEntityIdsDelegate(RequestId, CacheEntityIdsDelegate);
+
+	bIsAwaitingResponse = true;
+	Stats.RefillRequestsSent++;
+}
+
+void USpatialEntityPool::OnEntityIdsReserved(const Worker_ReserveEntityIdsResponseOp& Op, uint32 NumRequested, double RequestTime)
+{
+	bIsAwaitingResponse = false;
+
+	if (Op.status_code != WORKER_STATUS_CODE_SUCCESS)
+	{
+		Stats.RefillRequestsFailed++;
+		NumFailedAttempts++;
+
+		const float RetryDelay = SpatialConstants::GetCommandRetryWaitTimeSeconds(FMath::Min(NumFailedAttempts, SpatialConstants::MAX_NUMBER_COMMAND_ATTEMPTS));
+		UE_LOG(LogSpatialEntityPool, Warning, TEXT("Failed to reserve %u entity IDs: %s. Retrying in %f seconds."), NumRequested, UTF8_TO_TCHAR(Op.message), RetryDelay);
+
+		// Mark the request as in flight while waiting to retry, so the pool does not issue duplicate refills.
+		bIsAwaitingResponse = true;
+
+		FTimerHandle RetryTimer;
+		TimerManager->SetTimer(RetryTimer, [this, NumRequested]()
+		{
+			bIsAwaitingResponse = false;
+			ReserveEntityIds(NumRequested);
+		}, RetryDelay, false);
+
+		return;
+	}
+
+	NumFailedAttempts = 0;
+
+	const double Latency = FPlatformTime::Seconds() - RequestTime;
+	Stats.LastRefillLatencySeconds = Latency;
+	Stats.MaxRefillLatencySeconds = FMath::Max(Stats.MaxRefillLatencySeconds, Latency);
+	Stats.EntityIdsReserved += Op.number_of_entity_ids;
+
+	FEntityRange NewEntityRange;
+	NewEntityRange.CurrentEntityId = Op.first_entity_id;
+	NewEntityRange.LastEntityId = Op.first_entity_id + Op.number_of_entity_ids - 1;
+	ReservedRanges.Add(NewEntityRange);
+
+	NumAvailableEntityIds += Op.number_of_entity_ids;
+
+	UE_LOG(LogSpatialEntityPool, Log, TEXT("Reserved %u entity IDs (%lld - %lld) in %.1f ms. %lld entity IDs available."),
+		Op.number_of_entity_ids, NewEntityRange.CurrentEntityId, NewEntityRange.LastEntityId, Latency * 1000.0, NumAvailableEntityIds);
+
+	bIsReady = true;
+
+	// Entity IDs may have been handed out faster than they were reserved.
+	RefillIfBelowLowWatermark();
+}
+
+Worker_EntityId USpatialEntityPool::GetNextEntityId()
+{
+	if (ReservedRanges.Num() == 0)
+	{
+		Stats.StarvationCount++;
+		UE_LOG(LogSpatialEntityPool, Warning, TEXT("Entity pool is empty (starved %u times). Falling back to a single entity ID reservation."), Stats.StarvationCount);
+
+		RefillIfBelowLowWatermark();
+		return SpatialConstants::INVALID_ENTITY_ID;
+	}
+
+	FEntityRange& CurrentRange = ReservedRanges[0];
+	Worker_EntityId NextEntityId = CurrentRange.CurrentEntityId++;
+
+	if (CurrentRange.CurrentEntityId > CurrentRange.LastEntityId)
+	{
+		ReservedRanges.RemoveAt(0);
+	}
+
+	NumAvailableEntityIds--;
+	Stats.EntityIdsHandedOut++;
+
+	RefillIfBelowLowWatermark();
+
+	return NextEntityId;
+}
+
+void USpatialEntityPool::RefillIfBelowLowWatermark()
+{
+	if (bIsAwaitingResponse)
+	{
+		return;
+	}
+
+	if (NumAvailableEntityIds >= LowWatermark)
+	{
+		return;
+	}
+
+	const int64 NumToReserve = FMath::Max<int64>((int64)HighWatermark - NumAvailableEntityIds, 1);
+	UE_LOG(LogSpatialEntityPool, Log, TEXT("Entity pool below low watermark (%lld available). Reserving %lld more entity IDs."), NumAvailableEntityIds, NumToReserve);
+
+	ReserveEntityIds((uint32)NumToReserve);
+}
+
+void USpatialEntityPool::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Entity pool: %s, %lld entity IDs available in %d ranges, refill %s"),
+		bIsReady ? TEXT("ready") : TEXT("not ready"), NumAvailableEntityIds, ReservedRanges.Num(), bIsAwaitingResponse ? TEXT("in flight") : TEXT("idle"));
+	Ar.Logf(TEXT("    Refill requests sent: %u, failed: %u"), Stats.RefillRequestsSent, Stats.RefillRequestsFailed);
+	Ar.Logf(TEXT("    Entity IDs reserved: %llu, handed out: %llu"), Stats.EntityIdsReserved, Stats.EntityIdsHandedOut);
+	Ar.Logf(TEXT("    Starvation count: %u"), Stats.StarvationCount);
+	Ar.Logf(TEXT("    Refill latency: last %.1f ms, max %.1f ms"), Stats.LastRefillLatencySeconds * 1000.0, Stats.MaxRefillLatencySeconds * 1000.0);
+}
@@ -11,6 +11,7 @@
 #include "EngineClasses/SpatialPackageMapClient.h"
 #include "Interop/Connection/SpatialWorkerConnection.h"
 #include "Interop/GlobalStateManager.h"
+#include "Interop/ObjectRefPathDictionary.h"
 #include "Interop/SpatialPlayerSpawner.h"
 #include "Interop/SpatialSender.h"
 #include "Schema/DynamicComponent.h"
@@ -142,6 +143,12 @@ void USpatialReceiver::OnAddComponent(Worker_AddComponentOp& Op)
 	case SpatialConstants::GLOBAL_STATE_MANAGER_DEPLOYMENT_COMPONENT_ID:
  		GlobalStateManager->ApplyDeploymentMapURLData(Op.data);
 		return;
+	case SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID:
+		if (NetDriver->ObjectRefPathDictionary != nullptr)
+		{
+			NetDriver->ObjectRefPathDictionary->ApplyData(Op.entity_id, Op.data);
+		}
+		return;
 	default:
 		Data = MakeShared<improbable::DynamicComponent>(Op.data);
 		break;
@@ -206,6 +213,14 @@ void USpatialReceiver::HandleActorAuthority(Worker_AuthorityChangeOp& Op)
 						Actor->RemoteRole = ROLE_SimulatedProxy;
 					}
 
+					// Wake actors that went dormant while this worker last had authority. Their shadow state may predate updates
+					// received from other workers since, so they replicate once to bring the entity in line with this worker.
+					FNetworkObjectInfo* ActorInfo = NetDriver->FindNetworkObjectInfo(Actor);
+					if (ActorInfo != nullptr && ActorInfo->DormantConnections.Num() > 0)
+					{
+						NetDriver->FlushActorDormancy(Actor);
+					}
+
 					Actor->OnAuthorityGained();
 				}
 				else if (Op.authority == WORKER_AUTHORITY_AUTHORITY_LOSS_IMMINENT)
@@ -528,7 +543,7 @@ void USpatialReceiver::ApplyComponentData(Worker_EntityId EntityId, Worker_Compo
 	}
 
 	UClass* Class = TypebindingManager->FindClassByComponentId(Data.component_id);
-	checkf(Class, TEXT("Component %d isn't hand-written and not present in ComponentToClassMap."), Data.component_id);
+	checkf(Class, TEXT("Component %d isn't hand-written and not present in the schema database."), Data.component_id);
 
 	FChannelObjectPair ChannelObjectPair(Channel, TargetObject);
 
@@ -587,6 +602,12 @@ void USpatialReceiver::OnComponentUpdate(Worker_ComponentUpdateOp& Op)
 	case SpatialConstants::GLOBAL_STATE_MANAGER_DEPLOYMENT_COMPONENT_ID:
 		NetDriver->GlobalStateManager->ApplyDeploymentMapUpdate(Op.update);
 		return;
+	case SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID:
+		if (NetDriver->ObjectRefPathDictionary != nullptr)
+		{
+			NetDriver->ObjectRefPathDictionary->ApplyUpdate(Op.update);
+		}
+		return;
 	}
 
 	USpatialActorChannel* Channel = NetDriver->GetActorChannelByEntityId(Op.entity_id);
@@ -674,6 +695,15 @@ void USpatialReceiver::OnCommandRequest(Worker_CommandRequestOp& Op)
 		return;
 	}
 
+	if (Op.request.component_id == SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID && CommandIndex == SpatialConstants::OBJECT_REF_PATH_DICTIONARY_ADD_PATHS_COMMAND_ID)
+	{
+		if (NetDriver->ObjectRefPathDictionary != nullptr)
+		{
+			NetDriver->ObjectRefPathDictionary->ReceiveAddPathsRequest(Op);
+		}
+		return;
+	}
+
 	Worker_CommandResponse Response = {};
 	Response.component_id = Op.request.component_id;
 	Response.schema_type = Schema_CreateCommandResponse(Op.request.component_id, CommandIndex);
@@ -718,6 +748,11 @@ void USpatialReceiver::OnCommandResponse(Worker_CommandResponseOp& Op)
 	{
 		NetDriver->PlayerSpawner->ReceivePlayerSpawnResponse(Op);
 	}
+	else if (Op.response.component_id == SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID && NetDriver->ObjectRefPathDictionary != nullptr)
+	{
+		NetDriver->ObjectRefPathDictionary->ReceiveAddPathsResponse(Op);
+		return;
+	}
 
 	ReceiveCommandResponse(Op);
 }
@@ -836,21 +871,21 @@ void USpatialReceiver::OnReserveEntityIdResponse(Worker_ReserveEntityIdResponseO
 
 void USpatialReceiver::OnReserveEntityIdsResponse(Worker_ReserveEntityIdsResponseOp& Op)
 {
-	if (Op.status_code == WORKER_STATUS_CODE_SUCCESS)
+	if (Op.status_code != WORKER_STATUS_CODE_SUCCESS)
 	{
-		if (ReserveEntityIDsDelegate* RequestDelegate = ReserveEntityIDsDelegates.Find(Op.request_id))
-		{
-			UE_LOG(LogSpatialReceiver, Log, TEXT("Executing ReserveEntityIdsResponse with delegate, request id: %d, first entity id: %lld, message: %s"), Op.request_id, Op.first_entity_id, UTF8_TO_TCHAR(Op.message));
-			RequestDelegate->ExecuteIfBound(Op);
-		}
-		else
-		{
-			UE_LOG(LogSpatialReceiver, Warning, TEXT("Recieved ReserveEntityIdsResponse but with no delegate set, request id: %d, first entity id: %lld, message: %s"), Op.request_id, Op.first_entity_id, UTF8_TO_TCHAR(Op.message));
-		}
+		UE_LOG(LogSpatialReceiver, Error, TEXT("Failed ReserveEntityIds: request id: %d, message: %s"), Op.request_id, UTF8_TO_TCHAR(Op.message));
 	}
-	else
+
+	// Delegates are executed for failed responses as well, so that callers can retry.
+	ReserveEntityIDsDelegate RequestDelegate;
+	if (ReserveEntityIDsDelegates.RemoveAndCopyValue(Op.request_id, RequestDelegate))
 	{
-		UE_LOG(LogSpatialReceiver, Error, TEXT("Failed ReserveEntityIds: request id: %d, message: %s"), Op.request_id, UTF8_TO_TCHAR(Op.message));
+		UE_LOG(LogSpatialReceiver, Log, TEXT("Executing ReserveEntityIdsResponse with delegate, request id: %d, first entity id: %lld, message: %s"), Op.request_id, Op.first_entity_id, UTF8_TO_TCHAR(Op.message));
+		RequestDelegate.ExecuteIfBound(Op);
+	}
+	else if (Op.status_code == WORKER_STATUS_CODE_SUCCESS)
+	{
+		UE_LOG(LogSpatialReceiver, Warning, TEXT("Recieved ReserveEntityIdsResponse but with no delegate set, request id: %d, first entity id: %lld, message: %s"), Op.request_id, Op.first_entity_id, UTF8_TO_TCHAR(Op.message));
 	}
 }
 
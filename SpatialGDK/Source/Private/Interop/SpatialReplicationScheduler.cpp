@@ -0,0 +1,422 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/SpatialReplicationScheduler.h"
+
+#include "Engine/NetworkObjectList.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+#include "EngineClasses/SpatialNetConnection.h"
+#include "EngineClasses/SpatialNetDriver.h"
+#include "SpatialGDKSettings.h"
+
+DEFINE_LOG_CATEGORY(LogSpatialReplicationScheduler);
+
+namespace
+{
+// Queues are compacted once this many consumed entries have built up at the front.
+const int32 MIN_ENTRIES_TO_COMPACT = 1024;
+}
+
+void USpatialReplicationScheduler::Init(USpatialNetDriver* InNetDriver)
+{
+	NetDriver = InNetDriver;
+
+	ResyncCursor = 0;
+	LastGatherTime = 0.0f;
+	NumDormantActors = 0;
+	NumResyncPasses = 0;
+	NumResyncVisits = 0;
+	MaxResyncVisitsPerTick = 0;
+	ResyncCycles = 0;
+	NumThrottledSchedules = 0;
+
+	if (UWorld* World = NetDriver->GetWorld())
+	{
+		OnActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &USpatialReplicationScheduler::OnActorSpawned));
+	}
+}
+
+void USpatialReplicationScheduler::BeginDestroy()
+{
+	if (NetDriver != nullptr && NetDriver->GetWorld() != nullptr)
+	{
+		NetDriver->GetWorld()->RemoveOnActorSpawnedHandler(OnActorSpawnedHandle);
+	}
+
+	Super::BeginDestroy();
+}
+
+void USpatialReplicationScheduler::OnActorSpawned(AActor* Actor)
+{
+	SpawnedActors.Add(Actor);
+}
+
+void USpatialReplicationScheduler::GatherDueActors(float Time, TArray<FNetworkObjectInfo*>& OutDueActors)
+{
+	const USpatialGDKSettings* Settings = GetDefault<USpatialGDKSettings>();
+
+	if (Settings->ReplicationSchedulerRemoteCellFrequencyScale < 1.0f)
+	{
+		UpdateViewerCells();
+	}
+
+	for (const TWeakObjectPtr<AActor>& SpawnedActor : SpawnedActors)
+	{
+		if (SpawnedActor.IsValid() && SpawnedActor->GetIsReplicated() && !ScheduledActors.Contains(SpawnedActor))
+		{
+			ScheduleImmediate(SpawnedActor.Get());
+		}
+	}
+	SpawnedActors.Reset();
+
+	Resync(Time, Time - LastGatherTime);
+	LastGatherTime = Time;
+
+	auto AddDueActor = [this, Time, &OutDueActors](AActor* Actor, FScheduledActor& Entry)
+	{
+		FNetworkObjectInfo* ActorInfo = NetDriver->FindNetworkObjectInfo(Actor);
+		if (ActorInfo == nullptr)
+		{
+			// No longer replicated.
+			RemoveActor(Actor);
+			return;
+		}
+
+		if (IsActorDormant(ActorInfo))
+		{
+			SetBucket(Entry, INDEX_NONE);
+			Entry.bImmediate = false;
+			Entry.bDormant = true;
+			NumDormantActors++;
+			return;
+		}
+
+		Schedule(Actor, Entry, Time);
+
+		// Lets the resync spot ForceNetUpdate, which moves NextUpdateTime forward.
+		ActorInfo->NextUpdateTime = Entry.DueTime;
+		OutDueActors.Add(ActorInfo);
+
+		Buckets[Entry.BucketIndex].Stats.NumActorsGathered++;
+	};
+
+	TArray<TWeakObjectPtr<AActor>> DueImmediately = MoveTemp(ImmediateActors);
+	ImmediateActors.Reset();
+
+	for (const TWeakObjectPtr<AActor>& Actor : DueImmediately)
+	{
+		FScheduledActor* Entry = ScheduledActors.Find(Actor);
+		if (Entry == nullptr || !Entry->bImmediate)
+		{
+			continue;
+		}
+
+		if (Actor.IsValid())
+		{
+			AddDueActor(Actor.Get(), *Entry);
+		}
+		else
+		{
+			RemoveEntry(Actor);
+		}
+	}
+
+	for (int32 BucketIndex = 0; BucketIndex < Buckets.Num(); BucketIndex++)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		// Scheduling can add buckets, and rescheduled actors are appended to their bucket's queue, so index into Buckets every time.
+		while (Buckets[BucketIndex].QueueHead < Buckets[BucketIndex].Queue.Num())
+		{
+			const FQueuedActor QueuedActor = Buckets[BucketIndex].Queue[Buckets[BucketIndex].QueueHead];
+			if (QueuedActor.DueTime > Time)
+			{
+				break;
+			}
+
+			Buckets[BucketIndex].QueueHead++;
+
+			if (FScheduledActor* Entry = ValidateQueuedActor(QueuedActor, BucketIndex))
+			{
+				AddDueActor(QueuedActor.Actor.Get(), *Entry);
+			}
+		}
+
+		FReplicationBucket& Bucket = Buckets[BucketIndex];
+		if (Bucket.QueueHead >= MIN_ENTRIES_TO_COMPACT && Bucket.QueueHead * 2 >= Bucket.Queue.Num())
+		{
+			Bucket.Queue.RemoveAt(0, Bucket.QueueHead, /* bAllowShrinking */ false);
+			Bucket.QueueHead = 0;
+		}
+
+		Bucket.Stats.GatherCycles += FPlatformTime::Cycles64() - StartCycles;
+	}
+}
+
+void USpatialReplicationScheduler::ScheduleImmediate(AActor* Actor)
+{
+	FScheduledActor& Entry = ScheduledActors.FindOrAdd(Actor);
+
+	if (Entry.bDormant)
+	{
+		Entry.bDormant = false;
+		NumDormantActors--;
+	}
+
+	if (!Entry.bImmediate)
+	{
+		SetBucket(Entry, INDEX_NONE);
+		Entry.bImmediate = true;
+		ImmediateActors.Add(Actor);
+	}
+}
+
+void USpatialReplicationScheduler::RemoveActor(AActor* Actor)
+{
+	RemoveEntry(Actor);
+}
+
+void USpatialReplicationScheduler::RemoveEntry(const TWeakObjectPtr<AActor>& Actor)
+{
+	FScheduledActor Entry;
+	if (!ScheduledActors.RemoveAndCopyValue(Actor, Entry))
+	{
+		return;
+	}
+
+	SetBucket(Entry, INDEX_NONE);
+	if (Entry.bDormant)
+	{
+		NumDormantActors--;
+	}
+}
+
+void USpatialReplicationScheduler::RecordReplication(AActor* Actor, uint64 Cycles)
+{
+	const FScheduledActor* Entry = ScheduledActors.Find(Actor);
+	if (Entry != nullptr && Entry->BucketIndex != INDEX_NONE)
+	{
+		FReplicationBucketStats& Stats = Buckets[Entry->BucketIndex].Stats;
+		Stats.NumActorsReplicated++;
+		Stats.ReplicateCycles += Cycles;
+	}
+}
+
+void USpatialReplicationScheduler::Resync(float Time, float DeltaTime)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	// Walk the sparse array behind the set rather than iterating it, so the sweep can resume where the last tick stopped.
+	// Objects added behind the cursor are picked up on the next pass, and spawned actors are scheduled without waiting for it.
+	const TSet<TSharedPtr<FNetworkObjectInfo>>& ActiveObjects = NetDriver->GetNetworkObjectList().GetActiveObjects();
+	const int32 MaxIndex = ActiveObjects.GetMaxIndex();
+
+	const float ResyncInterval = GetDefault<USpatialGDKSettings>()->ReplicationSchedulerResyncInterval;
+	const int32 NumToVisit = DeltaTime < ResyncInterval ? FMath::Min(FMath::CeilToInt(MaxIndex * DeltaTime / ResyncInterval), MaxIndex) : MaxIndex;
+
+	for (int32 i = 0; i < NumToVisit; i++)
+	{
+		if (ResyncCursor >= MaxIndex)
+		{
+			ResyncCursor = 0;
+			NumResyncPasses++;
+		}
+
+		const FSetElementId ElementId = FSetElementId::FromInteger(ResyncCursor++);
+		if (ActiveObjects.IsValidId(ElementId))
+		{
+			ResyncActor(ActiveObjects[ElementId].Get(), Time);
+		}
+	}
+
+	NumResyncVisits += NumToVisit;
+	MaxResyncVisitsPerTick = FMath::Max<uint64>(MaxResyncVisitsPerTick, NumToVisit);
+	ResyncCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+void USpatialReplicationScheduler::ResyncActor(FNetworkObjectInfo* ActorInfo, float Time)
+{
+	AActor* Actor = ActorInfo->Actor;
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	FScheduledActor* Entry = ScheduledActors.Find(Actor);
+	if (Entry == nullptr)
+	{
+		ScheduleImmediate(Actor);
+		return;
+	}
+
+	if (Entry->bImmediate)
+	{
+		return;
+	}
+
+	if (Entry->bDormant)
+	{
+		if (!IsActorDormant(ActorInfo))
+		{
+			ScheduleImmediate(Actor);
+		}
+		return;
+	}
+
+	// ForceNetUpdate moves NextUpdateTime forward, and saturated connections set bPendingNetUpdate.
+	// Actors whose update frequency went up shouldn't wait out their old interval either.
+	if (ActorInfo->bPendingNetUpdate || ActorInfo->NextUpdateTime < Entry->DueTime || Entry->DueTime > Time + GetUpdateInterval(Actor))
+	{
+		ScheduleImmediate(Actor);
+	}
+}
+
+void USpatialReplicationScheduler::UpdateViewerCells()
+{
+	ViewerCells.Reset();
+
+	UWorld* World = NetDriver->GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PlayerController = It->Get();
+		APawn* Pawn = PlayerController != nullptr ? PlayerController->GetPawn() : nullptr;
+		if (Pawn == nullptr)
+		{
+			continue;
+		}
+
+		const FIntPoint Cell = GetCell(Pawn->GetActorLocation());
+		for (int32 X = -1; X <= 1; X++)
+		{
+			for (int32 Y = -1; Y <= 1; Y++)
+			{
+				ViewerCells.Add(Cell + FIntPoint(X, Y));
+			}
+		}
+	}
+}
+
+void USpatialReplicationScheduler::Schedule(AActor* Actor, FScheduledActor& Entry, float Time)
+{
+	const float UpdateInterval = GetUpdateInterval(Actor);
+
+	SetBucket(Entry, FindOrAddBucket(UpdateInterval, Actor));
+	Entry.DueTime = Time + UpdateInterval;
+	Entry.bImmediate = false;
+
+	Buckets[Entry.BucketIndex].Queue.Add(FQueuedActor{ Actor, Entry.DueTime });
+
+	if (UpdateInterval * Actor->NetUpdateFrequency > 1.001f)
+	{
+		NumThrottledSchedules++;
+	}
+}
+
+void USpatialReplicationScheduler::SetBucket(FScheduledActor& Entry, int32 BucketIndex)
+{
+	if (Entry.BucketIndex != INDEX_NONE)
+	{
+		Buckets[Entry.BucketIndex].NumActors--;
+	}
+
+	Entry.BucketIndex = BucketIndex;
+
+	if (Entry.BucketIndex != INDEX_NONE)
+	{
+		Buckets[Entry.BucketIndex].NumActors++;
+	}
+}
+
+int32 USpatialReplicationScheduler::FindOrAddBucket(float UpdateInterval, const AActor* Actor)
+{
+	// Bucket by whole milliseconds, so small floating point differences in update frequency don't create extra buckets.
+	const uint32 IntervalMs = FMath::Max(1, FMath::RoundToInt(UpdateInterval * 1000.0f));
+
+	if (int32* BucketIndex = IntervalToBucketIndex.Find(IntervalMs))
+	{
+		return *BucketIndex;
+	}
+
+	FReplicationBucket NewBucket;
+	NewBucket.UpdateInterval = IntervalMs / 1000.0f;
+	NewBucket.ExampleClassName = Actor->GetClass()->GetName();
+
+	const int32 BucketIndex = Buckets.Add(MoveTemp(NewBucket));
+	IntervalToBucketIndex.Add(IntervalMs, BucketIndex);
+
+	UE_LOG(LogSpatialReplicationScheduler, Verbose, TEXT("Added replication bucket for %.3f second updates (first actor class %s)"), Buckets[BucketIndex].UpdateInterval, *Buckets[BucketIndex].ExampleClassName);
+
+	return BucketIndex;
+}
+
+float USpatialReplicationScheduler::GetUpdateInterval(const AActor* Actor) const
+{
+	float UpdateFrequency = FMath::Max(Actor->NetUpdateFrequency, KINDA_SMALL_NUMBER);
+
+	const float RemoteCellFrequencyScale = GetDefault<USpatialGDKSettings>()->ReplicationSchedulerRemoteCellFrequencyScale;
+	if (RemoteCellFrequencyScale < 1.0f && !ViewerCells.Contains(GetCell(Actor->GetActorLocation())))
+	{
+		UpdateFrequency *= RemoteCellFrequencyScale;
+	}
+
+	return 1.0f / UpdateFrequency;
+}
+
+FIntPoint USpatialReplicationScheduler::GetCell(const FVector& Location) const
+{
+	const float CellSize = FMath::Max(GetDefault<USpatialGDKSettings>()->ReplicationSchedulerCellSize, 1.0f);
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+USpatialReplicationScheduler::FScheduledActor* USpatialReplicationScheduler::ValidateQueuedActor(const FQueuedActor& QueuedActor, int32 BucketIndex)
+{
+	FScheduledActor* Entry = ScheduledActors.Find(QueuedActor.Actor);
+
+	if (!QueuedActor.Actor.IsValid())
+	{
+		if (Entry != nullptr && Entry->BucketIndex == BucketIndex && Entry->DueTime == QueuedActor.DueTime)
+		{
+			RemoveEntry(QueuedActor.Actor);
+		}
+		return nullptr;
+	}
+
+	if (Entry == nullptr || Entry->bDormant || Entry->bImmediate || Entry->BucketIndex != BucketIndex || Entry->DueTime != QueuedActor.DueTime)
+	{
+		return nullptr;
+	}
+
+	return Entry;
+}
+
+bool USpatialReplicationScheduler::IsActorDormant(const FNetworkObjectInfo* ActorInfo) const
+{
+	// Actors only replicate on one connection, so being dormant on any connection means they are dormant.
+	return ActorInfo->DormantConnections.Num() > 0;
+}
+
+void USpatialReplicationScheduler::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Replication scheduler: %d actors, %d dormant, %d due immediately"), ScheduledActors.Num(), NumDormantActors, ImmediateActors.Num());
+	Ar.Logf(TEXT("    Resync: %llu full passes, %llu objects visited (at most %llu in a tick), %.3f ms total, %.3f us per object"),
+		NumResyncPasses, NumResyncVisits, MaxResyncVisitsPerTick, FPlatformTime::ToMilliseconds64(ResyncCycles),
+		NumResyncVisits > 0 ? FPlatformTime::ToMilliseconds64(ResyncCycles) * 1000.0 / NumResyncVisits : 0.0);
+	Ar.Logf(TEXT("    Schedules throttled by cell: %llu"), NumThrottledSchedules);
+
+	for (const FReplicationBucket& Bucket : Buckets)
+	{
+		const FReplicationBucketStats& Stats = Bucket.Stats;
+		Ar.Logf(TEXT("    Bucket %.2f Hz (%s): %d actors, gathered %llu, replicated %llu, gather %.3f ms, replicate %.3f ms (%.3f us per actor)"),
+			1.0f / Bucket.UpdateInterval, *Bucket.ExampleClassName, Bucket.NumActors, Stats.NumActorsGathered, Stats.NumActorsReplicated,
+			FPlatformTime::ToMilliseconds64(Stats.GatherCycles), FPlatformTime::ToMilliseconds64(Stats.ReplicateCycles),
+			Stats.NumActorsReplicated > 0 ? FPlatformTime::ToMilliseconds64(Stats.ReplicateCycles) * 1000.0 / Stats.NumActorsReplicated : 0.0);
+	}
+}
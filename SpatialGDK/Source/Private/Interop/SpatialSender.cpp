@@ -11,6 +11,7 @@
 #include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
 #include "Interop/Connection/SpatialWorkerConnection.h"
+#include "Interop/ObjectRefPathDictionary.h"
 #include "Interop/SpatialReceiver.h"
 #include "Interop/SpatialDispatcher.h"
 #include "Schema/Rotation.h"
@@ -18,9 +19,11 @@
 #include "Schema/StandardLibrary.h"
 #include "Schema/UnrealMetadata.h"
 #include "SpatialConstants.h"
+#include "SpatialGDKSettings.h"
 #include "Utils/ComponentFactory.h"
 #include "Utils/EntityRegistry.h"
 #include "Utils/RepLayoutUtils.h"
+#include "Utils/SchemaUtils.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialSender);
 
@@ -56,6 +59,8 @@ void USpatialSender::Init(USpatialNetDriver* InNetDriver)
 	Receiver = InNetDriver->Receiver;
 	PackageMap = InNetDriver->PackageMap;
 	TypebindingManager = InNetDriver->TypebindingManager;
+	BytesSent = 0;
+	NumCoalescedMulticastUpdatesSent = 0;
 }
 
 Worker_RequestId USpatialSender::CreateEntity(USpatialActorChannel* Channel)
@@ -139,7 +144,7 @@ Worker_RequestId USpatialSender::CreateEntity(USpatialActorChannel* Channel)
 	ComponentDatas.Add(improbable::Metadata(Class->GetName()).CreateMetadataData());
 	ComponentDatas.Add(improbable::EntityAcl(ReadAcl, ComponentWriteAcl).CreateEntityAclData());
 	ComponentDatas.Add(improbable::Persistence().CreatePersistenceData());
-	ComponentDatas.Add(improbable::Rotation(Actor->GetActorRotation()).CreateRotationData());
+	ComponentDatas.Add(improbable::Rotation(Actor->GetActorRotation()).CreateRotationData(GetDefault<USpatialGDKSettings>()->RotationEncoding));
 	ComponentDatas.Add(improbable::UnrealMetadata({}, ClientWorkerAttribute, Class->GetPathName()).CreateUnrealMetadataData());
 
 	if (Class->HasAnySpatialClassFlags(SPATIALCLASS_Singleton))
@@ -154,25 +159,12 @@ Worker_RequestId USpatialSender::CreateEntity(USpatialActorChannel* Channel)
 		}
 	}
 
-	FUnresolvedObjectsMap UnresolvedObjectsMap;
-	FUnresolvedObjectsMap HandoverUnresolvedObjectsMap;
-	ComponentFactory DataFactory(UnresolvedObjectsMap, HandoverUnresolvedObjectsMap, NetDriver);
-
-	FRepChangeState InitialRepChanges = Channel->CreateInitialRepChangeState(Actor);
-	FHandoverChangeState InitialHandoverChanges = Channel->CreateInitialHandoverChangeState(Info);
-
-	TArray<Worker_ComponentData> DynamicComponentDatas = DataFactory.CreateComponentDatas(Actor, Info, InitialRepChanges, InitialHandoverChanges);
-	ComponentDatas.Append(DynamicComponentDatas);
+	const bool bEnableArrayDeltaEncoding = GetDefault<USpatialGDKSettings>()->bEnableArrayDeltaEncoding;
+	const bool bEnableFieldValueHashing = GetDefault<USpatialGDKSettings>()->bEnableFieldValueHashing;
 
-	for (auto& HandleUnresolvedObjectsPair : UnresolvedObjectsMap)
-	{
-		QueueOutgoingUpdate(Channel, Actor, HandleUnresolvedObjectsPair.Key, HandleUnresolvedObjectsPair.Value, /* bIsHandover */ false);
-	}
-
-	for (auto& HandleUnresolvedObjectsPair : HandoverUnresolvedObjectsMap)
-	{
-		QueueOutgoingUpdate(Channel, Actor, HandleUnresolvedObjectsPair.Key, HandleUnresolvedObjectsPair.Value, /* bIsHandover */ true);
-	}
+	TArray<FInitialObjectData> InitialObjects;
+	InitialObjects.Emplace(Actor, Info, Channel->CreateInitialRepChangeState(Actor), Channel->CreateInitialHandoverChangeState(Info),
+		bEnableArrayDeltaEncoding ? &Channel->GetArrayDeltaStates(Actor) : nullptr, bEnableFieldValueHashing ? &Channel->GetFieldValueHashes(Actor) : nullptr);
 
 	for (int32 RPCType = SCHEMA_FirstRPC; RPCType <= SCHEMA_LastRPC; RPCType++)
 	{
@@ -192,35 +184,48 @@ Worker_RequestId USpatialSender::CreateEntity(USpatialActorChannel* Channel)
 			continue;
 		}
 
-		FRepChangeState SubobjectRepChanges = Channel->CreateInitialRepChangeState(Subobject);
-		FHandoverChangeState SubobjectHandoverChanges = Channel->CreateInitialHandoverChangeState(SubobjectInfo);
-
-		// Reset unresolved objects so they can be filled again by DataFactory
-		UnresolvedObjectsMap.Empty();
-		HandoverUnresolvedObjectsMap.Empty();
+		InitialObjects.Emplace(Subobject, SubobjectInfo, Channel->CreateInitialRepChangeState(Subobject), Channel->CreateInitialHandoverChangeState(SubobjectInfo),
+			bEnableArrayDeltaEncoding ? &Channel->GetArrayDeltaStates(Subobject) : nullptr, bEnableFieldValueHashing ? &Channel->GetFieldValueHashes(Subobject) : nullptr);
 
-		TArray<Worker_ComponentData> ActorSubobjectDatas = DataFactory.CreateComponentDatas(Subobject, SubobjectInfo, SubobjectRepChanges, SubobjectHandoverChanges);
-		ComponentDatas.Append(ActorSubobjectDatas);
-
-		for (auto& HandleUnresolvedObjectsPair : UnresolvedObjectsMap)
+		for (int32 RPCType = SCHEMA_ClientRPC; RPCType < SCHEMA_Count; RPCType++)
 		{
-			QueueOutgoingUpdate(Channel, Subobject, HandleUnresolvedObjectsPair.Key, HandleUnresolvedObjectsPair.Value, /* bIsHandover */ false);
+			if (SubobjectInfo->SchemaComponents[RPCType] != SpatialConstants::INVALID_COMPONENT_ID)
+			{
+				ComponentDatas.Add(ComponentFactory::CreateEmptyComponentData(SubobjectInfo->SchemaComponents[RPCType]));
+			}
 		}
+	}
+
+	// The actor and all its subobjects are written at once, so their components can be written in parallel.
+	ComponentFactory::CreateInitialComponentDatas(NetDriver, InitialObjects);
+
+	for (FInitialObjectData& InitialObject : InitialObjects)
+	{
+		ComponentDatas.Append(InitialObject.ComponentDatas);
 
-		for (auto& HandleUnresolvedObjectsPair : HandoverUnresolvedObjectsMap)
+		for (auto& HandleUnresolvedObjectsPair : InitialObject.RepUnresolvedObjects)
 		{
-			QueueOutgoingUpdate(Channel, Subobject, HandleUnresolvedObjectsPair.Key, HandleUnresolvedObjectsPair.Value, /* bIsHandover */ true);
+			QueueOutgoingUpdate(Channel, InitialObject.Object, HandleUnresolvedObjectsPair.Key, HandleUnresolvedObjectsPair.Value, /* bIsHandover */ false);
 		}
 
-		for (int32 RPCType = SCHEMA_ClientRPC; RPCType < SCHEMA_Count; RPCType++)
+		for (auto& HandleUnresolvedObjectsPair : InitialObject.HandoverUnresolvedObjects)
 		{
-			if (SubobjectInfo->SchemaComponents[RPCType] != SpatialConstants::INVALID_COMPONENT_ID)
-			{
-				ComponentDatas.Add(ComponentFactory::CreateEmptyComponentData(SubobjectInfo->SchemaComponents[RPCType]));
-			}
+			QueueOutgoingUpdate(Channel, InitialObject.Object, HandleUnresolvedObjectsPair.Key, HandleUnresolvedObjectsPair.Value, /* bIsHandover */ true);
 		}
 	}
 
+	uint32 EntityBytes = 0;
+	for (const Worker_ComponentData& ComponentData : ComponentDatas)
+	{
+		EntityBytes += improbable::GetComponentDataSize(ComponentData);
+	}
+	BytesSent += EntityBytes;
+
+	if (NetDriver->OutgoingByteProfiler.IsEnabled())
+	{
+		NetDriver->OutgoingByteProfiler.RecordObjectSend(Channel->Actor->GetClass(), EntityBytes);
+	}
+
 	Worker_EntityId EntityId = Channel->GetEntityId();
 	Worker_RequestId CreateEntityRequestId = Connection->SendCreateEntityRequest(ComponentDatas.Num(), ComponentDatas.GetData(), &EntityId);
 	PendingActorRequests.Add(CreateEntityRequestId, Channel);
@@ -238,7 +243,10 @@ void USpatialSender::SendComponentUpdates(UObject* Object, FClassInfo* Info, USp
 	FUnresolvedObjectsMap HandoverUnresolvedObjectsMap;
 	ComponentFactory UpdateFactory(UnresolvedObjectsMap, HandoverUnresolvedObjectsMap, NetDriver);
 
-	TArray<Worker_ComponentUpdate> ComponentUpdates = UpdateFactory.CreateComponentUpdates(Object, Info, RepChanges, HandoverChanges);
+	FArrayDeltaStates* ArrayDeltaStates = GetDefault<USpatialGDKSettings>()->bEnableArrayDeltaEncoding ? &Channel->GetArrayDeltaStates(Object) : nullptr;
+	FFieldValueHashes* FieldValueHashes = GetDefault<USpatialGDKSettings>()->bEnableFieldValueHashing ? &Channel->GetFieldValueHashes(Object) : nullptr;
+
+	TArray<Worker_ComponentUpdate> ComponentUpdates = UpdateFactory.CreateComponentUpdates(Object, Info, RepChanges, HandoverChanges, ArrayDeltaStates, FieldValueHashes);
 
 	if (RepChanges)
 	{
@@ -277,6 +285,14 @@ void USpatialSender::SendComponentUpdates(UObject* Object, FClassInfo* Info, USp
 			continue;
 		}
 
+		const uint32 UpdateBytes = improbable::GetComponentUpdateSize(Update);
+		BytesSent += UpdateBytes;
+
+		if (NetDriver->OutgoingByteProfiler.IsEnabled())
+		{
+			NetDriver->OutgoingByteProfiler.RecordObjectSend(Object->GetClass(), UpdateBytes);
+		}
+
 		Connection->SendComponentUpdate(EntityId, &Update);
 	}
 }
@@ -334,7 +350,10 @@ void USpatialSender::SendPositionUpdate(Worker_EntityId EntityId, const FVector&
 #endif
 
 	Worker_ComponentUpdate Update = improbable::Position::CreatePositionUpdate(improbable::Coordinates::FromFVector(Location));
+	BytesSent += improbable::GetComponentUpdateSize(Update);
 	Connection->SendComponentUpdate(EntityId, &Update);
+
+	TransformUpdateStats.PositionUpdatesSent++;
 }
 
 void USpatialSender::SendRotationUpdate(Worker_EntityId EntityId, const FRotator& Rotation)
@@ -347,8 +366,120 @@ void USpatialSender::SendRotationUpdate(Worker_EntityId EntityId, const FRotator
 	}
 #endif
 
-	Worker_ComponentUpdate Update = improbable::Rotation(Rotation).CreateRotationUpdate();
+	const ERotationEncoding RotationEncoding = GetDefault<USpatialGDKSettings>()->RotationEncoding;
+	Worker_ComponentUpdate Update = improbable::Rotation(Rotation).CreateRotationUpdate(RotationEncoding);
+	BytesSent += improbable::GetComponentUpdateSize(Update);
 	Connection->SendComponentUpdate(EntityId, &Update);
+
+	TransformUpdateStats.RotationUpdatesSent++;
+	TransformUpdateStats.RotationFieldBytesSent += improbable::Rotation::GetEncodedSize(RotationEncoding, Rotation);
+}
+
+void USpatialSender::RecordSkippedPositionUpdate(bool bRateLimited)
+{
+	if (bRateLimited)
+	{
+		TransformUpdateStats.PositionUpdatesRateLimited++;
+	}
+	else
+	{
+		TransformUpdateStats.PositionUpdatesBelowThreshold++;
+	}
+}
+
+void USpatialSender::RecordSkippedRotationUpdate()
+{
+	TransformUpdateStats.RotationUpdatesBelowThreshold++;
+}
+
+void USpatialSender::DumpTransformUpdateStats(FOutputDevice& Ar) const
+{
+	// Full precision always writes three fixed size floats.
+	const uint64 FullRotationUpdateBytes = improbable::Rotation::GetEncodedSize(ERotationEncoding::Full, FRotator::ZeroRotator);
+	const uint64 FullRotationBytes = TransformUpdateStats.RotationUpdatesSent * FullRotationUpdateBytes;
+
+	// Skips are counted per check, and a later update carries the same movement, so they are not converted into bytes saved.
+	Ar.Logf(TEXT("Position updates sent: %llu, skipped below threshold: %llu, skipped by rate limit: %llu"),
+		TransformUpdateStats.PositionUpdatesSent, TransformUpdateStats.PositionUpdatesBelowThreshold, TransformUpdateStats.PositionUpdatesRateLimited);
+	Ar.Logf(TEXT("Rotation updates sent: %llu, skipped below threshold: %llu"),
+		TransformUpdateStats.RotationUpdatesSent, TransformUpdateStats.RotationUpdatesBelowThreshold);
+	Ar.Logf(TEXT("Rotation fields: %llu bytes sent including field tags (full precision would be %llu bytes), saved %lld bytes"),
+		TransformUpdateStats.RotationFieldBytesSent, FullRotationBytes, (int64)FullRotationBytes - (int64)TransformUpdateStats.RotationFieldBytesSent);
+}
+
+void USpatialSender::RecordArrayReplication(const UProperty* Property, bool bWasDelta)
+{
+	FArrayDeltaStats& Stats = ArrayDeltaStats.FindOrAdd(Property);
+
+	if (bWasDelta)
+	{
+		Stats.DeltaSends++;
+	}
+	else
+	{
+		Stats.FullSends++;
+	}
+}
+
+void USpatialSender::RecordArrayBytes(const UProperty* Property, uint32 FullBytes, uint32 SentBytes)
+{
+	FArrayDeltaStats& Stats = ArrayDeltaStats.FindOrAdd(Property);
+
+	Stats.MeasuredSends++;
+	Stats.BytesSent += SentBytes;
+	Stats.BytesSaved += (int64)FullBytes - (int64)SentBytes;
+}
+
+void USpatialSender::DumpArrayDeltaStats(FOutputDevice& Ar) const
+{
+	TArray<const UProperty*> Properties;
+	ArrayDeltaStats.GetKeys(Properties);
+	Properties.Sort([this](const UProperty& A, const UProperty& B)
+	{
+		return ArrayDeltaStats[&A].BytesSaved > ArrayDeltaStats[&B].BytesSaved;
+	});
+
+	Ar.Logf(TEXT("Array delta encoding (serialized bytes, measured while bEnableOutgoingByteProfiling is set):"));
+	for (const UProperty* Property : Properties)
+	{
+		const FArrayDeltaStats& Stats = ArrayDeltaStats[Property];
+		Ar.Logf(TEXT("    %s: full sends %llu, delta sends %llu, %llu sends measured: sent %llu bytes, saved %lld bytes"),
+			*Property->GetFullGroupName(false), Stats.FullSends, Stats.DeltaSends, Stats.MeasuredSends, Stats.BytesSent, Stats.BytesSaved);
+	}
+}
+
+void USpatialSender::RecordFieldValueHashCheck(const UProperty* Property, bool bSuppressed)
+{
+	TotalFieldValueHashStats.FieldsChecked++;
+	TotalFieldValueHashStats.FieldsSuppressed += bSuppressed ? 1 : 0;
+
+	if (Property != nullptr)
+	{
+		FFieldValueHashStats& Stats = FieldValueHashStats.FindOrAdd(Property);
+		Stats.FieldsChecked++;
+		Stats.FieldsSuppressed += bSuppressed ? 1 : 0;
+	}
+}
+
+void USpatialSender::DumpFieldValueHashStats(FOutputDevice& Ar) const
+{
+	TArray<const UProperty*> Properties;
+	FieldValueHashStats.GetKeys(Properties);
+	Properties.Sort([this](const UProperty& A, const UProperty& B)
+	{
+		return FieldValueHashStats[&A].FieldsSuppressed > FieldValueHashStats[&B].FieldsSuppressed;
+	});
+
+	Ar.Logf(TEXT("Field value hashing: %llu changed fields checked, %llu suppressed"), TotalFieldValueHashStats.FieldsChecked, TotalFieldValueHashStats.FieldsSuppressed);
+	if (Properties.Num() == 0)
+	{
+		Ar.Logf(TEXT("    Enable bEnableOutgoingByteProfiling for per-property counts."));
+	}
+	for (const UProperty* Property : Properties)
+	{
+		const FFieldValueHashStats& Stats = FieldValueHashStats[Property];
+		Ar.Logf(TEXT("    %s: checked %llu, suppressed %llu"), *Property->GetFullGroupName(false), Stats.FieldsChecked, Stats.FieldsSuppressed);
+	}
 }
 
 void USpatialSender::SendRPC(TSharedRef<FPendingRPCParams> Params)
@@ -392,6 +523,7 @@ void USpatialSender::SendRPC(TSharedRef<FPendingRPCParams> Params)
 		if (!UnresolvedObject)
 		{
 			check(EntityId != SpatialConstants::INVALID_ENTITY_ID);
+			RecordRPCBytes(Params->Function, improbable::GetCommandRequestSize(CommandRequest));
 			Worker_RequestId RequestId = Connection->SendCommandRequest(EntityId, &CommandRequest, RPCInfo->Index + 1);
 
 			if (Params->Function->HasAnyFunctionFlags(FUNC_NetReliable))
@@ -405,6 +537,12 @@ void USpatialSender::SendRPC(TSharedRef<FPendingRPCParams> Params)
 	}
 	case SCHEMA_NetMulticastRPC:
 	{
+		if (GetDefault<USpatialGDKSettings>()->bCoalesceMulticastRPCs)
+		{
+			QueueMulticastRPC(TargetObject, Params->Function, Params->Parameters.GetData(), Info->SchemaComponents[RPCInfo->Type], RPCInfo->Index + 1, UnresolvedObject);
+			break;
+		}
+
 		Worker_ComponentUpdate ComponentUpdate = CreateMulticastUpdate(TargetObject, Params->Function, Params->Parameters.GetData(), Info->SchemaComponents[RPCInfo->Type], RPCInfo->Index + 1, EntityId, UnresolvedObject);
 
 		if (!UnresolvedObject)
@@ -417,6 +555,7 @@ void USpatialSender::SendRPC(TSharedRef<FPendingRPCParams> Params)
 				return;
 			}
 
+			RecordRPCBytes(Params->Function, improbable::GetComponentUpdateSize(ComponentUpdate));
 			Connection->SendComponentUpdate(EntityId, &ComponentUpdate);
 		}
 		break;
@@ -432,6 +571,16 @@ void USpatialSender::SendRPC(TSharedRef<FPendingRPCParams> Params)
 	}
 }
 
+void USpatialSender::RecordRPCBytes(const UFunction* Function, uint32 Bytes)
+{
+	BytesSent += Bytes;
+
+	if (NetDriver->OutgoingByteProfiler.IsEnabled())
+	{
+		NetDriver->OutgoingByteProfiler.RecordRPC(Function, Bytes);
+	}
+}
+
 void USpatialSender::SendReserveEntityIdRequest(USpatialActorChannel* Channel)
 {
 	UE_LOG(LogSpatialSender, Log, TEXT("Sending reserve entity Id request for %s"), *Channel->Actor->GetName());
@@ -449,61 +598,66 @@ void USpatialSender::SendCreateEntityRequest(USpatialActorChannel* Channel)
 	Receiver->AddPendingActorRequest(RequestId, Channel);
 }
 
-void USpatialSender::SendDeleteEntityRequest(Worker_EntityId EntityId)
+void USpatialSender::QueueCreateEntityRequest(USpatialActorChannel* Channel)
 {
-	Connection->SendDeleteEntityRequest(EntityId);
+	UE_LOG(LogSpatialSender, Verbose, TEXT("Queueing create entity request for %s"), *Channel->Actor->GetName());
+	QueuedCreateEntityRequests.Add(Channel);
 }
 
-void USpatialSender::ResetOutgoingUpdate(USpatialActorChannel* DependentChannel, UObject* ReplicatedObject, int16 Handle, bool bIsHandover)
+void USpatialSender::ProcessQueuedCreateEntityRequests()
 {
-	check(DependentChannel);
-	check(ReplicatedObject);
-	const FChannelObjectPair ChannelObjectPair(DependentChannel, ReplicatedObject);
-
-	// Choose the correct container based on whether it's handover or not
-	FChannelToHandleToUnresolved& PropertyToUnresolved = bIsHandover ? HandoverPropertyToUnresolved : RepPropertyToUnresolved;
-	FOutgoingRepUpdates& ObjectToUnresolved = bIsHandover ? HandoverObjectToUnresolved : RepObjectToUnresolved;
-
-	FHandleToUnresolved* HandleToUnresolved = PropertyToUnresolved.Find(ChannelObjectPair);
-	if (HandleToUnresolved == nullptr)
+	if (QueuedCreateEntityRequests.Num() == 0)
 	{
 		return;
 	}
 
-	FUnresolvedEntry* UnresolvedPtr = HandleToUnresolved->Find(Handle);
-	if (UnresolvedPtr == nullptr)
+	const uint32 MaxCreationsPerTick = GetDefault<USpatialGDKSettings>()->MaxEntityCreationsPerTick;
+
+	int32 NumProcessed = 0;
+	uint32 NumSent = 0;
+	while (NumProcessed < QueuedCreateEntityRequests.Num() && (MaxCreationsPerTick == 0 || NumSent < MaxCreationsPerTick))
 	{
-		return;
-	}
+		USpatialActorChannel* Channel = QueuedCreateEntityRequests[NumProcessed++].Get();
 
-	FUnresolvedEntry& Unresolved = *UnresolvedPtr;
+		// The channel may have been closed, or its actor destroyed, while the request was queued.
+		if (Channel == nullptr || Channel->Actor == nullptr || Channel->Actor->IsPendingKill())
+		{
+			continue;
+		}
 
-	check(Unresolved.IsValid());
+		SendCreateEntityRequest(Channel);
+		NumSent++;
+	}
 
-	UE_LOG(LogSpatialSender, Log, TEXT("Resetting pending outgoing array depending on channel: %s, object: %s, handle: %d."),
-		*DependentChannel->GetName(), *ReplicatedObject->GetName(), Handle);
+	QueuedCreateEntityRequests.RemoveAt(0, NumProcessed, /* bAllowShrinking */ false);
 
-	for (const UObject* UnresolvedObject : *Unresolved)
+	if (QueuedCreateEntityRequests.Num() > 0)
 	{
-		FChannelToHandleToUnresolved& ChannelToUnresolved = ObjectToUnresolved.FindChecked(UnresolvedObject);
-		FHandleToUnresolved& OtherHandleToUnresolved = ChannelToUnresolved.FindChecked(ChannelObjectPair);
-
-		OtherHandleToUnresolved.Remove(Handle);
-		if (OtherHandleToUnresolved.Num() == 0)
-		{
-			ChannelToUnresolved.Remove(ChannelObjectPair);
-			if (ChannelToUnresolved.Num() == 0)
-			{
-				ObjectToUnresolved.Remove(UnresolvedObject);
-			}
-		}
+		UE_LOG(LogSpatialSender, Verbose, TEXT("Sent %u create entity requests this tick, %d deferred to the next tick"), NumSent, QueuedCreateEntityRequests.Num());
 	}
+}
 
-	HandleToUnresolved->Remove(Handle);
-	if (HandleToUnresolved->Num() == 0)
+void USpatialSender::SendDeleteEntityRequest(Worker_EntityId EntityId)
+{
+	// Send multicasts collected this tick before the entity goes away, as they would have been without coalescing.
+	if (FPendingMulticastRPCs* PendingRPCs = PendingMulticastRPCs.Find(EntityId))
 	{
-		PropertyToUnresolved.Remove(ChannelObjectPair);
+		SendPendingMulticastRPCs(EntityId, *PendingRPCs);
+		PendingMulticastRPCs.Remove(EntityId);
 	}
+
+	Connection->SendDeleteEntityRequest(EntityId);
+}
+
+void USpatialSender::ResetOutgoingUpdate(USpatialActorChannel* DependentChannel, UObject* ReplicatedObject, int16 Handle, bool bIsHandover)
+{
+	check(DependentChannel);
+	check(ReplicatedObject);
+	const FChannelObjectPair ChannelObjectPair(DependentChannel, ReplicatedObject);
+
+	// Choose the correct container based on whether it's handover or not
+	FUnresolvedReferenceTable& UnresolvedReferences = bIsHandover ? HandoverUnresolvedReferences : RepUnresolvedReferences;
+	UnresolvedReferences.Remove(ChannelObjectPair, Handle);
 }
 
 void USpatialSender::QueueOutgoingUpdate(USpatialActorChannel* DependentChannel, UObject* ReplicatedObject, int16 Handle, const TSet<const UObject*>& UnresolvedObjects, bool bIsHandover)
@@ -515,29 +669,19 @@ void USpatialSender::QueueOutgoingUpdate(USpatialActorChannel* DependentChannel,
 	UE_LOG(LogSpatialSender, Log, TEXT("Added pending outgoing property: channel: %s, object: %s, handle: %d. Depending on objects:"),
 		*DependentChannel->GetName(), *ReplicatedObject->GetName(), Handle);
 
-	// Choose the correct container based on whether it's handover or not
-	FChannelToHandleToUnresolved& PropertyToUnresolved = bIsHandover ? HandoverPropertyToUnresolved : RepPropertyToUnresolved;
-	FOutgoingRepUpdates& ObjectToUnresolved = bIsHandover ? HandoverObjectToUnresolved : RepObjectToUnresolved;
-
-	FUnresolvedEntry Unresolved = MakeShared<TSet<const UObject*>>();
-	*Unresolved = UnresolvedObjects;
-
-	FHandleToUnresolved& HandleToUnresolved = PropertyToUnresolved.FindOrAdd(ChannelObjectPair);
-	if (HandleToUnresolved.Find(Handle))
-	{
-		HandleToUnresolved.Remove(Handle);
-	}
-	HandleToUnresolved.Add(Handle, Unresolved);
-
 	for (const UObject* UnresolvedObject : UnresolvedObjects)
 	{
-		FHandleToUnresolved& AnotherHandleToUnresolved = ObjectToUnresolved.FindOrAdd(UnresolvedObject).FindOrAdd(ChannelObjectPair);
-		check(!AnotherHandleToUnresolved.Find(Handle));
-		AnotherHandleToUnresolved.Add(Handle, Unresolved);
-
 		// Following up on the previous log: listing the unresolved objects
 		UE_LOG(LogSpatialSender, Log, TEXT("- %s"), *UnresolvedObject->GetName());
 	}
+
+	// Choose the correct container based on whether it's handover or not
+	FUnresolvedReferenceTable& UnresolvedReferences = bIsHandover ? HandoverUnresolvedReferences : RepUnresolvedReferences;
+
+	// Hack to figure out if this property is an array to add extra handles when it gets resolved
+	const bool bIsDynamicArray = !bIsHandover && DependentChannel->IsDynamicArrayHandle(ReplicatedObject, Handle);
+
+	UnresolvedReferences.Add(ChannelObjectPair, Handle, bIsDynamicArray, UnresolvedObjects);
 }
 
 void USpatialSender::QueueOutgoingRPC(const UObject* UnresolvedObject, TSharedRef<FPendingRPCParams> Params)
@@ -564,8 +708,11 @@ Worker_CommandRequest USpatialSender::CreateRPCCommandRequest(UObject* TargetObj
 
 	OutEntityId = TargetObjectRef.Entity;
 
+	// Cross server RPCs are only received by servers, so their object ref paths can be interned.
+	UObjectRefPathDictionary* PathDictionary = TypebindingManager->FindCategoryByComponentId(ComponentId) == SCHEMA_CrossServerRPC ? NetDriver->ObjectRefPathDictionary : nullptr;
+
 	TSet<const UObject*> UnresolvedObjects;
-	FSpatialNetBitWriter PayloadWriter(PackageMap, UnresolvedObjects);
+	FSpatialNetBitWriter PayloadWriter(PackageMap, UnresolvedObjects, PathDictionary);
 
 	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetFunctionRepLayout(Function);
 	RepLayout_SendPropertiesForRPC(*RepLayout, PayloadWriter, Parameters);
@@ -590,14 +737,22 @@ Worker_ComponentUpdate USpatialSender::CreateMulticastUpdate(UObject* TargetObje
 	ComponentUpdate.component_id = ComponentId;
 	ComponentUpdate.schema_type = Schema_CreateComponentUpdate(ComponentId);
 	Schema_Object* EventsObject = Schema_GetComponentUpdateEvents(ComponentUpdate.schema_type);
-	Schema_Object* EventData = Schema_AddObject(EventsObject, EventIndex);
 
+	if (!AddMulticastEvent(EventsObject, TargetObject, Function, Parameters, EventIndex, OutEntityId, OutUnresolvedObject))
+	{
+		Schema_DestroyComponentUpdate(ComponentUpdate.schema_type);
+	}
+
+	return ComponentUpdate;
+}
+
+bool USpatialSender::AddMulticastEvent(Schema_Object* EventsObject, UObject* TargetObject, UFunction* Function, void* Parameters, Schema_FieldId EventIndex, Worker_EntityId& OutEntityId, const UObject*& OutUnresolvedObject)
+{
 	FUnrealObjectRef TargetObjectRef(PackageMap->GetUnrealObjectRefFromNetGUID(PackageMap->GetNetGUIDFromObject(TargetObject)));
 	if (TargetObjectRef == SpatialConstants::UNRESOLVED_OBJECT_REF)
 	{
 		OutUnresolvedObject = TargetObject;
-		Schema_DestroyComponentUpdate(ComponentUpdate.schema_type);
-		return ComponentUpdate;
+		return false;
 	}
 
 	OutEntityId = TargetObjectRef.Entity;
@@ -612,13 +767,133 @@ Worker_ComponentUpdate USpatialSender::CreateMulticastUpdate(UObject* TargetObje
 	{
 		// Take the first unresolved object
 		OutUnresolvedObject = Object;
-		Schema_DestroyComponentUpdate(ComponentUpdate.schema_type);
-		return ComponentUpdate;
+		return false;
 	}
 
+	// The event is only added once the payload is known to be complete, so a failed event doesn't leave an empty
+	// entry in an update that other events are being collected into.
+	Schema_Object* EventData = Schema_AddObject(EventsObject, EventIndex);
 	AddPayloadToSchema(EventData, 1, PayloadWriter);
 
-	return ComponentUpdate;
+	return true;
+}
+
+void USpatialSender::QueueMulticastRPC(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, Schema_FieldId EventIndex, const UObject*& OutUnresolvedObject)
+{
+	// SendRPC has already checked that the target object is resolved.
+	const Worker_EntityId EntityId = PackageMap->GetUnrealObjectRefFromObject(TargetObject).Entity;
+
+	if (!NetDriver->StaticComponentView->HasAuthority(EntityId, ComponentId))
+	{
+		UE_LOG(LogSpatialSender, Warning, TEXT("Trying to send MulticastRPC component update but don't have authority! Update will not be sent. Entity: %lld"), EntityId);
+		return;
+	}
+
+	FMulticastRPCStats& Stats = MulticastRPCStats.FindOrAdd(Function);
+	FPendingMulticastRPCs& PendingRPCs = PendingMulticastRPCs.FindOrAdd(EntityId);
+
+	const bool bReliable = Function->HasAnyFunctionFlags(FUNC_NetReliable);
+	const uint32 MaxUnreliableRPCs = GetDefault<USpatialGDKSettings>()->MaxUnreliableMulticastRPCsPerEntityPerTick;
+	if (!bReliable && MaxUnreliableRPCs > 0 && PendingRPCs.NumUnreliableEvents >= MaxUnreliableRPCs)
+	{
+		// Events can't be taken back out of a schema update, so the newest unreliable multicasts are the ones dropped.
+		Stats.Dropped++;
+		return;
+	}
+
+	Worker_ComponentUpdate* ComponentUpdate = PendingRPCs.Updates.Find(ComponentId);
+	if (ComponentUpdate == nullptr)
+	{
+		ComponentUpdate = &PendingRPCs.Updates.Add(ComponentId);
+		ComponentUpdate->component_id = ComponentId;
+		ComponentUpdate->schema_type = Schema_CreateComponentUpdate(ComponentId);
+	}
+
+	Schema_Object* EventsObject = Schema_GetComponentUpdateEvents(ComponentUpdate->schema_type);
+	const uint32 SizeBeforeEvent = Schema_GetWriteBufferLength(EventsObject);
+
+	Worker_EntityId TargetEntityId = SpatialConstants::INVALID_ENTITY_ID;
+	if (!AddMulticastEvent(EventsObject, TargetObject, Function, Parameters, EventIndex, TargetEntityId, OutUnresolvedObject))
+	{
+		return;
+	}
+
+	if (!bReliable)
+	{
+		PendingRPCs.NumUnreliableEvents++;
+	}
+	Stats.Coalesced++;
+
+	// The bytes of the coalesced update are counted when it's sent, so only attribute the event's bytes to the RPC here.
+	if (NetDriver->OutgoingByteProfiler.IsEnabled())
+	{
+		NetDriver->OutgoingByteProfiler.RecordRPC(Function, Schema_GetWriteBufferLength(EventsObject) - SizeBeforeEvent);
+	}
+}
+
+void USpatialSender::FlushPendingMulticastRPCs()
+{
+	for (auto& EntityRPCsPair : PendingMulticastRPCs)
+	{
+		SendPendingMulticastRPCs(EntityRPCsPair.Key, EntityRPCsPair.Value);
+	}
+
+	PendingMulticastRPCs.Empty();
+}
+
+void USpatialSender::SendPendingMulticastRPCs(Worker_EntityId EntityId, FPendingMulticastRPCs& PendingRPCs)
+{
+	for (auto& ComponentUpdatePair : PendingRPCs.Updates)
+	{
+		Worker_ComponentUpdate& ComponentUpdate = ComponentUpdatePair.Value;
+
+		if (Schema_GetWriteBufferLength(Schema_GetComponentUpdateEvents(ComponentUpdate.schema_type)) == 0)
+		{
+			// Every event queued for this object was waiting on an unresolved object.
+			Schema_DestroyComponentUpdate(ComponentUpdate.schema_type);
+			continue;
+		}
+
+		if (!NetDriver->StaticComponentView->HasAuthority(EntityId, ComponentUpdate.component_id))
+		{
+			UE_LOG(LogSpatialSender, Warning, TEXT("Lost authority over entity %lld before coalesced MulticastRPC update could be sent. Update will not be sent."), EntityId);
+			Schema_DestroyComponentUpdate(ComponentUpdate.schema_type);
+			continue;
+		}
+
+		BytesSent += improbable::GetComponentUpdateSize(ComponentUpdate);
+		NumCoalescedMulticastUpdatesSent++;
+		Connection->SendComponentUpdate(EntityId, &ComponentUpdate);
+	}
+
+	PendingRPCs.Updates.Empty();
+	PendingRPCs.NumUnreliableEvents = 0;
+}
+
+void USpatialSender::DumpMulticastRPCStats(FOutputDevice& Ar) const
+{
+	TArray<const UFunction*> Functions;
+	MulticastRPCStats.GetKeys(Functions);
+	Functions.Sort([this](const UFunction& A, const UFunction& B)
+	{
+		return MulticastRPCStats[&A].Coalesced + MulticastRPCStats[&A].Dropped > MulticastRPCStats[&B].Coalesced + MulticastRPCStats[&B].Dropped;
+	});
+
+	uint64 TotalCoalesced = 0;
+	uint64 TotalDropped = 0;
+	for (const auto& FunctionStatsPair : MulticastRPCStats)
+	{
+		TotalCoalesced += FunctionStatsPair.Value.Coalesced;
+		TotalDropped += FunctionStatsPair.Value.Dropped;
+	}
+
+	Ar.Logf(TEXT("Coalesced multicast RPCs: %llu events in %llu updates (%.2f events per update), %llu unreliable events dropped"), TotalCoalesced, NumCoalescedMulticastUpdatesSent,
+		NumCoalescedMulticastUpdatesSent > 0 ? (double)TotalCoalesced / NumCoalescedMulticastUpdatesSent : 0.0, TotalDropped);
+	for (const UFunction* Function : Functions)
+	{
+		const FMulticastRPCStats& Stats = MulticastRPCStats[Function];
+		Ar.Logf(TEXT("    %s::%s: coalesced %llu, dropped %llu"), *Function->GetOuter()->GetName(), *Function->GetName(), Stats.Coalesced, Stats.Dropped);
+	}
 }
 
 void USpatialSender::SendCommandResponse(Worker_RequestId request_id, Worker_CommandResponse& Response)
@@ -629,16 +904,29 @@ void USpatialSender::SendCommandResponse(Worker_RequestId request_id, Worker_Com
 void USpatialSender::ResolveOutgoingOperations(UObject* Object, bool bIsHandover)
 {
 	// Choose the correct container based on whether it's handover or not
-	FChannelToHandleToUnresolved& PropertyToUnresolved = bIsHandover ? HandoverPropertyToUnresolved : RepPropertyToUnresolved;
-	FOutgoingRepUpdates& ObjectToUnresolved = bIsHandover ? HandoverObjectToUnresolved : RepObjectToUnresolved;
+	FUnresolvedReferenceTable& UnresolvedReferences = bIsHandover ? HandoverUnresolvedReferences : RepUnresolvedReferences;
 
-	FChannelToHandleToUnresolved* ChannelToUnresolved = ObjectToUnresolved.Find(Object);
-	if (!ChannelToUnresolved)
+	TArray<FPendingOutgoingProperty> ReadyProperties;
+	UnresolvedReferences.Resolve(Object, ReadyProperties);
+	if (ReadyProperties.Num() == 0)
 	{
 		return;
 	}
 
-	for (auto& ChannelProperties : *ChannelToUnresolved)
+	TMap<FChannelObjectPair, TArray<uint16>> ChannelToPropertyHandles;
+	for (const FPendingOutgoingProperty& ReadyProperty : ReadyProperties)
+	{
+		TArray<uint16>& PropertyHandles = ChannelToPropertyHandles.FindOrAdd(ReadyProperty.ChannelObjectPair);
+		PropertyHandles.Add(ReadyProperty.Handle);
+
+		if (ReadyProperty.bIsDynamicArray)
+		{
+			PropertyHandles.Add(0);
+			PropertyHandles.Add(0);
+		}
+	}
+
+	for (auto& ChannelProperties : ChannelToPropertyHandles)
 	{
 		FChannelObjectPair& ChannelObjectPair = ChannelProperties.Key;
 		if (!ChannelObjectPair.Key.IsValid() || !ChannelObjectPair.Value.IsValid())
@@ -648,7 +936,7 @@ void USpatialSender::ResolveOutgoingOperations(UObject* Object, bool bIsHandover
 
 		USpatialActorChannel* DependentChannel = ChannelObjectPair.Key.Get();
 		UObject* ReplicatingObject = ChannelObjectPair.Value.Get();
-		FHandleToUnresolved& HandleToUnresolved = ChannelProperties.Value;
+		TArray<uint16>& PropertyHandles = ChannelProperties.Value;
 
 		FClassInfo* Info = TypebindingManager->FindClassInfoByObject(ReplicatingObject);
 		if (Info == nullptr)
@@ -656,51 +944,18 @@ void USpatialSender::ResolveOutgoingOperations(UObject* Object, bool bIsHandover
 			continue;
 		}
 
-		TArray<uint16> PropertyHandles;
-
-		for (auto& HandleUnresolvedPair : HandleToUnresolved)
+		if (bIsHandover)
 		{
-			uint16 Handle = HandleUnresolvedPair.Key;
-			FUnresolvedEntry& Unresolved = HandleUnresolvedPair.Value;
-
-			Unresolved->Remove(Object);
-			if (Unresolved->Num() == 0)
-			{
-				PropertyHandles.Add(Handle);
-
-				// Hack to figure out if this property is an array to add extra handles
-				if (!bIsHandover && DependentChannel->IsDynamicArrayHandle(ReplicatingObject, Handle))
-				{
-					PropertyHandles.Add(0);
-					PropertyHandles.Add(0);
-				}
-
-				FHandleToUnresolved& AnotherHandleToUnresolved = PropertyToUnresolved.FindChecked(ChannelObjectPair);
-				AnotherHandleToUnresolved.Remove(Handle);
-				if (AnotherHandleToUnresolved.Num() == 0)
-				{
-					PropertyToUnresolved.Remove(ChannelObjectPair);
-				}
-			}
+			SendComponentUpdates(ReplicatingObject, Info, DependentChannel, nullptr, &PropertyHandles);
 		}
-
-		if (PropertyHandles.Num() > 0)
+		else
 		{
-			if (bIsHandover)
-			{
-				SendComponentUpdates(ReplicatingObject, Info, DependentChannel, nullptr, &PropertyHandles);
-			}
-			else
-			{
-				// End with zero to indicate the end of the list of handles.
-				PropertyHandles.Add(0);
-				FRepChangeState RepChangeState = { PropertyHandles, DependentChannel->GetObjectRepLayout(ReplicatingObject) };
-				SendComponentUpdates(ReplicatingObject, Info, DependentChannel, &RepChangeState, nullptr);
-			}
+			// End with zero to indicate the end of the list of handles.
+			PropertyHandles.Add(0);
+			FRepChangeState RepChangeState = { PropertyHandles, DependentChannel->GetObjectRepLayout(ReplicatingObject) };
+			SendComponentUpdates(ReplicatingObject, Info, DependentChannel, &RepChangeState, nullptr);
 		}
 	}
-
-	ObjectToUnresolved.Remove(Object);
 }
 
 void USpatialSender::ResolveOutgoingRPCs(UObject* Object)
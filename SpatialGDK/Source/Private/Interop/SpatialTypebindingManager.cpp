@@ -13,176 +13,346 @@
 
 #include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
+#include "SpatialGDKSettings.h"
+
+DEFINE_LOG_CATEGORY(LogSpatialTypebindingManager);
 
 void USpatialTypebindingManager::Init(USpatialNetDriver* InNetDriver)
 {
 	NetDriver = InNetDriver;
-	
+
+	double StartTime = FPlatformTime::Seconds();
+
 	TSoftObjectPtr<USchemaDatabase> SchemaDatabasePtr(FSoftObjectPath(TEXT("/Game/Spatial/SchemaDatabase.SchemaDatabase")));
 	SchemaDatabasePtr.LoadSynchronous();
 	SchemaDatabase = SchemaDatabasePtr.Get();
 
+	Stats.SchemaDatabaseLoadSeconds = FPlatformTime::Seconds() - StartTime;
+
 	if (SchemaDatabase == nullptr)
 	{
 		FMessageDialog::Debugf(FText::FromString(TEXT("SchemaDatabase not found! No classes will be supported for SpatialOS replication.")));
 		return;
 	}
 
-	FindSupportedClasses();
-	CreateTypebindings();
-}
-
-void USpatialTypebindingManager::FindSupportedClasses()
-{
-	TArray<FString> SupportedClassPaths;
-	SchemaDatabase->ClassPathToSchema.GetKeys(SupportedClassPaths);
+	StartTime = FPlatformTime::Seconds();
+	CreateComponentMaps();
+	Stats.ComponentMapSeconds = FPlatformTime::Seconds() - StartTime;
 
-	for (auto& ClassPath : SupportedClassPaths)
+	if (GetDefault<USpatialGDKSettings>()->bLoadTypebindingClassesAsync)
 	{
-		FSoftClassPath SoftClassPath(ClassPath);
-		UClass* Class = SoftClassPath.TryLoadClass<UObject>();
-
-		if (Class != nullptr)
-		{
-			SupportedClasses.Add(Class);
-		}
+		RequestSupportedClassesAsync();
 	}
+	else
+	{
+		LoadSupportedClasses();
+	}
+
+	UE_LOG(LogSpatialTypebindingManager, Log, TEXT("Typebindings initialized: schema database loaded in %.2f ms, %d components mapped in %.2f ms, %d classes %s in %.2f ms, %d class infos built in %.2f ms."),
+		Stats.SchemaDatabaseLoadSeconds * 1000.0, NumComponentTypeInfos, Stats.ComponentMapSeconds * 1000.0,
+		Stats.NumStartupClasses, SupportedClassesHandle.IsValid() ? TEXT("requested") : TEXT("loaded"), Stats.StartupClassLoadSeconds * 1000.0,
+		Stats.NumClassInfosBuilt, Stats.ClassInfoBuildSeconds * 1000.0);
 }
 
-void USpatialTypebindingManager::CreateTypebindings()
+void USpatialTypebindingManager::CreateComponentMaps()
 {
-	// This will iterate through all supported classes: both Actor and Subobject classes
-	// For subobject classes, an FClassInfo will be created with RPC metadata and handover data
-	// but schema components will be 0 since subobject classes don't have associated components
-	// afterwards, the subobject FClassInfos will be the basis of the FClassInfo for specific subobjects
-	// and have their proper schema components filled in
-	for (UClass* Class : SupportedClasses)
+	// Only the class paths are needed here, classes are loaded when their components are first looked up.
+	TMap<Worker_ComponentId, FComponentTypeInfo> ComponentTypeInfos;
+
+	for (auto& ClassSchemaPair : SchemaDatabase->ClassPathToSchema)
 	{
-		FClassInfo Info;
+		const FSchemaData& SchemaData = ClassSchemaPair.Value;
 
-		for (TFieldIterator<UFunction> RemoteFunction(Class); RemoteFunction; ++RemoteFunction)
+		ForAllSchemaComponentTypes([&](ESchemaComponentType Type)
 		{
-			if (RemoteFunction->FunctionFlags & FUNC_NetClient ||
-				RemoteFunction->FunctionFlags & FUNC_NetServer ||
-				RemoteFunction->FunctionFlags & FUNC_NetCrossServer ||
-				RemoteFunction->FunctionFlags & FUNC_NetMulticast)
+			Worker_ComponentId ComponentId = SchemaData.SchemaComponents[Type];
+			if (ComponentId != 0)
 			{
-				ESchemaComponentType RPCType = SCHEMA_Invalid;
-				if (RemoteFunction->FunctionFlags & FUNC_NetClient)
-				{
-					RPCType = SCHEMA_ClientRPC;
-				}
-				else if (RemoteFunction->FunctionFlags & FUNC_NetServer)
-				{
-					RPCType = SCHEMA_ServerRPC;
-				}
-				else if (RemoteFunction->FunctionFlags & FUNC_NetCrossServer)
-				{
-					RPCType = SCHEMA_CrossServerRPC;
-				}
-				else if (RemoteFunction->FunctionFlags & FUNC_NetMulticast)
-				{
-					RPCType = SCHEMA_NetMulticastRPC;
-				}
-				else
-				{
-					checkNoEntry();
-				}
-
-				TArray<UFunction*>& RPCArray = Info.RPCs.FindOrAdd(RPCType);
-
-				FRPCInfo RPCInfo;
-				RPCInfo.Type = RPCType;
-				RPCInfo.Index = RPCArray.Num();
-
-				RPCArray.Add(*RemoteFunction);
-				Info.RPCInfoMap.Add(*RemoteFunction, RPCInfo);
+				FComponentTypeInfo& ComponentInfo = ComponentTypeInfos.Add(ComponentId);
+				ComponentInfo.ClassPath = FSoftClassPath(ClassSchemaPair.Key);
+				ComponentInfo.Offset = 0;
+				ComponentInfo.Category = Type;
 			}
-		}
+		});
 
-		for (TFieldIterator<UProperty> PropertyIt(Class); PropertyIt; ++PropertyIt)
+		for (auto& SubobjectDataPair : SchemaData.SubobjectData)
 		{
-			UProperty* Property = *PropertyIt;
+			const FSubobjectSchemaData& SubobjectSchemaData = SubobjectDataPair.Value;
 
-			if (Property->PropertyFlags & CPF_Handover)
+			ForAllSchemaComponentTypes([&](ESchemaComponentType Type)
 			{
-				for (int32 ArrayIdx = 0; ArrayIdx < PropertyIt->ArrayDim; ++ArrayIdx)
+				Worker_ComponentId ComponentId = SubobjectSchemaData.SchemaComponents[Type];
+				if (ComponentId != 0)
 				{
-					FHandoverPropertyInfo HandoverInfo;
-					HandoverInfo.Handle = Info.HandoverProperties.Num() + 1; // 1-based index
-					HandoverInfo.Offset = Property->GetOffset_ForGC() + Property->ElementSize * ArrayIdx;
-					HandoverInfo.ArrayIdx = ArrayIdx;
-					HandoverInfo.Property = Property;
-
-					Info.HandoverProperties.Add(HandoverInfo);
+					FComponentTypeInfo& ComponentInfo = ComponentTypeInfos.Add(ComponentId);
+					ComponentInfo.ClassPath = FSoftClassPath(SubobjectSchemaData.ClassPath);
+					ComponentInfo.Offset = SubobjectDataPair.Key;
+					ComponentInfo.Category = Type;
 				}
-			}
+			});
 		}
+	}
 
-		ForAllSchemaComponentTypes([&](ESchemaComponentType Type)
+	NumComponentTypeInfos = ComponentTypeInfos.Num();
+
+	// Classes removed since schema was last generated leave gaps in the IDs, so the table may be up to twice as long as
+	// the number of components before IDs go in the map instead.
+	const uint32 MaxDenseIndex = 2 * NumComponentTypeInfos;
+
+	for (auto& ComponentInfoPair : ComponentTypeInfos)
+	{
+		const Worker_ComponentId ComponentId = ComponentInfoPair.Key;
+		const uint32 Index = ComponentId - SpatialConstants::STARTING_GENERATED_COMPONENT_ID;
+
+		if (ComponentId >= SpatialConstants::STARTING_GENERATED_COMPONENT_ID && Index < MaxDenseIndex)
 		{
-			Worker_ComponentId ComponentId = SchemaDatabase->ClassPathToSchema[Class->GetPathName()].SchemaComponents[Type];
-			if (ComponentId != 0)
+			if (GeneratedComponentTypeInfos.Num() <= (int32)Index)
 			{
-				Info.SchemaComponents[Type] = ComponentId;
-				ComponentToClassMap.Add(ComponentId, Class);
-				ComponentToOffsetMap.Add(ComponentId, 0);
-				ComponentToCategoryMap.Add(ComponentId, (ESchemaComponentType)Type);
+				GeneratedComponentTypeInfos.SetNum(Index + 1);
 			}
-		});
-
-		Info.Class = Class;
+			GeneratedComponentTypeInfos[Index] = MoveTemp(ComponentInfoPair.Value);
+		}
+		else
+		{
+			SparseComponentTypeInfos.Add(ComponentId, MoveTemp(ComponentInfoPair.Value));
+		}
+	}
+}
 
-		ClassInfoMap.Emplace(Class, Info);
+USpatialTypebindingManager::FComponentTypeInfo* USpatialTypebindingManager::FindComponentTypeInfo(Worker_ComponentId ComponentId)
+{
+	const uint32 Index = ComponentId - SpatialConstants::STARTING_GENERATED_COMPONENT_ID;
+	if (ComponentId >= SpatialConstants::STARTING_GENERATED_COMPONENT_ID && Index < (uint32)GeneratedComponentTypeInfos.Num())
+	{
+		FComponentTypeInfo& ComponentInfo = GeneratedComponentTypeInfos[Index];
+		return ComponentInfo.Category != SCHEMA_Invalid ? &ComponentInfo : nullptr;
 	}
 
-	for (UClass* Class : SupportedClasses)
+	return SparseComponentTypeInfos.Find(ComponentId);
+}
+
+const USpatialTypebindingManager::FComponentTypeInfo* USpatialTypebindingManager::FindComponentTypeInfo(Worker_ComponentId ComponentId) const
+{
+	return const_cast<USpatialTypebindingManager*>(this)->FindComponentTypeInfo(ComponentId);
+}
+
+void USpatialTypebindingManager::LoadSupportedClasses()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<UClass*> LoadedClasses;
+	for (auto& ClassSchemaPair : SchemaDatabase->ClassPathToSchema)
 	{
-		for (auto& SubobjectDataPair : SchemaDatabase->ClassPathToSchema[Class->GetPathName()].SubobjectData)
+		FSoftClassPath SoftClassPath(ClassSchemaPair.Key);
+		if (UClass* Class = SoftClassPath.TryLoadClass<UObject>())
 		{
-			int32 Offset = SubobjectDataPair.Key;
-			FSubobjectSchemaData SubobjectSchemaData = SubobjectDataPair.Value;
+			LoadedClasses.Add(Class);
+		}
+	}
+
+	Stats.NumStartupClasses = LoadedClasses.Num();
+	Stats.StartupClassLoadSeconds = FPlatformTime::Seconds() - StartTime;
+
+	for (UClass* Class : LoadedClasses)
+	{
+		FindClassInfoByClass(Class);
+	}
+}
+
+void USpatialTypebindingManager::RequestSupportedClassesAsync()
+{
+	AsyncClassLoadStartTime = FPlatformTime::Seconds();
+
+	TArray<FSoftObjectPath> SupportedClassPaths;
+	for (auto& ClassSchemaPair : SchemaDatabase->ClassPathToSchema)
+	{
+		SupportedClassPaths.Add(FSoftClassPath(ClassSchemaPair.Key));
+	}
+
+	Stats.NumStartupClasses = SupportedClassPaths.Num();
+
+	// Class infos are built as classes are used, classes needed before the load completes are loaded synchronously.
+	SupportedClassesHandle = StreamableManager.RequestAsyncLoad(SupportedClassPaths, FStreamableDelegate::CreateUObject(this, &USpatialTypebindingManager::OnSupportedClassesLoaded));
+
+	Stats.StartupClassLoadSeconds = FPlatformTime::Seconds() - AsyncClassLoadStartTime;
+}
+
+void USpatialTypebindingManager::OnSupportedClassesLoaded()
+{
+	Stats.AsyncClassLoadSeconds = FPlatformTime::Seconds() - AsyncClassLoadStartTime;
+	Stats.bAsyncClassLoadComplete = true;
+
+	UE_LOG(LogSpatialTypebindingManager, Log, TEXT("Loaded %d classes asynchronously in %.2f ms. %d were needed earlier and loaded synchronously in %.2f ms."),
+		Stats.NumStartupClasses, Stats.AsyncClassLoadSeconds * 1000.0, Stats.NumClassesLoadedOnDemand, Stats.OnDemandClassLoadSeconds * 1000.0);
+}
+
+UClass* USpatialTypebindingManager::LoadClass(const FSoftClassPath& ClassPath)
+{
+	if (UClass* Class = ClassPath.ResolveClass())
+	{
+		return Class;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	UClass* Class = ClassPath.TryLoadClass<UObject>();
+
+	if (SupportedClassesHandle.IsValid())
+	{
+		Stats.NumClassesLoadedOnDemand++;
+		Stats.OnDemandClassLoadSeconds += FPlatformTime::Seconds() - StartTime;
+	}
+
+	return Class;
+}
 
-			FClassInfo* ActorInfo = FindClassInfoByClass(Class);
+FClassInfo& USpatialTypebindingManager::CreateClassInfo(UClass* Class, const FSchemaData& SchemaData)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Added before the subobject infos are built, which look up class infos themselves.
+	TSharedRef<FClassInfo> Info = MakeShared<FClassInfo>();
+	Info->Class = Class;
+	ClassInfoMap.Add(Class, Info);
+	SupportedClasses.Add(Class);
 
-			FSoftClassPath SubobjectClassPath(SubobjectSchemaData.ClassPath);
-			UClass* SubobjectClass = SubobjectClassPath.TryLoadClass<UObject>();
-			if (SubobjectClass == nullptr)
+	for (TFieldIterator<UFunction> RemoteFunction(Class); RemoteFunction; ++RemoteFunction)
+	{
+		if (RemoteFunction->FunctionFlags & FUNC_NetClient ||
+			RemoteFunction->FunctionFlags & FUNC_NetServer ||
+			RemoteFunction->FunctionFlags & FUNC_NetCrossServer ||
+			RemoteFunction->FunctionFlags & FUNC_NetMulticast)
+		{
+			ESchemaComponentType RPCType = SCHEMA_Invalid;
+			if (RemoteFunction->FunctionFlags & FUNC_NetClient)
 			{
-				continue;
+				RPCType = SCHEMA_ClientRPC;
 			}
-
-			FClassInfo* SubobjectInfoPtr = FindClassInfoByClass(SubobjectClass);
-			if (SubobjectInfoPtr == nullptr)
+			else if (RemoteFunction->FunctionFlags & FUNC_NetServer)
+			{
+				RPCType = SCHEMA_ServerRPC;
+			}
+			else if (RemoteFunction->FunctionFlags & FUNC_NetCrossServer)
+			{
+				RPCType = SCHEMA_CrossServerRPC;
+			}
+			else if (RemoteFunction->FunctionFlags & FUNC_NetMulticast)
 			{
-				continue;
+				RPCType = SCHEMA_NetMulticastRPC;
+			}
+			else
+			{
+				checkNoEntry();
 			}
 
-			// Make a copy of the already made FClassInfo for this specific subobject
-			FClassInfo SubobjectInfo = *SubobjectInfoPtr;
+			TArray<UFunction*>& RPCArray = Info->RPCs.FindOrAdd(RPCType);
 
-			SubobjectInfo.SubobjectName = SubobjectSchemaData.Name;
+			FRPCInfo RPCInfo;
+			RPCInfo.Type = RPCType;
+			RPCInfo.Index = RPCArray.Num();
 
-			ForAllSchemaComponentTypes([&](ESchemaComponentType Type)
+			RPCArray.Add(*RemoteFunction);
+			Info->RPCInfoMap.Add(*RemoteFunction, RPCInfo);
+		}
+	}
+
+	for (TFieldIterator<UProperty> PropertyIt(Class); PropertyIt; ++PropertyIt)
+	{
+		UProperty* Property = *PropertyIt;
+
+		if (Property->PropertyFlags & CPF_Handover)
+		{
+			for (int32 ArrayIdx = 0; ArrayIdx < PropertyIt->ArrayDim; ++ArrayIdx)
 			{
-				Worker_ComponentId ComponentId = SubobjectSchemaData.SchemaComponents[Type];
-				if (ComponentId != 0)
-				{
-					SubobjectInfo.SchemaComponents[Type] = ComponentId;
-					ComponentToClassMap.Add(ComponentId, SubobjectClass);
-					ComponentToOffsetMap.Add(ComponentId, Offset);
-					ComponentToCategoryMap.Add(ComponentId, (ESchemaComponentType)Type);
-				}
-			});
+				FHandoverPropertyInfo HandoverInfo;
+				HandoverInfo.Handle = Info->HandoverProperties.Num() + 1; // 1-based index
+				HandoverInfo.Offset = Property->GetOffset_ForGC() + Property->ElementSize * ArrayIdx;
+				HandoverInfo.ArrayIdx = ArrayIdx;
+				HandoverInfo.Property = Property;
 
-			ActorInfo->SubobjectInfo.Add(Offset, MakeShared<FClassInfo>(SubobjectInfo));
+				Info->HandoverProperties.Add(HandoverInfo);
+			}
 		}
 	}
+
+	ForAllSchemaComponentTypes([&](ESchemaComponentType Type)
+	{
+		Info->SchemaComponents[Type] = SchemaData.SchemaComponents[Type];
+	});
+
+	if (const FFieldEncodingSchemaData* FieldEncoding = SchemaDatabase->ClassPathToFieldEncoding.Find(Class->GetPathName()))
+	{
+		for (uint32 Handle : FieldEncoding->MultiClientPackedBoolHandles)
+		{
+			Info->PackedBoolHandles.FindOrAdd(SCHEMA_Data).Add(Handle);
+		}
+
+		for (uint32 Handle : FieldEncoding->SingleClientPackedBoolHandles)
+		{
+			Info->PackedBoolHandles.FindOrAdd(SCHEMA_OwnerOnly).Add(Handle);
+		}
+
+		for (auto& QuantizedFloatPair : FieldEncoding->QuantizedFloats)
+		{
+			Info->QuantizedFloats.Add(QuantizedFloatPair.Key, QuantizedFloatPair.Value);
+		}
+	}
+
+	// Subobject class infos hold the RPC metadata and handover data of the class, with no schema components. The actor's info
+	// gets a copy for each of its subobjects, with the components for that subobject filled in.
+	for (auto& SubobjectDataPair : SchemaData.SubobjectData)
+	{
+		const FSubobjectSchemaData& SubobjectSchemaData = SubobjectDataPair.Value;
+
+		UClass* SubobjectClass = LoadClass(FSoftClassPath(SubobjectSchemaData.ClassPath));
+		if (SubobjectClass == nullptr)
+		{
+			continue;
+		}
+
+		FClassInfo* SubobjectInfoPtr = FindClassInfoByClass(SubobjectClass);
+		if (SubobjectInfoPtr == nullptr)
+		{
+			continue;
+		}
+
+		// Make a copy of the already made FClassInfo for this specific subobject
+		TSharedRef<FClassInfo> SubobjectInfo = MakeShared<FClassInfo>(*SubobjectInfoPtr);
+		SubobjectInfo->SubobjectName = SubobjectSchemaData.Name;
+
+		ForAllSchemaComponentTypes([&](ESchemaComponentType Type)
+		{
+			SubobjectInfo->SchemaComponents[Type] = SubobjectSchemaData.SchemaComponents[Type];
+		});
+
+		Info->SubobjectInfo.Add(SubobjectDataPair.Key, SubobjectInfo);
+	}
+
+	Stats.NumClassInfosBuilt++;
+	Stats.ClassInfoBuildSeconds += FPlatformTime::Seconds() - StartTime;
+
+	return Info.Get();
 }
 
 FClassInfo* USpatialTypebindingManager::FindClassInfoByClass(UClass* Class)
 {
-	return ClassInfoMap.Find(Class);
+	if (TSharedRef<FClassInfo>* Info = ClassInfoMap.Find(Class))
+	{
+		return &Info->Get();
+	}
+
+	if (SchemaDatabase == nullptr || Class == nullptr || UnsupportedClasses.Contains(Class))
+	{
+		return nullptr;
+	}
+
+	const FSchemaData* SchemaData = SchemaDatabase->ClassPathToSchema.Find(Class->GetPathName());
+	if (SchemaData == nullptr)
+	{
+		UnsupportedClasses.Add(Class);
+		return nullptr;
+	}
+
+	return &CreateClassInfo(Class, *SchemaData);
 }
 
 FClassInfo* USpatialTypebindingManager::FindClassInfoByActorClassAndOffset(UClass* Class, uint32 Offset)
@@ -207,8 +377,19 @@ FClassInfo* USpatialTypebindingManager::FindClassInfoByActorClassAndOffset(UClas
 
 FClassInfo* USpatialTypebindingManager::FindClassInfoByComponentId(Worker_ComponentId ComponentId)
 {
-	UClass* Class = FindClassByComponentId(ComponentId);
-	return Class != nullptr ? FindClassInfoByClass(Class) : nullptr;
+	FComponentTypeInfo* ComponentInfo = FindComponentTypeInfo(ComponentId);
+	if (ComponentInfo == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (ComponentInfo->ClassInfo == nullptr)
+	{
+		UClass* Class = FindClassByComponentId(ComponentId);
+		ComponentInfo->ClassInfo = Class != nullptr ? FindClassInfoByClass(Class) : nullptr;
+	}
+
+	return ComponentInfo->ClassInfo;
 }
 
 FClassInfo* USpatialTypebindingManager::FindClassInfoByObject(UObject* Object)
@@ -234,20 +415,36 @@ FClassInfo* USpatialTypebindingManager::FindClassInfoByObject(UObject* Object)
 
 UClass* USpatialTypebindingManager::FindClassByComponentId(Worker_ComponentId ComponentId)
 {
-	UClass** Class = ComponentToClassMap.Find(ComponentId);
-	return Class != nullptr ? *Class : nullptr;
+	FComponentTypeInfo* ComponentInfo = FindComponentTypeInfo(ComponentId);
+	if (ComponentInfo == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (ComponentInfo->Class == nullptr)
+	{
+		ComponentInfo->Class = LoadClass(ComponentInfo->ClassPath);
+		if (ComponentInfo->Class == nullptr)
+		{
+			UE_LOG(LogSpatialTypebindingManager, Error, TEXT("Failed to load class %s for component %d."), *ComponentInfo->ClassPath.ToString(), ComponentId);
+			return nullptr;
+		}
+		SupportedClasses.Add(ComponentInfo->Class);
+	}
+
+	return ComponentInfo->Class;
 }
 
 bool USpatialTypebindingManager::IsSupportedClass(UClass* Class)
 {
-	return SupportedClasses.Contains(Class);
+	return FindClassInfoByClass(Class) != nullptr;
 }
 
 bool USpatialTypebindingManager::FindOffsetByComponentId(Worker_ComponentId ComponentId, uint32& OutOffset)
 {
-	if (uint32* Offset = ComponentToOffsetMap.Find(ComponentId))
+	if (const FComponentTypeInfo* ComponentInfo = FindComponentTypeInfo(ComponentId))
 	{
-		OutOffset = *Offset;
+		OutOffset = ComponentInfo->Offset;
 		return true;
 	}
 
@@ -256,10 +453,29 @@ bool USpatialTypebindingManager::FindOffsetByComponentId(Worker_ComponentId Comp
 
 ESchemaComponentType USpatialTypebindingManager::FindCategoryByComponentId(Worker_ComponentId ComponentId)
 {
-	if (ESchemaComponentType* Category = ComponentToCategoryMap.Find(ComponentId))
+	if (const FComponentTypeInfo* ComponentInfo = FindComponentTypeInfo(ComponentId))
 	{
-		return *Category;
+		return ComponentInfo->Category;
 	}
 
 	return ESchemaComponentType::SCHEMA_Invalid;
 }
+
+void USpatialTypebindingManager::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Typebindings: schema database loaded in %.2f ms, %d components mapped in %.2f ms"),
+		Stats.SchemaDatabaseLoadSeconds * 1000.0, NumComponentTypeInfos, Stats.ComponentMapSeconds * 1000.0);
+
+	if (SupportedClassesHandle.IsValid())
+	{
+		Ar.Logf(TEXT("    Asynchronous class load: %d classes requested in %.2f ms, %s"), Stats.NumStartupClasses, Stats.StartupClassLoadSeconds * 1000.0,
+			Stats.bAsyncClassLoadComplete ? *FString::Printf(TEXT("completed after %.2f ms"), Stats.AsyncClassLoadSeconds * 1000.0) : TEXT("in progress"));
+		Ar.Logf(TEXT("    Loaded on demand: %d classes in %.2f ms"), Stats.NumClassesLoadedOnDemand, Stats.OnDemandClassLoadSeconds * 1000.0);
+	}
+	else
+	{
+		Ar.Logf(TEXT("    Startup class load: %d classes in %.2f ms"), Stats.NumStartupClasses, Stats.StartupClassLoadSeconds * 1000.0);
+	}
+
+	Ar.Logf(TEXT("    Class infos: %d built in %.2f ms, %d supported classes loaded"), Stats.NumClassInfosBuilt, Stats.ClassInfoBuildSeconds * 1000.0, SupportedClasses.Num());
+}
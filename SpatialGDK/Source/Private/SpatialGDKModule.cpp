@@ -2,6 +2,8 @@
 
 #include "SpatialGDKModule.h"
 
+#include "SpatialGDKSettings.h"
+
 #define LOCTEXT_NAMESPACE "FSpatialGDKModule"
 
 DEFINE_LOG_CATEGORY(LogSpatialGDKModule);
@@ -10,10 +12,50 @@ IMPLEMENT_MODULE(FSpatialGDKModule, SpatialGDK)
 
 void FSpatialGDKModule::StartupModule()
 {
+	RegisterSettings();
 }
 
 void FSpatialGDKModule::ShutdownModule()
 {
+	if (UObjectInitialized())
+	{
+		UnregisterSettings();
+	}
+}
+
+void FSpatialGDKModule::RegisterSettings()
+{
+#if WITH_EDITOR
+	if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
+	{
+		ISettingsSectionPtr SettingsSection = SettingsModule->RegisterSettings("Project", "SpatialGDK", "Runtime",
+			LOCTEXT("RuntimeSettingsName", "Runtime Settings"),
+			LOCTEXT("RuntimeSettingsDescription", "Runtime configuration for the SpatialOS GDK for Unreal"),
+			GetMutableDefault<USpatialGDKSettings>());
+
+		if (SettingsSection.IsValid())
+		{
+			SettingsSection->OnModified().BindRaw(this, &FSpatialGDKModule::HandleSettingsSaved);
+		}
+	}
+#endif
+}
+
+void FSpatialGDKModule::UnregisterSettings()
+{
+#if WITH_EDITOR
+	if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
+	{
+		SettingsModule->UnregisterSettings("Project", "SpatialGDK", "Runtime");
+	}
+#endif
+}
+
+bool FSpatialGDKModule::HandleSettingsSaved()
+{
+	GetMutableDefault<USpatialGDKSettings>()->SaveConfig();
+
+	return true;
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,96 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "SpatialGDKSettings.h"
+
+#include "GameFramework/Actor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSpatialGDKSettings, Log, All);
+
+USpatialGDKSettings::USpatialGDKSettings(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, bEnableEntityPool(false)
+	, EntityPoolInitialReservationCount(3000)
+	, EntityPoolLowWatermark(1000)
+	, EntityPoolHighWatermark(3000)
+	, bBatchSpawnWaveEntityCreation(false)
+	, MaxEntityCreationsPerTick(100)
+	, RotationEncoding(ERotationEncoding::Full)
+	, bEnableArrayDeltaEncoding(false)
+	, ArrayDeltaMinNumElements(16)
+	, bEnablePushModel(false)
+	, PushModelFullCompareInterval(1.0f)
+	, bUseReplicationScheduler(false)
+	, ReplicationSchedulerResyncInterval(0.5f)
+	, ReplicationSchedulerCellSize(20000.0f)
+	, ReplicationSchedulerRemoteCellFrequencyScale(1.0f)
+	, bEnableParallelPropertyComparison(false)
+	, ParallelPropertyComparisonMaxTasks(0)
+	, ParallelPropertyComparisonMinObjects(64)
+	, bEnableParallelInitialDataSerialization(false)
+	, ParallelInitialDataSerializationMinComponents(4)
+	, MaxReplicationBytesPerTick(0)
+	, bEnableOutgoingByteProfiling(false)
+	, bEnableFieldValueHashing(false)
+	, bCoalesceMulticastRPCs(false)
+	, MaxUnreliableMulticastRPCsPerEntityPerTick(16)
+	, bEnablePayloadCompression(false)
+	, PayloadCompressionThreshold(1024)
+	, MaxUncompressedPayloadSize(1024 * 1024)
+	, bEnableObjectRefPathInterning(false)
+	, MaxInternedObjectRefPaths(65536)
+	, bPreRegisterStablyNamedObjects(false)
+	, StablyNamedObjectRegistrationBudgetMs(0.0f)
+	, bRecycleEntityNetGUIDs(false)
+	, NetGUIDRecycleDelay(5.0f)
+	, bQueueUnreliableRPCs(false)
+	, MaxUnreliableRPCsPerTick(64)
+	, bLoadTypebindingClassesAsync(false)
+{
+}
+
+const FSpatialTransformUpdateSettings& USpatialGDKSettings::GetTransformUpdateSettings(const UClass* ActorClass) const
+{
+	if (ActorClassTransformUpdateSettings.Num() > 0)
+	{
+		for (const UClass* Class = ActorClass; Class != nullptr; Class = Class->GetSuperClass())
+		{
+			if (const FSpatialTransformUpdateSettings* ClassSettings = ActorClassTransformUpdateSettings.Find(TSoftClassPtr<AActor>(Class)))
+			{
+				return *ClassSettings;
+			}
+		}
+	}
+
+	return DefaultTransformUpdateSettings;
+}
+
+const FSpatialUnreliableRPCSettings& USpatialGDKSettings::GetUnreliableRPCSettings(const UFunction* Function) const
+{
+	if (const FSpatialUnreliableRPCSettings* FunctionSettings = FunctionUnreliableRPCSettings.Find(Function->GetFName()))
+	{
+		return *FunctionSettings;
+	}
+
+	return DefaultUnreliableRPCSettings;
+}
+
+#if WITH_EDITOR
+void USpatialGDKSettings::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// The pool refills as soon as it drops below the low watermark, so a low watermark at or above the initial reservation
+	// would refill straight after the first reservation, and a high watermark at or below the low watermark would leave
+	// every refill a single entity ID.
+	const uint32 OldLowWatermark = EntityPoolLowWatermark;
+	const uint32 OldHighWatermark = EntityPoolHighWatermark;
+	EntityPoolLowWatermark = FMath::Min(EntityPoolLowWatermark, FMath::Max(EntityPoolInitialReservationCount, 1u) - 1);
+	EntityPoolHighWatermark = FMath::Max(EntityPoolHighWatermark, EntityPoolLowWatermark + 1);
+
+	if (EntityPoolLowWatermark != OldLowWatermark || EntityPoolHighWatermark != OldHighWatermark)
+	{
+		UE_LOG(LogSpatialGDKSettings, Warning, TEXT("Entity pool watermarks clamped to %u - %u to fit the initial reservation count of %u."),
+			EntityPoolLowWatermark, EntityPoolHighWatermark, EntityPoolInitialReservationCount);
+	}
+}
+#endif
@@ -0,0 +1,177 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Misc/AutomationTest.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Net/RepLayout.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "SpatialGDKSettings.h"
+#include "Utils/ParallelPropertyComparer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+// Actors with their changelist managers, compared the way ServerReplicateActors compares them, without any connections.
+struct FComparisonWorld
+{
+	explicit FComparisonWorld(int32 NumActors)
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		NetDriver = NewObject<USpatialNetDriver>();
+
+		for (int32 i = 0; i < NumActors; i++)
+		{
+			AActor* Actor = World->SpawnActor<AActor>();
+			Actors.Add(Actor);
+			ChangelistMgrs.Add(NetDriver->GetReplicationChangeListMgr(Actor));
+		}
+
+		LastCompareIndices.SetNumZeroed(NumActors);
+	}
+
+	~FComparisonWorld()
+	{
+		World->DestroyWorld(false);
+	}
+
+	void Compare(FParallelPropertyComparer& Comparer, uint32 ReplicationFrame)
+	{
+		FReplicationFlags RepFlags;
+		for (int32 i = 0; i < Actors.Num(); i++)
+		{
+			Comparer.AddObject(Actors[i], *ChangelistMgrs[i], LastCompareIndices[i], RepFlags);
+		}
+		Comparer.Run(ReplicationFrame);
+	}
+
+	int32 GetHistoryEnd(int32 ActorIndex) const
+	{
+		return ChangelistMgrs[ActorIndex]->GetRepChangelistState()->HistoryEnd;
+	}
+
+	UWorld* World;
+	USpatialNetDriver* NetDriver;
+	TArray<AActor*> Actors;
+	TArray<TSharedPtr<FReplicationChangelistMgr>> ChangelistMgrs;
+	TArray<int32> LastCompareIndices;
+};
+
+// Lets every run go wide, however few objects it has.
+struct FScopedParallelComparisonSettings
+{
+	FScopedParallelComparisonSettings()
+		: OldMinObjects(GetDefault<USpatialGDKSettings>()->ParallelPropertyComparisonMinObjects)
+	{
+		GetMutableDefault<USpatialGDKSettings>()->ParallelPropertyComparisonMinObjects = 0;
+	}
+
+	~FScopedParallelComparisonSettings()
+	{
+		GetMutableDefault<USpatialGDKSettings>()->ParallelPropertyComparisonMinObjects = OldMinObjects;
+	}
+
+	uint32 OldMinObjects;
+};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelPropertyComparerChangelistTest, "SpatialGDK.ParallelComparison.ChangelistsMatchChanges", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FParallelPropertyComparerChangelistTest::RunTest(const FString& Parameters)
+{
+	FScopedParallelComparisonSettings ScopedSettings;
+	FComparisonWorld ComparisonWorld(512);
+	FParallelPropertyComparer Comparer;
+
+	uint32 ReplicationFrame = 1;
+	ComparisonWorld.Compare(Comparer, ReplicationFrame);
+
+	TArray<int32> HistoryEnds;
+	for (int32 i = 0; i < ComparisonWorld.Actors.Num(); i++)
+	{
+		HistoryEnds.Add(ComparisonWorld.GetHistoryEnd(i));
+	}
+
+	// Only every other actor changes, so a comparison picked up by the wrong task or object would show up as a mismatch.
+	for (int32 i = 0; i < ComparisonWorld.Actors.Num(); i += 2)
+	{
+		ComparisonWorld.Actors[i]->bCanBeDamaged = !ComparisonWorld.Actors[i]->bCanBeDamaged;
+	}
+
+	ReplicationFrame++;
+	ComparisonWorld.Compare(Comparer, ReplicationFrame);
+
+	int32 NumMismatches = 0;
+	for (int32 i = 0; i < ComparisonWorld.Actors.Num(); i++)
+	{
+		const int32 ExpectedHistoryEnd = HistoryEnds[i] + (i % 2 == 0 ? 1 : 0);
+		if (ComparisonWorld.GetHistoryEnd(i) != ExpectedHistoryEnd)
+		{
+			NumMismatches++;
+		}
+	}
+
+	TestEqual(TEXT("Actors whose changelist doesn't match whether they changed"), NumMismatches, 0);
+	TestTrue(TEXT("Every object was compared in both runs"), Comparer.GetStats().NumObjectsCompared == (uint64)ComparisonWorld.Actors.Num() * 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelPropertyComparerScalingTest, "SpatialGDK.ParallelComparison.Scaling", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FParallelPropertyComparerScalingTest::RunTest(const FString& Parameters)
+{
+	const int32 NumActors = 4096;
+	const int32 NumRuns = 20;
+
+	FScopedParallelComparisonSettings ScopedSettings;
+	FComparisonWorld ComparisonWorld(NumActors);
+	FParallelPropertyComparer Comparer;
+
+	uint32 ReplicationFrame = 1;
+	ComparisonWorld.Compare(Comparer, ReplicationFrame);
+
+	// Doubles the task count up to every task graph worker thread plus the game thread.
+	TArray<int32> TaskCounts;
+	for (int32 NumTasks = 1; NumTasks < Comparer.GetNumTasks(); NumTasks *= 2)
+	{
+		TaskCounts.Add(NumTasks);
+	}
+	TaskCounts.Add(Comparer.GetNumTasks());
+
+	double SingleTaskMsPerRun = 0.0;
+
+	for (int32 NumTasks : TaskCounts)
+	{
+		Comparer.SetMaxTasks(NumTasks);
+		Comparer.ResetStats();
+
+		for (int32 Run = 0; Run < NumRuns; Run++)
+		{
+			// Every actor changes, so every comparison builds a changelist.
+			for (AActor* Actor : ComparisonWorld.Actors)
+			{
+				Actor->bCanBeDamaged = !Actor->bCanBeDamaged;
+			}
+
+			ReplicationFrame++;
+			ComparisonWorld.Compare(Comparer, ReplicationFrame);
+		}
+
+		const FParallelCompareStats& Stats = Comparer.GetStats();
+		const double MsPerRun = FPlatformTime::ToMilliseconds64(Stats.WallCycles) / Stats.NumRuns;
+		if (NumTasks == 1)
+		{
+			SingleTaskMsPerRun = MsPerRun;
+		}
+
+		AddInfo(FString::Printf(TEXT("%d tasks: %.3f ms per run of %d actors, %.2fx faster than one task"),
+			NumTasks, MsPerRun, NumActors, MsPerRun > 0.0 ? SingleTaskMsPerRun / MsPerRun : 0.0));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
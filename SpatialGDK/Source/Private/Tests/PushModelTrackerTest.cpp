@@ -0,0 +1,173 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Misc/AutomationTest.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Net/RepLayout.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "SpatialGDKSettings.h"
+#include "Utils/PushModelTracker.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+const TArray<uint16>& GetLatestChangelist(FReplicationChangelistMgr& ChangelistMgr)
+{
+	const FRepChangelistState* ChangelistState = ChangelistMgr.GetRepChangelistState();
+	return ChangelistState->ChangeHistory[(ChangelistState->HistoryEnd - 1) % FRepChangelistState::MAX_CHANGE_HISTORY].Changed;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPushModelChangelistTest, "SpatialGDK.PushModel.PushedAndPolledChangelistsMatch", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPushModelChangelistTest::RunTest(const FString& Parameters)
+{
+	USpatialGDKSettings* Settings = GetMutableDefault<USpatialGDKSettings>();
+	const bool bWasPushModelEnabled = Settings->bEnablePushModel;
+	const TArray<TSoftClassPtr<AActor>> OldPushModelActorClasses = Settings->PushModelActorClasses;
+	Settings->bEnablePushModel = true;
+	Settings->PushModelActorClasses = { TSoftClassPtr<AActor>(AActor::StaticClass()) };
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	USpatialNetDriver* NetDriver = NewObject<USpatialNetDriver>();
+	AActor* PolledActor = World->SpawnActor<AActor>();
+	AActor* PushedActor = World->SpawnActor<AActor>();
+
+	TSharedPtr<FReplicationChangelistMgr> PolledChangelistMgr = NetDriver->GetReplicationChangeListMgr(PolledActor);
+	TSharedPtr<FReplicationChangelistMgr> PushedChangelistMgr = NetDriver->GetReplicationChangeListMgr(PushedActor);
+
+	FReplicationFlags RepFlags;
+	uint32 ReplicationFrame = 1;
+	PolledChangelistMgr->Update(PolledActor, ReplicationFrame, INDEX_NONE, RepFlags, true);
+	PushedChangelistMgr->Update(PushedActor, ReplicationFrame, INDEX_NONE, RepFlags, true);
+
+	FPushModelTracker Tracker;
+	TestFalse(TEXT("An unmarked object is clean"), Tracker.ConsumeDirtyState(PushedActor));
+
+	PolledActor->bCanBeDamaged = !PolledActor->bCanBeDamaged;
+	PushedActor->bCanBeDamaged = !PushedActor->bCanBeDamaged;
+	Tracker.MarkPropertyDirty(PushedActor, FindFieldChecked<UProperty>(AActor::StaticClass(), GET_MEMBER_NAME_CHECKED(AActor, bCanBeDamaged)));
+
+	ReplicationFrame++;
+	PolledChangelistMgr->Update(PolledActor, ReplicationFrame, INDEX_NONE, RepFlags, false);
+	if (TestTrue(TEXT("A marked object is dirty"), Tracker.ConsumeDirtyState(PushedActor)))
+	{
+		PushedChangelistMgr->Update(PushedActor, ReplicationFrame, INDEX_NONE, RepFlags, false);
+	}
+
+	const TArray<uint16>& PolledChanged = GetLatestChangelist(*PolledChangelistMgr);
+	const TArray<uint16>& PushedChanged = GetLatestChangelist(*PushedChangelistMgr);
+	TestTrue(TEXT("The polled property is in the changelist"), PolledChanged.Num() > 0);
+	TestTrue(TEXT("Pushed and polled properties produce the same changelist"), PolledChanged == PushedChanged);
+	TestFalse(TEXT("Consuming clears the dirty state"), Tracker.ConsumeDirtyState(PushedActor));
+
+	Tracker.MarkObjectDirty(PushedActor);
+	Tracker.PruneObjectsWithoutChannels(NetDriver);
+	TestFalse(TEXT("Objects without an actor channel are pruned"), Tracker.ConsumeDirtyState(PushedActor));
+
+	World->DestroyWorld(false);
+	Settings->bEnablePushModel = bWasPushModelEnabled;
+	Settings->PushModelActorClasses = OldPushModelActorClasses;
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPushModelIdleActorsBenchmark, "SpatialGDK.PushModel.MostlyIdleActors", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FPushModelIdleActorsBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 NumActors = 10000;
+	const int32 NumDirtyActorsPerTick = NumActors / 100;
+	const int32 NumTicks = 50;
+
+	USpatialGDKSettings* Settings = GetMutableDefault<USpatialGDKSettings>();
+	const bool bWasPushModelEnabled = Settings->bEnablePushModel;
+	const TArray<TSoftClassPtr<AActor>> OldPushModelActorClasses = Settings->PushModelActorClasses;
+	Settings->bEnablePushModel = true;
+	Settings->PushModelActorClasses = { TSoftClassPtr<AActor>(AActor::StaticClass()) };
+
+	// Each net driver keeps its own changelist managers, so the same actors can be compared both ways.
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	USpatialNetDriver* PolledNetDriver = NewObject<USpatialNetDriver>();
+	USpatialNetDriver* PushedNetDriver = NewObject<USpatialNetDriver>();
+
+	TArray<AActor*> Actors;
+	TArray<TSharedPtr<FReplicationChangelistMgr>> PolledChangelistMgrs;
+	TArray<TSharedPtr<FReplicationChangelistMgr>> PushedChangelistMgrs;
+	TArray<int32> PolledCompareIndices;
+	TArray<int32> PushedCompareIndices;
+	PolledCompareIndices.SetNumZeroed(NumActors);
+	PushedCompareIndices.SetNumZeroed(NumActors);
+
+	FReplicationFlags RepFlags;
+	uint32 ReplicationFrame = 1;
+
+	for (int32 i = 0; i < NumActors; i++)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		Actors.Add(Actor);
+		PolledChangelistMgrs.Add(PolledNetDriver->GetReplicationChangeListMgr(Actor));
+		PushedChangelistMgrs.Add(PushedNetDriver->GetReplicationChangeListMgr(Actor));
+
+		PolledChangelistMgrs[i]->Update(Actor, ReplicationFrame, PolledCompareIndices[i], RepFlags, true);
+		PushedChangelistMgrs[i]->Update(Actor, ReplicationFrame, PushedCompareIndices[i], RepFlags, true);
+	}
+
+	FPushModelTracker Tracker;
+	uint64 PolledCycles = 0;
+	uint64 PushedCycles = 0;
+	int32 NumPolledChanges = 0;
+	int32 NumPushedChanges = 0;
+
+	for (int32 Tick = 0; Tick < NumTicks; Tick++)
+	{
+		for (int32 i = 0; i < NumDirtyActorsPerTick; i++)
+		{
+			AActor* Actor = Actors[(Tick * NumDirtyActorsPerTick + i) % NumActors];
+			Actor->bCanBeDamaged = !Actor->bCanBeDamaged;
+			Tracker.MarkObjectDirty(Actor);
+		}
+
+		ReplicationFrame++;
+
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 i = 0; i < NumActors; i++)
+		{
+			const int32 OldHistoryEnd = PolledChangelistMgrs[i]->GetRepChangelistState()->HistoryEnd;
+			PolledChangelistMgrs[i]->Update(Actors[i], ReplicationFrame, PolledCompareIndices[i], RepFlags, false);
+			NumPolledChanges += PolledChangelistMgrs[i]->GetRepChangelistState()->HistoryEnd - OldHistoryEnd;
+		}
+		PolledCycles += FPlatformTime::Cycles64() - StartCycles;
+
+		StartCycles = FPlatformTime::Cycles64();
+		for (int32 i = 0; i < NumActors; i++)
+		{
+			if (Tracker.ConsumeDirtyState(Actors[i]))
+			{
+				const int32 OldHistoryEnd = PushedChangelistMgrs[i]->GetRepChangelistState()->HistoryEnd;
+				PushedChangelistMgrs[i]->Update(Actors[i], ReplicationFrame, PushedCompareIndices[i], RepFlags, false);
+				NumPushedChanges += PushedChangelistMgrs[i]->GetRepChangelistState()->HistoryEnd - OldHistoryEnd;
+			}
+		}
+		PushedCycles += FPlatformTime::Cycles64() - StartCycles;
+	}
+
+	TestEqual(TEXT("Pushed and polled comparisons find the same changes"), NumPushedChanges, NumPolledChanges);
+	TestEqual(TEXT("Changes found"), NumPolledChanges, NumDirtyActorsPerTick * NumTicks);
+
+	const double PolledMsPerTick = FPlatformTime::ToMilliseconds64(PolledCycles) / NumTicks;
+	const double PushedMsPerTick = FPlatformTime::ToMilliseconds64(PushedCycles) / NumTicks;
+	AddInfo(FString::Printf(TEXT("%d actors, %d dirty per tick: polled %.3f ms per tick, push model %.3f ms per tick (%.1fx faster)"),
+		NumActors, NumDirtyActorsPerTick, PolledMsPerTick, PushedMsPerTick, PushedMsPerTick > 0.0 ? PolledMsPerTick / PushedMsPerTick : 0.0));
+
+	World->DestroyWorld(false);
+	Settings->bEnablePushModel = bWasPushModelEnabled;
+	Settings->PushModelActorClasses = OldPushModelActorClasses;
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,81 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Misc/AutomationTest.h"
+
+#include "Schema/Rotation.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+const FRotator TestRotators[] = {
+	FRotator::ZeroRotator,
+	FRotator(10.0f, 20.0f, 30.0f),
+	FRotator(-45.5f, 179.9f, -90.0f),
+	FRotator(89.0f, -135.25f, 0.01f),
+	FRotator(-0.3f, 359.0f, 180.0f),
+};
+
+// Round trips a rotation through a component update written with the encoding, and returns the written field size.
+FRotator EncodingRoundTrip(const FRotator& Rotator, ERotationEncoding Encoding, uint32& OutFieldBytes)
+{
+	Worker_ComponentUpdate Update = improbable::Rotation(Rotator).CreateRotationUpdate(Encoding);
+	OutFieldBytes = Schema_GetWriteBufferLength(Schema_GetComponentUpdateFields(Update.schema_type));
+
+	improbable::Rotation Decoded(0.0f, 0.0f, 0.0f);
+	Decoded.ApplyComponentUpdate(Update);
+
+	Schema_DestroyComponentUpdate(Update.schema_type);
+	return Decoded.ToFRotator();
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRotationEncodingRoundTripTest, "SpatialGDK.Schema.RotationEncodingRoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRotationEncodingRoundTripTest::RunTest(const FString& Parameters)
+{
+	// Half a step of each encoding: 360 / 2^16 degrees per axis, and 10 bits per quaternion component, which stays well below a quarter degree.
+	const float Quantized16Tolerance = 360.0f / 65536.0f / 2.0f + KINDA_SMALL_NUMBER;
+	const float SmallestThreeToleranceRadians = FMath::DegreesToRadians(0.25f);
+
+	uint32 TotalFullBytes = 0;
+	uint32 TotalQuantized16Bytes = 0;
+	uint32 TotalSmallestThreeBytes = 0;
+
+	for (const FRotator& Rotator : TestRotators)
+	{
+		uint32 FullBytes = 0;
+		const FRotator Full = EncodingRoundTrip(Rotator, ERotationEncoding::Full, FullBytes);
+		TestTrue(FString::Printf(TEXT("Full: %s is exact"), *Rotator.ToString()), Full.Equals(Rotator, 0.0f));
+		TestEqual(FString::Printf(TEXT("Full: %s encoded size"), *Rotator.ToString()), FullBytes, improbable::Rotation::GetEncodedSize(ERotationEncoding::Full, Rotator));
+
+		uint32 Quantized16Bytes = 0;
+		const FRotator Quantized16 = EncodingRoundTrip(Rotator, ERotationEncoding::Quantized16, Quantized16Bytes);
+		TestTrue(FString::Printf(TEXT("Quantized16: %s round trips to %s"), *Rotator.ToString(), *Quantized16.ToString()), Quantized16.Equals(Rotator, Quantized16Tolerance));
+		TestEqual(FString::Printf(TEXT("Quantized16: %s encoded size"), *Rotator.ToString()), Quantized16Bytes, improbable::Rotation::GetEncodedSize(ERotationEncoding::Quantized16, Rotator));
+
+		uint32 SmallestThreeBytes = 0;
+		const FRotator SmallestThree = EncodingRoundTrip(Rotator, ERotationEncoding::SmallestThree, SmallestThreeBytes);
+		TestTrue(FString::Printf(TEXT("SmallestThree: %s round trips to %s"), *Rotator.ToString(), *SmallestThree.ToString()),
+			Rotator.Quaternion().AngularDistance(SmallestThree.Quaternion()) <= SmallestThreeToleranceRadians);
+		TestEqual(FString::Printf(TEXT("SmallestThree: %s encoded size"), *Rotator.ToString()), SmallestThreeBytes, improbable::Rotation::GetEncodedSize(ERotationEncoding::SmallestThree, Rotator));
+
+		// The compact encodings are only worth their precision loss if they are smaller than three floats.
+		TestTrue(FString::Printf(TEXT("Quantized16: %s is smaller than Full"), *Rotator.ToString()), Quantized16Bytes < FullBytes);
+		TestTrue(FString::Printf(TEXT("SmallestThree: %s is smaller than Full"), *Rotator.ToString()), SmallestThreeBytes < FullBytes);
+
+		AddInfo(FString::Printf(TEXT("%s: Full %u bytes, Quantized16 %u bytes, SmallestThree %u bytes"), *Rotator.ToString(), FullBytes, Quantized16Bytes, SmallestThreeBytes));
+
+		TotalFullBytes += FullBytes;
+		TotalQuantized16Bytes += Quantized16Bytes;
+		TotalSmallestThreeBytes += SmallestThreeBytes;
+	}
+
+	AddInfo(FString::Printf(TEXT("Total for %d rotations: Full %u bytes, Quantized16 %u bytes (%.0f%%), SmallestThree %u bytes (%.0f%%)"),
+		(int32)ARRAY_COUNT(TestRotators), TotalFullBytes, TotalQuantized16Bytes, 100.0f * TotalQuantized16Bytes / TotalFullBytes,
+		TotalSmallestThreeBytes, 100.0f * TotalSmallestThreeBytes / TotalFullBytes));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
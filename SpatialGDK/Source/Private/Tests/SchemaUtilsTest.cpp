@@ -0,0 +1,96 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Misc/AutomationTest.h"
+
+#include "Utils/SchemaUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+const Schema_FieldId TEST_FIELD_ID = 1;
+
+float QuantizeRoundTrip(float Value, const FQuantizedFloatSchemaData& Quantization)
+{
+	Schema_ComponentData* ComponentData = Schema_CreateComponentData(1);
+	Schema_Object* Object = Schema_GetComponentDataFields(ComponentData);
+
+	improbable::AddQuantizedFloatToSchema(Object, TEST_FIELD_ID, Value, Quantization);
+	const float Result = improbable::IndexQuantizedFloatFromSchema(Object, TEST_FIELD_ID, 0, Quantization);
+
+	Schema_DestroyComponentData(ComponentData);
+	return Result;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQuantizedFloatRoundTripTest, "SpatialGDK.SchemaUtils.QuantizedFloatRoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FQuantizedFloatRoundTripTest::RunTest(const FString& Parameters)
+{
+	FQuantizedFloatSchemaData Quantization;
+	Quantization.Min = -100.0f;
+	Quantization.Max = 100.0f;
+
+	for (uint32 NumBits : { 1u, 8u, 16u, 24u, 32u })
+	{
+		Quantization.NumBits = NumBits;
+		const float MaxError = (Quantization.Max - Quantization.Min) / improbable::GetMaxQuantizedValue(Quantization) / 2.0f + KINDA_SMALL_NUMBER;
+
+		for (float Value : { -100.0f, -37.5f, 0.0f, 0.1f, 12.345f, 99.99f, 100.0f })
+		{
+			const float Result = QuantizeRoundTrip(Value, Quantization);
+			TestTrue(FString::Printf(TEXT("%u bits: %f round trips to %f"), NumBits, Value, Result), FMath::Abs(Result - Value) <= MaxError);
+		}
+
+		TestEqual(FString::Printf(TEXT("%u bits: Min is exact"), NumBits), QuantizeRoundTrip(Quantization.Min, Quantization), Quantization.Min);
+		TestEqual(FString::Printf(TEXT("%u bits: Max is exact"), NumBits), QuantizeRoundTrip(Quantization.Max, Quantization), Quantization.Max);
+		TestEqual(FString::Printf(TEXT("%u bits: values below Min are clamped"), NumBits), QuantizeRoundTrip(-1000.0f, Quantization), Quantization.Min);
+		TestEqual(FString::Printf(TEXT("%u bits: values above Max are clamped"), NumBits), QuantizeRoundTrip(1000.0f, Quantization), Quantization.Max);
+		TestEqual(FString::Printf(TEXT("%u bits: NaN is written as Min"), NumBits), QuantizeRoundTrip(NAN, Quantization), Quantization.Min);
+	}
+
+	FQuantizedFloatSchemaData EmptyRange;
+	EmptyRange.Min = 5.0f;
+	EmptyRange.Max = 5.0f;
+	EmptyRange.NumBits = 8;
+	TestEqual(TEXT("An empty range is written as Min"), QuantizeRoundTrip(1.0f, EmptyRange), EmptyRange.Min);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPackedBoolsRoundTripTest, "SpatialGDK.SchemaUtils.PackedBoolsRoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPackedBoolsRoundTripTest::RunTest(const FString& Parameters)
+{
+	// Sizes on either side of a byte boundary.
+	for (int32 NumBools : { 1, 4, 7, 8, 9, 16, 17 })
+	{
+		TBitArray<> Values(false, NumBools);
+		TBitArray<> ChangedMask(false, NumBools);
+		for (int32 BitIndex = 0; BitIndex < NumBools; BitIndex++)
+		{
+			Values[BitIndex] = BitIndex % 3 == 0;
+			ChangedMask[BitIndex] = BitIndex % 2 == 1;
+		}
+
+		Schema_ComponentData* ComponentData = Schema_CreateComponentData(1);
+		Schema_Object* Object = Schema_GetComponentDataFields(ComponentData);
+		improbable::AddPackedBoolsToSchema(Object, TEST_FIELD_ID, Values, ChangedMask);
+
+		TBitArray<> ReadValues;
+		TBitArray<> ReadChangedMask;
+		if (TestTrue(FString::Printf(TEXT("%d bools: field is read back"), NumBools), improbable::GetPackedBoolsFromSchema(Object, TEST_FIELD_ID, NumBools, ReadValues, ReadChangedMask)))
+		{
+			TestTrue(FString::Printf(TEXT("%d bools: values match"), NumBools), ReadValues == Values);
+			TestTrue(FString::Printf(TEXT("%d bools: changed mask matches"), NumBools), ReadChangedMask == ChangedMask);
+		}
+
+		TestFalse(FString::Printf(TEXT("%d bools: a different bool count is rejected"), NumBools), improbable::GetPackedBoolsFromSchema(Object, TEST_FIELD_ID, NumBools + 8, ReadValues, ReadChangedMask));
+
+		Schema_DestroyComponentData(ComponentData);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,131 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Misc/AutomationTest.h"
+
+#include "UObject/Package.h"
+
+#include "Utils/UnresolvedReferenceTable.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+const int32 NUM_PENDING_PROPERTIES = 100000;
+const int32 NUM_OWNERS = 4;
+const int32 NUM_UNRESOLVED_OBJECTS = 1000;
+
+// Handles are 16 bit, so the pending properties are spread over several owning objects.
+const int32 PROPERTIES_PER_OWNER = NUM_PENDING_PROPERTIES / NUM_OWNERS;
+
+// Every property references two unresolved objects, which are the same object for some properties.
+int32 GetFirstReference(int32 PropertyIndex)
+{
+	return PropertyIndex % NUM_UNRESOLVED_OBJECTS;
+}
+
+int32 GetSecondReference(int32 PropertyIndex)
+{
+	return (PropertyIndex * 7 + 3) % NUM_UNRESOLVED_OBJECTS;
+}
+
+// Every tenth property is sent again with a new value before its references resolve.
+bool IsRemovedBeforeResolving(int32 PropertyIndex)
+{
+	return PropertyIndex % 10 == 0;
+}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnresolvedReferenceTableStressTest, "SpatialGDK.UnresolvedReferences.HundredThousandPendingProperties", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUnresolvedReferenceTableStressTest::RunTest(const FString& Parameters)
+{
+	TArray<UObject*> Owners;
+	TMap<const UObject*, int32> OwnerToIndex;
+	for (int32 i = 0; i < NUM_OWNERS; i++)
+	{
+		Owners.Add(NewObject<UObject>(GetTransientPackage()));
+		OwnerToIndex.Add(Owners[i], i);
+	}
+
+	TArray<UObject*> UnresolvedObjects;
+	for (int32 i = 0; i < NUM_UNRESOLVED_OBJECTS; i++)
+	{
+		UnresolvedObjects.Add(NewObject<UObject>(GetTransientPackage()));
+	}
+
+	// Objects are resolved in order, so a property is ready once the later of its two references resolves.
+	TArray<int32> ExpectedReadyPerObject;
+	ExpectedReadyPerObject.SetNumZeroed(NUM_UNRESOLVED_OBJECTS);
+
+	FUnresolvedReferenceTable Table;
+
+	const uint64 AddStartCycles = FPlatformTime::Cycles64();
+
+	for (int32 PropertyIndex = 0; PropertyIndex < NUM_PENDING_PROPERTIES; PropertyIndex++)
+	{
+		const FChannelObjectPair ChannelObjectPair(nullptr, Owners[PropertyIndex / PROPERTIES_PER_OWNER]);
+		const uint16 Handle = (uint16)(PropertyIndex % PROPERTIES_PER_OWNER + 1);
+
+		TSet<const UObject*> References;
+		References.Add(UnresolvedObjects[GetFirstReference(PropertyIndex)]);
+		References.Add(UnresolvedObjects[GetSecondReference(PropertyIndex)]);
+
+		Table.Add(ChannelObjectPair, Handle, false, References);
+
+		if (IsRemovedBeforeResolving(PropertyIndex))
+		{
+			Table.Remove(ChannelObjectPair, Handle);
+		}
+		else
+		{
+			ExpectedReadyPerObject[FMath::Max(GetFirstReference(PropertyIndex), GetSecondReference(PropertyIndex))]++;
+		}
+	}
+
+	const uint64 AddCycles = FPlatformTime::Cycles64() - AddStartCycles;
+
+	TestEqual(TEXT("Pending properties after queueing"), Table.GetNumPendingProperties(), NUM_PENDING_PROPERTIES - NUM_PENDING_PROPERTIES / 10);
+	TestEqual(TEXT("Unresolved objects after queueing"), Table.GetNumUnresolvedObjects(), NUM_UNRESOLVED_OBJECTS);
+
+	TArray<FPendingOutgoingProperty> ReadyProperties;
+	int32 NumReady = 0;
+	int32 NumWrongReady = 0;
+
+	const uint64 ResolveStartCycles = FPlatformTime::Cycles64();
+
+	for (int32 ObjectIndex = 0; ObjectIndex < NUM_UNRESOLVED_OBJECTS; ObjectIndex++)
+	{
+		ReadyProperties.Reset();
+		Table.Resolve(UnresolvedObjects[ObjectIndex], ReadyProperties);
+
+		if (ReadyProperties.Num() != ExpectedReadyPerObject[ObjectIndex])
+		{
+			AddError(FString::Printf(TEXT("Resolving object %d made %d properties ready, expected %d"), ObjectIndex, ReadyProperties.Num(), ExpectedReadyPerObject[ObjectIndex]));
+		}
+
+		for (const FPendingOutgoingProperty& Property : ReadyProperties)
+		{
+			const int32 PropertyIndex = OwnerToIndex.FindChecked(Property.ChannelObjectPair.Value.Get()) * PROPERTIES_PER_OWNER + Property.Handle - 1;
+			if (IsRemovedBeforeResolving(PropertyIndex) || FMath::Max(GetFirstReference(PropertyIndex), GetSecondReference(PropertyIndex)) != ObjectIndex)
+			{
+				NumWrongReady++;
+			}
+		}
+
+		NumReady += ReadyProperties.Num();
+	}
+
+	const uint64 ResolveCycles = FPlatformTime::Cycles64() - ResolveStartCycles;
+
+	TestEqual(TEXT("Properties made ready by a resolve they weren't waiting on"), NumWrongReady, 0);
+	TestEqual(TEXT("Properties made ready"), NumReady, NUM_PENDING_PROPERTIES - NUM_PENDING_PROPERTIES / 10);
+	TestEqual(TEXT("Pending properties after resolving"), Table.GetNumPendingProperties(), 0);
+	TestEqual(TEXT("Unresolved objects after resolving"), Table.GetNumUnresolvedObjects(), 0);
+
+	AddInfo(FString::Printf(TEXT("Queued %d properties in %.3f ms, resolved %d objects in %.3f ms"),
+		NUM_PENDING_PROPERTIES, FPlatformTime::ToMilliseconds64(AddCycles), NUM_UNRESOLVED_OBJECTS, FPlatformTime::ToMilliseconds64(ResolveCycles)));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
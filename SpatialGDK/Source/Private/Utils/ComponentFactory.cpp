@@ -2,7 +2,9 @@
 
 #include "Utils/ComponentFactory.h"
 
+#include "Async/ParallelFor.h"
 #include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/NetSerialization.h"
 #include "Engine/World.h"
 #include "UObject/TextProperty.h"
 
@@ -10,8 +12,49 @@
 #include "EngineClasses/SpatialNetBitWriter.h"
 #include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
+#include "Interop/ObjectRefPathDictionary.h"
+#include "Interop/SpatialSender.h"
 #include "SpatialConstants.h"
+#include "SpatialGDKSettings.h"
 #include "Utils/RepLayoutUtils.h"
+#include "Utils/SchemaUtils.h"
+
+namespace
+{
+
+// Holds the lock for its lifetime, if there is one.
+class FOptionalScopeLock
+{
+public:
+	explicit FOptionalScopeLock(FCriticalSection* InCriticalSection)
+		: CriticalSection(InCriticalSection)
+	{
+		if (CriticalSection != nullptr)
+		{
+			CriticalSection->Lock();
+		}
+	}
+
+	~FOptionalScopeLock()
+	{
+		if (CriticalSection != nullptr)
+		{
+			CriticalSection->Unlock();
+		}
+	}
+
+private:
+	FCriticalSection* CriticalSection;
+};
+
+// Components of server only actors and their subobjects are never sent to clients.
+bool IsServerOnlyObject(UObject* Object)
+{
+	const AActor* Actor = Object->IsA<AActor>() ? Cast<AActor>(Object) : Object->GetTypedOuter<AActor>();
+	return Actor != nullptr && Actor->GetClass()->HasAnySpatialClassFlags(SPATIALCLASS_ServerOnly);
+}
+
+}
 
 namespace improbable
 {
@@ -24,10 +67,19 @@ ComponentFactory::ComponentFactory(FUnresolvedObjectsMap& RepUnresolvedObjectsMa
 	, PendingHandoverUnresolvedObjectsMap(HandoverUnresolvedObjectsMap)
 { }
 
-bool ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds /*= nullptr*/)
+bool ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, FClassInfo* Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool bIsInitialData, FArrayDeltaStates* ArrayDeltaStates, FFieldValueHashes* FieldValueHashes, TArray<Schema_FieldId>* ClearedIds /*= nullptr*/)
 {
 	bool bWroteSomething = false;
 
+	TGuardValue<UObjectRefPathDictionary*> PathDictionaryGuard(PathDictionary, IsServerOnlyObject(Object) ? NetDriver->ObjectRefPathDictionary : nullptr);
+
+	FOutgoingByteProfiler* Profiler = NetDriver->OutgoingByteProfiler.IsEnabled() ? &NetDriver->OutgoingByteProfiler : nullptr;
+
+	// Changed bools that are packed into one field are only marked here, and the field is written after the other properties.
+	const TArray<uint16>* PackedBoolHandles = Info->PackedBoolHandles.Find(PropertyGroup);
+	TBitArray<> ChangedPackedBools(false, PackedBoolHandles != nullptr ? PackedBoolHandles->Num() : 0);
+	bool bHasChangedPackedBools = false;
+
 	// Populate the replicated data component updates from the replicated property changelist.
 	if (Changes.RepChanged.Num() > 0)
 	{
@@ -42,8 +94,86 @@ bool ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject*
 			{
 				const uint8* Data = (uint8*)Object + Cmd.Offset;
 				TSet<const UObject*> UnresolvedObjects;
+				Schema_FieldId FieldId = HandleIterator.Handle;
+
+				// Arrays are never hashed, so skipping the rest of the loop body can't miss jumping over one.
+				uint64 ValueHash = 0;
+				const bool bHasValueHash = FieldValueHashes != nullptr && Cmd.Type != ERepLayoutCmdType::DynamicArray && GetFieldValueHash(Cmd.Property, Data, ValueHash);
+				if (bHasValueHash && !bIsInitialData && IsFieldValueUnchanged(FieldValueHashes->RepHashes, HandleIterator.Handle, Cmd.Property, ValueHash))
+				{
+					continue;
+				}
+
+				const int32 PackedBoolIndex = PackedBoolHandles != nullptr ? PackedBoolHandles->IndexOfByKey(HandleIterator.Handle) : INDEX_NONE;
+				if (PackedBoolIndex != INDEX_NONE)
+				{
+					ChangedPackedBools[PackedBoolIndex] = true;
+					bHasChangedPackedBools = true;
+
+					if (bHasValueHash)
+					{
+						FieldValueHashes->RepHashes.Add(HandleIterator.Handle, ValueHash);
+					}
+					continue;
+				}
+
+				// The schema object can't report the size of a single field, so measure how much writing the property grew it by.
+				const uint32 SizeBeforeProperty = Profiler != nullptr ? Schema_GetWriteBufferLength(ComponentObject) : 0;
 
-				AddProperty(ComponentObject, HandleIterator.Handle, Cmd.Property, Data, UnresolvedObjects, ClearedIds);
+				FArrayDeltaState* ArrayDeltaState = nullptr;
+				if (ArrayDeltaStates != nullptr && Cmd.Type == ERepLayoutCmdType::DynamicArray && CanUseArrayDelta(Changes.RepLayout, HandleIterator.CmdIndex))
+				{
+					ArrayDeltaState = &ArrayDeltaStates->FindOrAdd(HandleIterator.Handle);
+				}
+
+				bool bWroteFastArrayItemIds = false;
+
+				const FQuantizedFloatSchemaData* Quantization = Info->QuantizedFloats.Find(HandleIterator.Handle);
+
+				if (Quantization != nullptr)
+				{
+					AddQuantizedProperty(ComponentObject, FieldId, Cmd.Property, Data, *Quantization);
+				}
+				else if (ArrayDeltaState != nullptr && !bIsInitialData && AddArrayDelta(ComponentObject, Changes, HandleIterator, Data, *ArrayDeltaState, UnresolvedObjects))
+				{
+					FieldId = HandleIterator.Handle + SpatialConstants::ARRAY_DELTA_FIELD_ID_OFFSET;
+				}
+				else
+				{
+					AddProperty(ComponentObject, FieldId, Cmd.Property, Data, UnresolvedObjects, ClearedIds);
+					const uint32 SizeAfterProperty = Profiler != nullptr ? Schema_GetWriteBufferLength(ComponentObject) : 0;
+
+					if (ArrayDeltaState != nullptr)
+					{
+						const int32 ArrayNum = FScriptArrayHelper(Cast<UArrayProperty>(Cmd.Property), Data).Num();
+
+						if (ArrayDeltaState->bHasSentDelta && ClearedIds != nullptr)
+						{
+							// The last delta doesn't apply on top of the new full array, so clear it.
+							ClearedIds->Add(HandleIterator.Handle + SpatialConstants::ARRAY_DELTA_FIELD_ID_OFFSET);
+						}
+
+						ArrayDeltaState->DirtyIndices.Init(false, ArrayNum);
+						ArrayDeltaState->MinNumSinceFullSend = ArrayNum;
+						ArrayDeltaState->bHasSentDelta = false;
+						ArrayDeltaState->bNeedsFullSend = !bIsInitialData && UnresolvedObjects.Num() > 0;
+
+						if (IsFastArrayItems(Changes.RepLayout, HandleIterator.CmdIndex))
+						{
+							AddFastArrayItemIds(ComponentObject, HandleIterator.Handle, Cast<UArrayProperty>(Cmd.Property), Data, *ArrayDeltaState, ClearedIds);
+							bWroteFastArrayItemIds = true;
+						}
+
+						if (!bIsInitialData)
+						{
+							NetDriver->Sender->RecordArrayReplication(Cmd.Property, /* bWasDelta */ false);
+							if (Profiler != nullptr)
+							{
+								NetDriver->Sender->RecordArrayBytes(Cmd.Property, SizeAfterProperty - SizeBeforeProperty, SizeAfterProperty - SizeBeforeProperty);
+							}
+						}
+					}
+				}
 
 				if (UnresolvedObjects.Num() == 0)
 				{
@@ -55,11 +185,26 @@ bool ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject*
 					{
 						// Don't send updates for fields with unresolved objects, unless it's the initial data,
 						// in which case all fields should be populated.
-						Schema_ClearField(ComponentObject, HandleIterator.Handle);
+						Schema_ClearField(ComponentObject, FieldId);
+
+						if (bWroteFastArrayItemIds)
+						{
+							Schema_ClearField(ComponentObject, HandleIterator.Handle + SpatialConstants::FAST_ARRAY_ITEM_IDS_FIELD_ID_OFFSET);
+						}
 					}
 
 					PendingRepUnresolvedObjectsMap.Add(HandleIterator.Handle, UnresolvedObjects);
 				}
+
+				if (bHasValueHash && UnresolvedObjects.Num() == 0)
+				{
+					FieldValueHashes->RepHashes.Add(HandleIterator.Handle, ValueHash);
+				}
+
+				if (Profiler != nullptr && (UnresolvedObjects.Num() == 0 || bIsInitialData))
+				{
+					Profiler->RecordProperty(Object->GetClass(), HandleIterator.Handle, Parent.Property, Cmd.Property, Schema_GetWriteBufferLength(ComponentObject) - SizeBeforeProperty);
+				}
 			}
 
 			if (Cmd.Type == ERepLayoutCmdType::DynamicArray)
@@ -72,13 +217,28 @@ bool ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject*
 		}
 	}
 
+	// Initial data always has the field, so entities checked out later get every bool.
+	if (PackedBoolHandles != nullptr && (bIsInitialData || bHasChangedPackedBools))
+	{
+		if (bIsInitialData)
+		{
+			ChangedPackedBools.Init(true, PackedBoolHandles->Num());
+		}
+
+		AddPackedBools(ComponentObject, Object, Changes.RepLayout, *PackedBoolHandles, ChangedPackedBools);
+		bWroteSomething = true;
+	}
+
 	return bWroteSomething;
 }
 
-bool ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds /* = nullptr */)
+bool ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes, bool bIsInitialData, FFieldValueHashes* FieldValueHashes, TArray<Schema_FieldId>* ClearedIds /* = nullptr */)
 {
 	bool bWroteSomething = false;
 
+	// Handover components are only read by servers.
+	TGuardValue<UObjectRefPathDictionary*> PathDictionaryGuard(PathDictionary, NetDriver->ObjectRefPathDictionary);
+
 	for (uint16 ChangedHandle : Changes)
 	{
 		check(ChangedHandle > 0 && ChangedHandle - 1 < Info->HandoverProperties.Num());
@@ -87,6 +247,13 @@ bool ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject,
 		const uint8* Data = (uint8*)Object + PropertyInfo.Offset;
 		TSet<const UObject*> UnresolvedObjects;
 
+		uint64 ValueHash = 0;
+		const bool bHasValueHash = FieldValueHashes != nullptr && GetFieldValueHash(PropertyInfo.Property, Data, ValueHash);
+		if (bHasValueHash && !bIsInitialData && IsFieldValueUnchanged(FieldValueHashes->HandoverHashes, ChangedHandle, PropertyInfo.Property, ValueHash))
+		{
+			continue;
+		}
+
 		AddProperty(ComponentObject, ChangedHandle, PropertyInfo.Property, Data, UnresolvedObjects, ClearedIds);
 
 		if (UnresolvedObjects.Num() == 0)
@@ -104,35 +271,82 @@ bool ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject,
 
 			PendingHandoverUnresolvedObjectsMap.Add(ChangedHandle, UnresolvedObjects);
 		}
+
+		if (bHasValueHash && UnresolvedObjects.Num() == 0)
+		{
+			FieldValueHashes->HandoverHashes.Add(ChangedHandle, ValueHash);
+		}
 	}
 
 	return bWroteSomething;
 }
 
+bool ComponentFactory::GetFieldValueHash(UProperty* Property, const uint8* Data, uint64& OutHash)
+{
+	if (UBoolProperty* BoolProperty = Cast<UBoolProperty>(Property))
+	{
+		// Bitfield bools share their byte with other properties, so read the value rather than the memory.
+		OutHash = BoolProperty->GetPropertyValue(Data) ? 1 : 0;
+		return true;
+	}
+
+	if ((Property->IsA<UNumericProperty>() || Property->IsA<UEnumProperty>()) && Property->ElementSize <= sizeof(uint64))
+	{
+		OutHash = 0;
+		FMemory::Memcpy(&OutHash, Data, Property->ElementSize);
+		return true;
+	}
+
+	if (UNameProperty* NameProperty = Cast<UNameProperty>(Property))
+	{
+		const FName& Name = NameProperty->GetPropertyValue(Data);
+		OutHash = ((uint64)(uint32)Name.GetComparisonIndex() << 32) | (uint32)Name.GetNumber();
+		return true;
+	}
+
+	return false;
+}
+
+bool ComponentFactory::IsFieldValueUnchanged(TMap<uint16, uint64>& LastSentHashes, uint16 Handle, UProperty* Property, uint64 ValueHash)
+{
+	const uint64* LastSentHash = LastSentHashes.Find(Handle);
+	const bool bUnchanged = LastSentHash != nullptr && *LastSentHash == ValueHash;
+
+	// Per-property counts cost a map lookup per field, so they're only kept while outgoing bytes are being profiled.
+	NetDriver->Sender->RecordFieldValueHashCheck(NetDriver->OutgoingByteProfiler.IsEnabled() ? Property : nullptr, bUnchanged);
+
+	return bUnchanged;
+}
+
 void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, const uint8* Data, TSet<const UObject*>& UnresolvedObjects, TArray<Schema_FieldId>* ClearedIds)
 {
 	if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
 	{
 		UScriptStruct* Struct = StructProperty->Struct;
-		FSpatialNetBitWriter ValueDataWriter(PackageMap, UnresolvedObjects);
+		FSpatialNetBitWriter ValueDataWriter(PackageMap, UnresolvedObjects, PathDictionary);
 		bool bHasUnmapped = false;
 
-		if (Struct->StructFlags & STRUCT_NetSerializeNative)
 		{
-			UScriptStruct::ICppStructOps* CppStructOps = Struct->GetCppStructOps();
-			check(CppStructOps); // else should not have STRUCT_NetSerializeNative
-			bool bSuccess = true;
-			if (!CppStructOps->NetSerialize(ValueDataWriter, PackageMap, bSuccess, const_cast<uint8*>(Data)))
+			// Compression in AddPayloadToSchema can run on several threads, so only hold the lock while serializing.
+			FOptionalScopeLock Lock(SerializationLock);
+
+			if (Struct->StructFlags & STRUCT_NetSerializeNative)
 			{
-				bHasUnmapped = true;
+				UScriptStruct::ICppStructOps* CppStructOps = Struct->GetCppStructOps();
+				check(CppStructOps); // else should not have STRUCT_NetSerializeNative
+				bool bSuccess = true;
+				if (!CppStructOps->NetSerialize(ValueDataWriter, PackageMap, bSuccess, const_cast<uint8*>(Data)))
+				{
+					bHasUnmapped = true;
+				}
+				checkf(bSuccess, TEXT("NetSerialize on %s failed."), *Struct->GetStructCPPName());
 			}
-			checkf(bSuccess, TEXT("NetSerialize on %s failed."), *Struct->GetStructCPPName());
-		}
-		else
-		{
-			TSharedPtr<FRepLayout> RepLayout = NetDriver->GetStructRepLayout(Struct);
+			else
+			{
+				TSharedPtr<FRepLayout> RepLayout = NetDriver->GetStructRepLayout(Struct);
 
-			RepLayout_SerializePropertiesForStruct(*RepLayout, ValueDataWriter, PackageMap, const_cast<uint8*>(Data), bHasUnmapped);
+				RepLayout_SerializePropertiesForStruct(*RepLayout, ValueDataWriter, PackageMap, const_cast<uint8*>(Data), bHasUnmapped);
+			}
 		}
 
 		AddPayloadToSchema(Object, FieldId, ValueDataWriter);
@@ -188,6 +402,8 @@ void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId
 		UObject* ObjectValue = ObjectProperty->GetObjectPropertyValue(Data);
 		if (ObjectValue != nullptr)
 		{
+			FOptionalScopeLock Lock(SerializationLock);
+
 			FNetworkGUID NetGUID;
 			if (ObjectValue->IsFullNameStableForNetworking() || ObjectValue->IsSupportedForNetworking())
 			{
@@ -219,7 +435,7 @@ void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId
 			}
 		}
 
-		AddObjectRefToSchema(Object, FieldId, ObjectRef);
+		AddObjectRefToSchema(Object, FieldId, ObjectRef, PathDictionary);
 	}
 	else if (UNameProperty* NameProperty = Cast<UNameProperty>(Property))
 	{
@@ -267,36 +483,391 @@ void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId
 	}
 }
 
-TArray<Worker_ComponentData> ComponentFactory::CreateComponentDatas(UObject* Object, FClassInfo* Info, const FRepChangeState& RepChangeState, const FHandoverChangeState& HandoverChangeState)
+void ComponentFactory::AddQuantizedProperty(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, const uint8* Data, const FQuantizedFloatSchemaData& Quantization)
+{
+	if (UFloatProperty* FloatProperty = Cast<UFloatProperty>(Property))
+	{
+		AddQuantizedFloatToSchema(Object, FieldId, FloatProperty->GetPropertyValue(Data), Quantization);
+	}
+	else
+	{
+		// The only quantized structs are FVectors, see SchemaGenerator.
+		const FVector& Vector = *reinterpret_cast<const FVector*>(Data);
+		AddQuantizedFloatToSchema(Object, FieldId, Vector.X, Quantization);
+		AddQuantizedFloatToSchema(Object, FieldId, Vector.Y, Quantization);
+		AddQuantizedFloatToSchema(Object, FieldId, Vector.Z, Quantization);
+	}
+}
+
+void ComponentFactory::AddPackedBools(Schema_Object* ComponentObject, UObject* Object, const FRepLayout& RepLayout, const TArray<uint16>& PackedBoolHandles, const TBitArray<>& ChangedBools)
+{
+	TBitArray<> Values(false, PackedBoolHandles.Num());
+	for (int32 BitIndex = 0; BitIndex < PackedBoolHandles.Num(); BitIndex++)
+	{
+		const uint16 Handle = PackedBoolHandles[BitIndex];
+		const FRepLayoutCmd& Cmd = RepLayout.Cmds[RepLayout.BaseHandleToCmdIndex[Handle - 1].CmdIndex];
+		Values[BitIndex] = Cast<UBoolProperty>(Cmd.Property)->GetPropertyValue((uint8*)Object + Cmd.Offset);
+	}
+
+	AddPackedBoolsToSchema(ComponentObject, SpatialConstants::PACKED_BOOLS_FIELD_ID, Values, ChangedBools);
+}
+
+bool ComponentFactory::AddArrayDelta(Schema_Object* ComponentObject, const FRepChangeState& Changes, const FRepHandleIterator& HandleIterator, const uint8* Data, FArrayDeltaState& DeltaState, TSet<const UObject*>& UnresolvedObjects)
+{
+	const FRepLayoutCmd& Cmd = Changes.RepLayout.Cmds[HandleIterator.CmdIndex];
+	UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Cmd.Property);
+
+	if (IsFastArrayItems(Changes.RepLayout, HandleIterator.CmdIndex))
+	{
+		return AddFastArrayDelta(ComponentObject, HandleIterator.Handle, ArrayProperty, Data, DeltaState, UnresolvedObjects);
+	}
+
+	FScriptArrayHelper ArrayHelper(ArrayProperty, Data);
+	const int32 ArrayNum = ArrayHelper.Num();
+
+	// The changelist entry for an array is the handle, the number of element handles, then the element handles.
+	// Changelists without element handles (e.g. resending a property once its references resolved) don't say which elements changed.
+	const TArray<uint16>& Changed = Changes.RepChanged;
+	const int32 NumElementHandlesIndex = HandleIterator.ChangelistIterator.ChangedIndex;
+	const int32 NumElementHandles = Changed[NumElementHandlesIndex];
+
+	if (DeltaState.bNeedsFullSend || NumElementHandles == 0 || ArrayNum == 0 || ArrayNum < (int32)GetDefault<USpatialGDKSettings>()->ArrayDeltaMinNumElements)
+	{
+		return false;
+	}
+
+	// Element handles are 1-based, with one handle per command inside the array.
+	const int32 NumHandlesPerElement = Cmd.EndCmd - HandleIterator.CmdIndex - 2;
+	check(NumHandlesPerElement > 0);
+
+	while (DeltaState.DirtyIndices.Num() < ArrayNum)
+	{
+		DeltaState.DirtyIndices.Add(false);
+	}
+
+	for (int32 i = 1; i <= NumElementHandles; i++)
+	{
+		const uint16 ElementHandle = Changed[NumElementHandlesIndex + i];
+		if (ElementHandle == 0)
+		{
+			continue;
+		}
+
+		const int32 ElementIndex = (ElementHandle - 1) / NumHandlesPerElement;
+		if (ElementIndex < ArrayNum)
+		{
+			DeltaState.DirtyIndices[ElementIndex] = true;
+		}
+	}
+
+	// Elements past the shortest length since the full send were removed on the receiving end, so they always need sending.
+	DeltaState.MinNumSinceFullSend = FMath::Min(DeltaState.MinNumSinceFullSend, ArrayNum);
+
+	TArray<int32> DeltaIndices;
+	for (int32 ElementIndex = 0; ElementIndex < ArrayNum; ElementIndex++)
+	{
+		if (ElementIndex >= DeltaState.MinNumSinceFullSend || DeltaState.DirtyIndices[ElementIndex])
+		{
+			DeltaIndices.Add(ElementIndex);
+		}
+	}
+
+	// Estimated from the in-memory element size, which is enough to tell whether the delta is worth it.
+	const uint32 ElementSize = ArrayProperty->Inner->ElementSize;
+	const uint32 EstimatedFullBytes = ArrayNum * ElementSize;
+	const uint32 EstimatedDeltaBytes = sizeof(uint32) + DeltaIndices.Num() * (sizeof(uint32) + ElementSize);
+	if (EstimatedDeltaBytes >= EstimatedFullBytes)
+	{
+		return false;
+	}
+
+	const uint32 SizeBeforeDelta = NetDriver->OutgoingByteProfiler.IsEnabled() ? Schema_GetWriteBufferLength(ComponentObject) : 0;
+
+	Schema_Object* DeltaObject = Schema_AddObject(ComponentObject, HandleIterator.Handle + SpatialConstants::ARRAY_DELTA_FIELD_ID_OFFSET);
+	Schema_AddUint32(DeltaObject, SpatialConstants::ARRAY_DELTA_LENGTH_ID, ArrayNum);
+	for (int32 ElementIndex : DeltaIndices)
+	{
+		Schema_AddUint32(DeltaObject, SpatialConstants::ARRAY_DELTA_INDICES_ID, ElementIndex);
+		AddProperty(DeltaObject, SpatialConstants::ARRAY_DELTA_VALUES_ID, ArrayProperty->Inner, ArrayHelper.GetRawPtr(ElementIndex), UnresolvedObjects, nullptr);
+	}
+
+	DeltaState.bHasSentDelta = true;
+	NetDriver->Sender->RecordArrayReplication(ArrayProperty, /* bWasDelta */ true);
+	if (NetDriver->OutgoingByteProfiler.IsEnabled())
+	{
+		RecordArrayDeltaBytes(ComponentObject, SizeBeforeDelta, HandleIterator.Handle, ArrayProperty, Data);
+	}
+
+	return true;
+}
+
+bool ComponentFactory::CanUseArrayDelta(const FRepLayout& RepLayout, int32 CmdIndex)
+{
+	const FRepLayoutCmd& Cmd = RepLayout.Cmds[CmdIndex];
+	const FRepParentCmd& Parent = RepLayout.Parents[Cmd.ParentIndex];
+
+	// FastArraySerializer items are sent by ReplicationID rather than index, see AddFastArrayDelta.
+	if (UStructProperty* ParentStruct = Cast<UStructProperty>(Parent.Property))
+	{
+		if (ParentStruct->Struct->IsChildOf(FFastArraySerializer::StaticStruct()))
+		{
+			return IsFastArrayItems(RepLayout, CmdIndex);
+		}
+	}
+
+	// Element handles of nested arrays don't map directly to element indices.
+	for (int32 InnerCmdIndex = CmdIndex + 1; InnerCmdIndex < Cmd.EndCmd - 1; InnerCmdIndex++)
+	{
+		if (RepLayout.Cmds[InnerCmdIndex].Type == ERepLayoutCmdType::DynamicArray)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool ComponentFactory::AddFastArrayDelta(Schema_Object* ComponentObject, uint16 Handle, UArrayProperty* ArrayProperty, const uint8* Data, FArrayDeltaState& DeltaState, TSet<const UObject*>& UnresolvedObjects)
+{
+	FScriptArrayHelper ArrayHelper(ArrayProperty, Data);
+	const int32 ArrayNum = ArrayHelper.Num();
+
+	if (DeltaState.bNeedsFullSend || ArrayNum < (int32)GetDefault<USpatialGDKSettings>()->ArrayDeltaMinNumElements)
+	{
+		return false;
+	}
+
+	// Items are changed or added if their ReplicationKey differs from the last full send, as with native fast array replication.
+	TArray<int32> ChangedIndices;
+	TSet<int32> ItemIds;
+	ItemIds.Reserve(ArrayNum);
+	for (int32 ItemIndex = 0; ItemIndex < ArrayNum; ItemIndex++)
+	{
+		const FFastArraySerializerItem* Item = reinterpret_cast<const FFastArraySerializerItem*>(ArrayHelper.GetRawPtr(ItemIndex));
+		if (Item->ReplicationID == INDEX_NONE)
+		{
+			// Items that were never marked dirty can't be told apart.
+			return false;
+		}
+
+		ItemIds.Add(Item->ReplicationID);
+
+		const int32* SentKey = DeltaState.FastArrayItemKeys.Find(Item->ReplicationID);
+		if (SentKey == nullptr || *SentKey != Item->ReplicationKey)
+		{
+			ChangedIndices.Add(ItemIndex);
+		}
+	}
+
+	TArray<int32> RemovedIds;
+	for (const auto& SentItem : DeltaState.FastArrayItemKeys)
+	{
+		if (!ItemIds.Contains(SentItem.Key))
+		{
+			RemovedIds.Add(SentItem.Key);
+		}
+	}
+
+	// The rep layout saw a change that no item was marked dirty for, so only a full send is sure to include it.
+	if (ChangedIndices.Num() == 0 && RemovedIds.Num() == 0)
+	{
+		return false;
+	}
+
+	const uint32 ElementSize = ArrayProperty->Inner->ElementSize;
+	const uint32 EstimatedFullBytes = ArrayNum * ElementSize;
+	const uint32 EstimatedDeltaBytes = sizeof(uint32) + ChangedIndices.Num() * (sizeof(int32) + ElementSize) + RemovedIds.Num() * sizeof(int32);
+	if (EstimatedDeltaBytes >= EstimatedFullBytes)
+	{
+		return false;
+	}
+
+	const uint32 SizeBeforeDelta = NetDriver->OutgoingByteProfiler.IsEnabled() ? Schema_GetWriteBufferLength(ComponentObject) : 0;
+
+	Schema_Object* DeltaObject = Schema_AddObject(ComponentObject, Handle + SpatialConstants::ARRAY_DELTA_FIELD_ID_OFFSET);
+	Schema_AddUint32(DeltaObject, SpatialConstants::ARRAY_DELTA_LENGTH_ID, ArrayNum);
+	for (int32 ItemIndex : ChangedIndices)
+	{
+		const uint8* ItemData = ArrayHelper.GetRawPtr(ItemIndex);
+		Schema_AddInt32(DeltaObject, SpatialConstants::FAST_ARRAY_DELTA_ITEM_IDS_ID, reinterpret_cast<const FFastArraySerializerItem*>(ItemData)->ReplicationID);
+		AddProperty(DeltaObject, SpatialConstants::ARRAY_DELTA_VALUES_ID, ArrayProperty->Inner, ItemData, UnresolvedObjects, nullptr);
+	}
+
+	for (int32 RemovedId : RemovedIds)
+	{
+		Schema_AddInt32(DeltaObject, SpatialConstants::FAST_ARRAY_DELTA_REMOVED_ITEM_IDS_ID, RemovedId);
+	}
+
+	DeltaState.bHasSentDelta = true;
+	NetDriver->Sender->RecordArrayReplication(ArrayProperty, /* bWasDelta */ true);
+	if (NetDriver->OutgoingByteProfiler.IsEnabled())
+	{
+		RecordArrayDeltaBytes(ComponentObject, SizeBeforeDelta, Handle, ArrayProperty, Data);
+	}
+
+	return true;
+}
+
+void ComponentFactory::AddFastArrayItemIds(Schema_Object* ComponentObject, uint16 Handle, UArrayProperty* ArrayProperty, const uint8* Data, FArrayDeltaState& DeltaState, TArray<Schema_FieldId>* ClearedIds)
+{
+	FScriptArrayHelper ArrayHelper(ArrayProperty, Data);
+	const Schema_FieldId ItemIdsFieldId = Handle + SpatialConstants::FAST_ARRAY_ITEM_IDS_FIELD_ID_OFFSET;
+
+	DeltaState.FastArrayItemKeys.Reset();
+
+	for (int32 ItemIndex = 0; ItemIndex < ArrayHelper.Num(); ItemIndex++)
+	{
+		const FFastArraySerializerItem* Item = reinterpret_cast<const FFastArraySerializerItem*>(ArrayHelper.GetRawPtr(ItemIndex));
+		Schema_AddInt32(ComponentObject, ItemIdsFieldId, Item->ReplicationID);
+		DeltaState.FastArrayItemKeys.Add(Item->ReplicationID, Item->ReplicationKey);
+	}
+
+	if (ArrayHelper.Num() == 0 && ClearedIds)
+	{
+		ClearedIds->Add(ItemIdsFieldId);
+	}
+}
+
+void ComponentFactory::RecordArrayDeltaBytes(Schema_Object* ComponentObject, uint32 SizeBeforeDelta, uint16 Handle, UArrayProperty* ArrayProperty, const uint8* Data)
+{
+	const uint32 DeltaBytes = Schema_GetWriteBufferLength(ComponentObject) - SizeBeforeDelta;
+
+	// The full array wasn't written, so write it to a scratch object to see what the delta saved.
+	Schema_ComponentUpdate* ScratchUpdate = Schema_CreateComponentUpdate(0);
+	Schema_Object* ScratchObject = Schema_GetComponentUpdateFields(ScratchUpdate);
+	TSet<const UObject*> ScratchUnresolvedObjects;
+	AddProperty(ScratchObject, Handle, ArrayProperty, Data, ScratchUnresolvedObjects, nullptr);
+	const uint32 FullBytes = Schema_GetWriteBufferLength(ScratchObject);
+	Schema_DestroyComponentUpdate(ScratchUpdate);
+
+	NetDriver->Sender->RecordArrayBytes(ArrayProperty, FullBytes, DeltaBytes);
+}
+
+bool ComponentFactory::IsFastArrayItems(const FRepLayout& RepLayout, int32 CmdIndex)
+{
+	const FRepLayoutCmd& Cmd = RepLayout.Cmds[CmdIndex];
+	if (Cmd.Type != ERepLayoutCmdType::DynamicArray)
+	{
+		return false;
+	}
+
+	UStructProperty* ParentStruct = Cast<UStructProperty>(RepLayout.Parents[Cmd.ParentIndex].Property);
+	UStructProperty* ItemStruct = Cast<UStructProperty>(Cast<UArrayProperty>(Cmd.Property)->Inner);
+
+	return ParentStruct != nullptr && ParentStruct->Struct->IsChildOf(FFastArraySerializer::StaticStruct())
+		&& ItemStruct != nullptr && ItemStruct->Struct->IsChildOf(FFastArraySerializerItem::StaticStruct());
+}
+
+TArray<Worker_ComponentData> ComponentFactory::CreateComponentDatas(UObject* Object, FClassInfo* Info, const FRepChangeState& RepChangeState, const FHandoverChangeState& HandoverChangeState, FArrayDeltaStates* ArrayDeltaStates /*= nullptr*/, FFieldValueHashes* FieldValueHashes /*= nullptr*/)
 {
 	TArray<Worker_ComponentData> ComponentDatas;
 
 	if (Info->SchemaComponents[SCHEMA_Data] != SpatialConstants::INVALID_COMPONENT_ID)
 	{
-		ComponentDatas.Add(CreateComponentData(Info->SchemaComponents[SCHEMA_Data], Object, RepChangeState, SCHEMA_Data));
+		ComponentDatas.Add(CreateComponentData(Info->SchemaComponents[SCHEMA_Data], Object, Info, RepChangeState, SCHEMA_Data, ArrayDeltaStates, FieldValueHashes));
 	}
 
 	if (Info->SchemaComponents[SCHEMA_OwnerOnly] != SpatialConstants::INVALID_COMPONENT_ID)
 	{
-		ComponentDatas.Add(CreateComponentData(Info->SchemaComponents[SCHEMA_OwnerOnly], Object, RepChangeState, SCHEMA_OwnerOnly));
+		ComponentDatas.Add(CreateComponentData(Info->SchemaComponents[SCHEMA_OwnerOnly], Object, Info, RepChangeState, SCHEMA_OwnerOnly, ArrayDeltaStates, FieldValueHashes));
 	}
 
 	if (Info->SchemaComponents[SCHEMA_Handover] != SpatialConstants::INVALID_COMPONENT_ID)
 	{
-		ComponentDatas.Add(CreateHandoverComponentData(Info->SchemaComponents[SCHEMA_Handover], Object, Info, HandoverChangeState));
+		ComponentDatas.Add(CreateHandoverComponentData(Info->SchemaComponents[SCHEMA_Handover], Object, Info, HandoverChangeState, FieldValueHashes));
 	}
 
 	return ComponentDatas;
 }
 
-Worker_ComponentData ComponentFactory::CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup)
+void ComponentFactory::CreateInitialComponentDatas(USpatialNetDriver* NetDriver, TArray<FInitialObjectData>& Objects)
+{
+	// Each task writes to its own unresolved objects, array delta states and value hashes, which are merged into the objects' once every task is done.
+	struct FComponentTask
+	{
+		int32 ObjectIndex = INDEX_NONE;
+		ESchemaComponentType Type = SCHEMA_Invalid;
+		Worker_ComponentData ComponentData = {};
+		FUnresolvedObjectsMap UnresolvedObjects;
+		FArrayDeltaStates ArrayDeltaStates;
+		FFieldValueHashes FieldValueHashes;
+	};
+
+	TArray<FComponentTask> Tasks;
+	for (int32 ObjectIndex = 0; ObjectIndex < Objects.Num(); ObjectIndex++)
+	{
+		for (ESchemaComponentType Type : { SCHEMA_Data, SCHEMA_OwnerOnly, SCHEMA_Handover })
+		{
+			if (Objects[ObjectIndex].Info->SchemaComponents[Type] != SpatialConstants::INVALID_COMPONENT_ID)
+			{
+				FComponentTask& Task = Tasks[Tasks.AddDefaulted()];
+				Task.ObjectIndex = ObjectIndex;
+				Task.Type = Type;
+			}
+		}
+	}
+
+	const USpatialGDKSettings* Settings = GetDefault<USpatialGDKSettings>();
+
+	// The outgoing byte profiler isn't thread safe, so profiling keeps everything on the game thread.
+	const bool bSingleThreaded = !Settings->bEnableParallelInitialDataSerialization
+		|| Tasks.Num() < (int32)Settings->ParallelInitialDataSerializationMinComponents
+		|| NetDriver->OutgoingByteProfiler.IsEnabled();
+
+	FCriticalSection SerializationLock;
+
+	ParallelFor(Tasks.Num(), [NetDriver, &Objects, &Tasks, &SerializationLock, bSingleThreaded](int32 TaskIndex)
+	{
+		FComponentTask& Task = Tasks[TaskIndex];
+		const FInitialObjectData& ObjectData = Objects[Task.ObjectIndex];
+
+		// A task writes a single component, so only one of the unresolved objects maps is used.
+		ComponentFactory Factory(Task.UnresolvedObjects, Task.UnresolvedObjects, NetDriver);
+		Factory.SerializationLock = bSingleThreaded ? nullptr : &SerializationLock;
+
+		FArrayDeltaStates* ArrayDeltaStates = ObjectData.ArrayDeltaStates != nullptr ? &Task.ArrayDeltaStates : nullptr;
+		FFieldValueHashes* FieldValueHashes = ObjectData.FieldValueHashes != nullptr ? &Task.FieldValueHashes : nullptr;
+
+		const Worker_ComponentId ComponentId = ObjectData.Info->SchemaComponents[Task.Type];
+		if (Task.Type == SCHEMA_Handover)
+		{
+			Task.ComponentData = Factory.CreateHandoverComponentData(ComponentId, ObjectData.Object, ObjectData.Info, ObjectData.HandoverChanges, FieldValueHashes);
+		}
+		else
+		{
+			Task.ComponentData = Factory.CreateComponentData(ComponentId, ObjectData.Object, ObjectData.Info, ObjectData.RepChanges, Task.Type, ArrayDeltaStates, FieldValueHashes);
+		}
+	}, bSingleThreaded);
+
+	for (FComponentTask& Task : Tasks)
+	{
+		FInitialObjectData& ObjectData = Objects[Task.ObjectIndex];
+		ObjectData.ComponentDatas.Add(Task.ComponentData);
+
+		FUnresolvedObjectsMap& UnresolvedObjects = Task.Type == SCHEMA_Handover ? ObjectData.HandoverUnresolvedObjects : ObjectData.RepUnresolvedObjects;
+		UnresolvedObjects.Append(MoveTemp(Task.UnresolvedObjects));
+
+		if (ObjectData.ArrayDeltaStates != nullptr)
+		{
+			ObjectData.ArrayDeltaStates->Append(MoveTemp(Task.ArrayDeltaStates));
+		}
+
+		if (ObjectData.FieldValueHashes != nullptr)
+		{
+			ObjectData.FieldValueHashes->RepHashes.Append(Task.FieldValueHashes.RepHashes);
+			ObjectData.FieldValueHashes->HandoverHashes.Append(Task.FieldValueHashes.HandoverHashes);
+		}
+	}
+}
+
+Worker_ComponentData ComponentFactory::CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, FArrayDeltaStates* ArrayDeltaStates, FFieldValueHashes* FieldValueHashes)
 {
 	Worker_ComponentData ComponentData = {};
 	ComponentData.component_id = ComponentId;
 	ComponentData.schema_type = Schema_CreateComponentData(ComponentId);
 	Schema_Object* ComponentObject = Schema_GetComponentDataFields(ComponentData.schema_type);
 
-	FillSchemaObject(ComponentObject, Object, Changes, PropertyGroup, true);
+	FillSchemaObject(ComponentObject, Object, Info, Changes, PropertyGroup, true, ArrayDeltaStates, FieldValueHashes);
 
 	return ComponentData;
 }
@@ -310,17 +881,17 @@ Worker_ComponentData ComponentFactory::CreateEmptyComponentData(Worker_Component
 	return ComponentData;
 }
 
-Worker_ComponentData ComponentFactory::CreateHandoverComponentData(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes)
+Worker_ComponentData ComponentFactory::CreateHandoverComponentData(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes, FFieldValueHashes* FieldValueHashes)
 {
 	Worker_ComponentData ComponentData = CreateEmptyComponentData(ComponentId);
 	Schema_Object* ComponentObject = Schema_GetComponentDataFields(ComponentData.schema_type);
 
-	FillHandoverSchemaObject(ComponentObject, Object, Info, Changes, true);
+	FillHandoverSchemaObject(ComponentObject, Object, Info, Changes, true, FieldValueHashes);
 
 	return ComponentData;
 }
 
-TArray<Worker_ComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject* Object, FClassInfo* Info, const FRepChangeState* RepChangeState, const FHandoverChangeState* HandoverChangeState)
+TArray<Worker_ComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject* Object, FClassInfo* Info, const FRepChangeState* RepChangeState, const FHandoverChangeState* HandoverChangeState, FArrayDeltaStates* ArrayDeltaStates /*= nullptr*/, FFieldValueHashes* FieldValueHashes /*= nullptr*/)
 {
 	TArray<Worker_ComponentUpdate> ComponentUpdates;
 
@@ -329,7 +900,7 @@ TArray<Worker_ComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject*
 		if (Info->SchemaComponents[SCHEMA_Data] != SpatialConstants::INVALID_COMPONENT_ID)
 		{
 			bool bWroteSomething = false;
-			Worker_ComponentUpdate MultiClientUpdate = CreateComponentUpdate(Info->SchemaComponents[SCHEMA_Data], Object, *RepChangeState, SCHEMA_Data, bWroteSomething);
+			Worker_ComponentUpdate MultiClientUpdate = CreateComponentUpdate(Info->SchemaComponents[SCHEMA_Data], Object, Info, *RepChangeState, SCHEMA_Data, ArrayDeltaStates, FieldValueHashes, bWroteSomething);
 			if (bWroteSomething)
 			{
 				ComponentUpdates.Add(MultiClientUpdate);
@@ -339,7 +910,7 @@ TArray<Worker_ComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject*
 		if (Info->SchemaComponents[SCHEMA_OwnerOnly] != SpatialConstants::INVALID_COMPONENT_ID)
 		{
 			bool bWroteSomething = false;
-			Worker_ComponentUpdate SingleClientUpdate = CreateComponentUpdate(Info->SchemaComponents[SCHEMA_OwnerOnly], Object, *RepChangeState, SCHEMA_OwnerOnly, bWroteSomething);
+			Worker_ComponentUpdate SingleClientUpdate = CreateComponentUpdate(Info->SchemaComponents[SCHEMA_OwnerOnly], Object, Info, *RepChangeState, SCHEMA_OwnerOnly, ArrayDeltaStates, FieldValueHashes, bWroteSomething);
 			if (bWroteSomething)
 			{
 				ComponentUpdates.Add(SingleClientUpdate);
@@ -352,7 +923,7 @@ TArray<Worker_ComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject*
 		if (Info->SchemaComponents[SCHEMA_Handover] != SpatialConstants::INVALID_COMPONENT_ID)
 		{
 			bool bWroteSomething = false;
-			Worker_ComponentUpdate HandoverUpdate = CreateHandoverComponentUpdate(Info->SchemaComponents[SCHEMA_Handover], Object, Info, *HandoverChangeState, bWroteSomething);
+			Worker_ComponentUpdate HandoverUpdate = CreateHandoverComponentUpdate(Info->SchemaComponents[SCHEMA_Handover], Object, Info, *HandoverChangeState, FieldValueHashes, bWroteSomething);
 			if (bWroteSomething)
 			{
 				ComponentUpdates.Add(HandoverUpdate);
@@ -363,7 +934,7 @@ TArray<Worker_ComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject*
 	return ComponentUpdates;
 }
 
-Worker_ComponentUpdate ComponentFactory::CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool& bWroteSomething)
+Worker_ComponentUpdate ComponentFactory::CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, FArrayDeltaStates* ArrayDeltaStates, FFieldValueHashes* FieldValueHashes, bool& bWroteSomething)
 {
 	Worker_ComponentUpdate ComponentUpdate = {};
 
@@ -373,7 +944,7 @@ Worker_ComponentUpdate ComponentFactory::CreateComponentUpdate(Worker_ComponentI
 
 	TArray<Schema_FieldId> ClearedIds;
 
-	bWroteSomething = FillSchemaObject(ComponentObject, Object, Changes, PropertyGroup, false, &ClearedIds);
+	bWroteSomething = FillSchemaObject(ComponentObject, Object, Info, Changes, PropertyGroup, false, ArrayDeltaStates, FieldValueHashes, &ClearedIds);
 
 	for (Schema_FieldId Id : ClearedIds)
 	{
@@ -388,7 +959,7 @@ Worker_ComponentUpdate ComponentFactory::CreateComponentUpdate(Worker_ComponentI
 	return ComponentUpdate;
 }
 
-Worker_ComponentUpdate ComponentFactory::CreateHandoverComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes, bool& bWroteSomething)
+Worker_ComponentUpdate ComponentFactory::CreateHandoverComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes, FFieldValueHashes* FieldValueHashes, bool& bWroteSomething)
 {
 	Worker_ComponentUpdate ComponentUpdate = {};
 
@@ -398,7 +969,7 @@ Worker_ComponentUpdate ComponentFactory::CreateHandoverComponentUpdate(Worker_Co
 
 	TArray<Schema_FieldId> ClearedIds;
 
-	bWroteSomething = FillHandoverSchemaObject(ComponentObject, Object, Info, Changes, false, &ClearedIds);
+	bWroteSomething = FillHandoverSchemaObject(ComponentObject, Object, Info, Changes, false, FieldValueHashes, &ClearedIds);
 
 	for (Schema_FieldId Id : ClearedIds)
 	{
@@ -37,7 +37,7 @@ void ComponentReader::ApplyComponentData(const Worker_ComponentData& ComponentDa
 	}
 	else
 	{
-		ApplySchemaObject(ComponentObject, Object, Channel, true);
+		ApplySchemaObject(ComponentObject, Object, Channel, TypebindingManager->FindCategoryByComponentId(ComponentData.component_id), true);
 	}
 }
 
@@ -55,11 +55,11 @@ void ComponentReader::ApplyComponentUpdate(const Worker_ComponentUpdate& Compone
 	}
 	else
 	{
-		ApplySchemaObject(ComponentObject, Object, Channel, false, &ClearedIds);
+		ApplySchemaObject(ComponentObject, Object, Channel, TypebindingManager->FindCategoryByComponentId(ComponentUpdate.component_id), false, &ClearedIds);
 	}
 }
 
-void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds)
+void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, ESchemaComponentType PropertyGroup, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds)
 {
 	bool bAutonomousProxy = Channel->IsClientAutonomousProxy();
 
@@ -72,11 +72,17 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 		return;
 	}
 
+	// Array deltas have field IDs above all rep handles, so sorting applies them after the full array they modify.
+	UpdateFields.Sort();
+
 	if(Object->IsPendingKill())
 	{
 		return;
 	}
 
+	FClassInfo* ClassInfo = TypebindingManager->FindClassInfoByClass(Object->GetClass());
+	check(ClassInfo);
+
 	FObjectReplicator& Replicator = Channel->PreReceiveSpatialUpdate(Object);
 
 	TSharedPtr<FRepState> RepState = Replicator.RepState;
@@ -90,11 +96,78 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 
 	TArray<UProperty*> RepNotifies;
 
+	auto AddRepNotify = [&RepNotifies, &RepState, bIsInitialData](const FRepLayoutCmd& Cmd, const FRepParentCmd& Parent, int32 Offset, uint8* Data)
+	{
+		// Parent.Property is the "root" replicated property, e.g. if a struct property was flattened
+		if (Parent.Property->HasAnyPropertyFlags(CPF_RepNotify))
+		{
+			bool bIsIdentical = Cmd.Property->Identical(RepState->StaticBuffer.GetData() + Offset, Data);
+
+			// Only call RepNotify for REPNOTIFY_Always if we are not applying initial data.
+			if (bIsInitialData)
+			{
+				if (!bIsIdentical)
+				{
+					RepNotifies.AddUnique(Parent.Property);
+				}
+			}
+			else
+			{
+				if (Parent.RepNotifyCondition == REPNOTIFY_Always || !bIsIdentical)
+				{
+					RepNotifies.AddUnique(Parent.Property);
+				}
+			}
+		}
+	};
+
 	for (uint32 FieldId : UpdateFields)
 	{
-		// FieldId is the same as rep handle
-		check(FieldId > 0 && (int)FieldId - 1 < BaseHandleToCmdIndex.Num());
-		const FRepLayoutCmd& Cmd = Cmds[BaseHandleToCmdIndex[FieldId - 1].CmdIndex];
+		if (FieldId == SpatialConstants::PACKED_BOOLS_FIELD_ID)
+		{
+			const TArray<uint16>* PackedBoolHandles = ClassInfo->PackedBoolHandles.Find(PropertyGroup);
+			TBitArray<> PackedBoolValues;
+			TBitArray<> ChangedPackedBools;
+			if (PackedBoolHandles == nullptr || !GetPackedBoolsFromSchema(ComponentObject, FieldId, PackedBoolHandles->Num(), PackedBoolValues, ChangedPackedBools))
+			{
+				UE_LOG(LogSpatialComponentReader, Warning, TEXT("Packed bools received for %s don't match the schema database. Schema may need regenerating."), *Object->GetName());
+				continue;
+			}
+
+			for (int32 BitIndex = 0; BitIndex < PackedBoolHandles->Num(); BitIndex++)
+			{
+				if (!bIsInitialData && !ChangedPackedBools[BitIndex])
+				{
+					continue;
+				}
+
+				const uint16 Handle = (*PackedBoolHandles)[BitIndex];
+				check(Handle > 0 && (int)Handle - 1 < BaseHandleToCmdIndex.Num());
+				const FRepLayoutCmd& Cmd = Cmds[BaseHandleToCmdIndex[Handle - 1].CmdIndex];
+				const FRepParentCmd& Parent = Parents[Cmd.ParentIndex];
+
+				if (NetDriver->IsServer() || ConditionMap.IsRelevant(Parent.Condition))
+				{
+					uint8* Data = (uint8*)Object + Cmd.Offset;
+					Cast<UBoolProperty>(Cmd.Property)->SetPropertyValue(Data, PackedBoolValues[BitIndex]);
+					AddRepNotify(Cmd, Parent, Cmd.Offset, Data);
+				}
+			}
+			continue;
+		}
+
+		if (FieldId >= SpatialConstants::FAST_ARRAY_ITEM_IDS_FIELD_ID_OFFSET)
+		{
+			// Fast array item IDs are read along with the full array they belong to.
+			continue;
+		}
+
+		// FieldId is the same as rep handle, except for array deltas which are offset from it
+		const bool bIsArrayDelta = FieldId >= SpatialConstants::ARRAY_DELTA_FIELD_ID_OFFSET;
+		const uint32 Handle = bIsArrayDelta ? FieldId - SpatialConstants::ARRAY_DELTA_FIELD_ID_OFFSET : FieldId;
+
+		check(Handle > 0 && (int)Handle - 1 < BaseHandleToCmdIndex.Num());
+		const FRepLayoutCmd& Cmd = Cmds[BaseHandleToCmdIndex[Handle - 1].CmdIndex];
 		const FRepParentCmd& Parent = Parents[Cmd.ParentIndex];
 
 		if (NetDriver->IsServer() || ConditionMap.IsRelevant(Parent.Condition))
@@ -104,46 +177,35 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 
 			uint8* Data = (uint8*)Object + SwappedCmd.Offset;
 
-			if (bIsInitialData || GetPropertyCount(ComponentObject, FieldId, Cmd.Property) > 0 || ClearedIds->Find(FieldId) != INDEX_NONE)
-			{
-				if (Cmd.Type == ERepLayoutCmdType::DynamicArray)
-				{
-					UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Cmd.Property);
-					bool bProcessedArray = false;
+			const FQuantizedFloatSchemaData* Quantization = bIsArrayDelta ? nullptr : ClassInfo->QuantizedFloats.Find(Handle);
 
-					// Check if this is a FastArraySerializer array so we can simulate the FFastArraySerializerItem PreReplicatedRemove and PostReplicatedAdd calls.
-					if (UStructProperty* ParentStruct = Cast<UStructProperty>(Parent.Property))
-					{
-						if (ParentStruct->Struct->IsChildOf(FFastArraySerializer::StaticStruct()))
-						{
-							// Read array into a temporary array so the appropriate remove/add operations can be processed
-							FScriptArray TempArray;
-							// Populate array with existing data so compare will incorporate non-replicated entities
-							Cmd.Property->CopyCompleteValue((void*)&TempArray, Data);
-
-							ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, (uint8*)&TempArray, SwappedCmd.Offset, Cmd.ParentIndex);
-							bProcessedArray = true;
-
-							if (!Cmd.Property->Identical((void*)&TempArray, Data))
-							{
-								FSpatialNetDeltaSerializeInfo Parms;
-								Parms.NewArray = &TempArray;
-								Parms.ArrayProperty = ArrayProperty;
-
-								UScriptStruct::ICppStructOps* CppStructOps = ParentStruct->Struct->GetCppStructOps();
-								check(CppStructOps);
-
-								// This call resolves into FFastArraySerializer::SpatialFastArrayDeltaSerialize where our custom FFastArraySerializerItem
-								// callback are triggered.
-								CppStructOps->NetDeltaSerialize(Parms, ParentStruct->ContainerPtrToValuePtr<void>(Object, Parent.ArrayIndex));
-							}
-						}
-					}
+			UStructProperty* ParentStruct = Cast<UStructProperty>(Parent.Property);
+			const bool bIsFastArray = Cmd.Type == ERepLayoutCmdType::DynamicArray && ParentStruct != nullptr && ParentStruct->Struct->IsChildOf(FFastArraySerializer::StaticStruct());
 
-					if (!bProcessedArray)
-					{
-						ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, Data, SwappedCmd.Offset, Cmd.ParentIndex);
-					}
+			const bool bShouldApply = bIsArrayDelta
+				? Schema_GetObjectCount(ComponentObject, FieldId) > 0
+				: Quantization != nullptr
+				? Schema_GetUint32Count(ComponentObject, FieldId) > 0
+				: bIsInitialData || GetPropertyCount(ComponentObject, FieldId, Cmd.Property) > 0 || ClearedIds->Find(FieldId) != INDEX_NONE;
+
+			if (bShouldApply)
+			{
+				if (Quantization != nullptr)
+				{
+					ApplyQuantizedProperty(ComponentObject, FieldId, Cmd.Property, Data, *Quantization);
+				}
+				else if (bIsFastArray)
+				{
+					ApplyFastArray(ComponentObject, FieldId, Object, Channel, Cmd, Parent, Data, SwappedCmd.Offset, bIsArrayDelta);
+				}
+				else if (bIsArrayDelta)
+				{
+					check(Cmd.Type == ERepLayoutCmdType::DynamicArray);
+					ApplyArrayDelta(Schema_GetObject(ComponentObject, FieldId), RootObjectReferencesMap, Cast<UArrayProperty>(Cmd.Property), Data, SwappedCmd.Offset, Cmd.ParentIndex);
+				}
+				else if (Cmd.Type == ERepLayoutCmdType::DynamicArray)
+				{
+					ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, Cast<UArrayProperty>(Cmd.Property), Data, SwappedCmd.Offset, Cmd.ParentIndex);
 				}
 				else
 				{
@@ -161,28 +223,7 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 					}
 				}
 
-				// Parent.Property is the "root" replicated property, e.g. if a struct property was flattened
-				if (Parent.Property->HasAnyPropertyFlags(CPF_RepNotify))
-				{
-					bool bIsIdentical = Cmd.Property->Identical(RepState->StaticBuffer.GetData() + SwappedCmd.Offset, Data);
-
-					// Only call RepNotify for REPNOTIFY_Always if we are not applying initial data.
-					if (bIsInitialData)
-					{
-						if (!bIsIdentical)
-						{
-							RepNotifies.AddUnique(Parent.Property);
-						}
-					}
-					else
-					{
-						if (Parent.RepNotifyCondition == REPNOTIFY_Always || !bIsIdentical)
-						{
-							RepNotifies.AddUnique(Parent.Property);
-						}
-					}
-
-				}
+				AddRepNotify(Cmd, Parent, SwappedCmd.Offset, Data);
 			}
 		}
 	}
@@ -369,21 +410,30 @@ void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldI
 	}
 }
 
-void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex)
+void ComponentReader::ApplyQuantizedProperty(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, uint8* Data, const FQuantizedFloatSchemaData& Quantization)
 {
-	FObjectReferencesMap* ArrayObjectReferences;
-	bool bNewArrayMap = false;
-	if (FObjectReferences* ExistingEntry = InObjectReferencesMap.Find(Offset))
+	if (UFloatProperty* FloatProperty = Cast<UFloatProperty>(Property))
 	{
-		check(ExistingEntry->Array);
-		check(ExistingEntry->ParentIndex == ParentIndex && ExistingEntry->Property == Property);
-		ArrayObjectReferences = ExistingEntry->Array.Get();
+		FloatProperty->SetPropertyValue(Data, IndexQuantizedFloatFromSchema(Object, FieldId, 0, Quantization));
+	}
+	else if (Schema_GetUint32Count(Object, FieldId) == 3)
+	{
+		// The only quantized structs are FVectors, see SchemaGenerator.
+		FVector& Vector = *reinterpret_cast<FVector*>(Data);
+		Vector.X = IndexQuantizedFloatFromSchema(Object, FieldId, 0, Quantization);
+		Vector.Y = IndexQuantizedFloatFromSchema(Object, FieldId, 1, Quantization);
+		Vector.Z = IndexQuantizedFloatFromSchema(Object, FieldId, 2, Quantization);
 	}
 	else
 	{
-		bNewArrayMap = true;
-		ArrayObjectReferences = new FObjectReferencesMap();
+		UE_LOG(LogSpatialComponentReader, Warning, TEXT("Quantized property %s doesn't match the schema database. Schema may need regenerating."), *Property->GetName());
 	}
+}
+
+void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex)
+{
+	bool bNewArrayMap = false;
+	FObjectReferencesMap* ArrayObjectReferences = FindOrCreateArrayObjectReferences(InObjectReferencesMap, Property, Offset, ParentIndex, bNewArrayMap);
 
 	FScriptArrayHelper ArrayHelper(Property, Data);
 
@@ -396,6 +446,201 @@ void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId,
 		ApplyProperty(Object, FieldId, *ArrayObjectReferences, i, Property->Inner, ArrayHelper.GetRawPtr(i), ElementOffset, ParentIndex);
 	}
 
+	StoreArrayObjectReferences(InObjectReferencesMap, ArrayObjectReferences, bNewArrayMap, Property, Offset, ParentIndex);
+}
+
+void ComponentReader::ApplyArrayDelta(Schema_Object* DeltaObject, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex)
+{
+	bool bNewArrayMap = false;
+	FObjectReferencesMap* ArrayObjectReferences = FindOrCreateArrayObjectReferences(InObjectReferencesMap, Property, Offset, ParentIndex, bNewArrayMap);
+
+	FScriptArrayHelper ArrayHelper(Property, Data);
+
+	const int32 NewNum = (int32)Schema_GetUint32(DeltaObject, SpatialConstants::ARRAY_DELTA_LENGTH_ID);
+
+	// Drop pending references for elements that are being removed.
+	for (int32 i = NewNum; i < ArrayHelper.Num(); i++)
+	{
+		ArrayObjectReferences->Remove(i * Property->Inner->ElementSize);
+	}
+
+	ArrayHelper.Resize(NewNum);
+
+	const uint32 NumChangedElements = Schema_GetUint32Count(DeltaObject, SpatialConstants::ARRAY_DELTA_INDICES_ID);
+	for (uint32 i = 0; i < NumChangedElements; i++)
+	{
+		const int32 ElementIndex = (int32)Schema_IndexUint32(DeltaObject, SpatialConstants::ARRAY_DELTA_INDICES_ID, i);
+		if (ElementIndex >= NewNum)
+		{
+			UE_LOG(LogSpatialComponentReader, Warning, TEXT("Array delta for %s has element index %d past the array length %d"), *Property->GetName(), ElementIndex, NewNum);
+			continue;
+		}
+
+		int32 ElementOffset = ElementIndex * Property->Inner->ElementSize;
+		ApplyProperty(DeltaObject, SpatialConstants::ARRAY_DELTA_VALUES_ID, *ArrayObjectReferences, i, Property->Inner, ArrayHelper.GetRawPtr(ElementIndex), ElementOffset, ParentIndex);
+	}
+
+	StoreArrayObjectReferences(InObjectReferencesMap, ArrayObjectReferences, bNewArrayMap, Property, Offset, ParentIndex);
+}
+
+void ComponentReader::ApplyFastArray(Schema_Object* ComponentObject, Schema_FieldId FieldId, UObject* Object, USpatialActorChannel* Channel, const FRepLayoutCmd& Cmd, const FRepParentCmd& Parent, uint8* Data, int32 Offset, bool bIsArrayDelta)
+{
+	UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Cmd.Property);
+	UStructProperty* ParentStruct = Cast<UStructProperty>(Parent.Property);
+	const uint16 Handle = bIsArrayDelta ? FieldId - SpatialConstants::ARRAY_DELTA_FIELD_ID_OFFSET : FieldId;
+
+	FFastArrayItemIds& FastArrayItemIds = Channel->GetFastArrayItemIds(Object);
+	TArray<int32>* ItemIds = FastArrayItemIds.Find(Handle);
+
+	if (bIsArrayDelta && (ItemIds == nullptr || ItemIds->Num() != FScriptArrayHelper(ArrayProperty, Data).Num()))
+	{
+		UE_LOG(LogSpatialComponentReader, Warning, TEXT("Ignoring delta for fast array %s on %s, as its item IDs aren't known. It will be applied once the array is next sent in full."), *ArrayProperty->GetName(), *Object->GetName());
+		return;
+	}
+
+	// Read array into a temporary array so the appropriate remove/add operations can be processed.
+	// Deltas only shrink what's sent: applying one still copies and walks the whole array here. The item callbacks are
+	// templated on the item type and only reachable through the struct's NetDeltaSerialize, so the items can't be
+	// patched in place from here.
+	FScriptArray TempArray;
+	// Populate array with existing data so compare will incorporate non-replicated entities
+	Cmd.Property->CopyCompleteValue((void*)&TempArray, Data);
+
+	if (bIsArrayDelta)
+	{
+		ApplyFastArrayDelta(Schema_GetObject(ComponentObject, FieldId), RootObjectReferencesMap, ArrayProperty, (uint8*)&TempArray, Offset, Cmd.ParentIndex, *ItemIds);
+
+		const int32 ExpectedNum = (int32)Schema_GetUint32(Schema_GetObject(ComponentObject, FieldId), SpatialConstants::ARRAY_DELTA_LENGTH_ID);
+		if (ItemIds->Num() != ExpectedNum)
+		{
+			UE_LOG(LogSpatialComponentReader, Warning, TEXT("Fast array %s on %s has %d items after applying a delta, but should have %d. Ignoring deltas until it's next sent in full."), *ArrayProperty->GetName(), *Object->GetName(), ItemIds->Num(), ExpectedNum);
+			FastArrayItemIds.Remove(Handle);
+		}
+	}
+	else
+	{
+		ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, (uint8*)&TempArray, Offset, Cmd.ParentIndex);
+
+		// Item IDs are only sent by workers with array delta encoding enabled.
+		const Schema_FieldId ItemIdsFieldId = Handle + SpatialConstants::FAST_ARRAY_ITEM_IDS_FIELD_ID_OFFSET;
+		const int32 NumItemIds = (int32)Schema_GetInt32Count(ComponentObject, ItemIdsFieldId);
+		if (NumItemIds == FScriptArrayHelper(ArrayProperty, (uint8*)&TempArray).Num())
+		{
+			TArray<int32>& NewItemIds = FastArrayItemIds.FindOrAdd(Handle);
+			NewItemIds.SetNum(NumItemIds);
+			for (int32 i = 0; i < NumItemIds; i++)
+			{
+				NewItemIds[i] = Schema_IndexInt32(ComponentObject, ItemIdsFieldId, i);
+			}
+		}
+		else
+		{
+			FastArrayItemIds.Remove(Handle);
+		}
+	}
+
+	// A delta is only written when items changed, so there's no need for another full comparison to find out.
+	if (bIsArrayDelta || !Cmd.Property->Identical((void*)&TempArray, Data))
+	{
+		FSpatialNetDeltaSerializeInfo Parms;
+		Parms.NewArray = &TempArray;
+		Parms.ArrayProperty = ArrayProperty;
+
+		UScriptStruct::ICppStructOps* CppStructOps = ParentStruct->Struct->GetCppStructOps();
+		check(CppStructOps);
+
+		// This call resolves into FFastArraySerializer::SpatialFastArrayDeltaSerialize where our custom FFastArraySerializerItem
+		// callback are triggered.
+		CppStructOps->NetDeltaSerialize(Parms, ParentStruct->ContainerPtrToValuePtr<void>(Object, Parent.ArrayIndex));
+	}
+}
+
+void ComponentReader::ApplyFastArrayDelta(Schema_Object* DeltaObject, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex, TArray<int32>& ItemIds)
+{
+	bool bNewArrayMap = false;
+	FObjectReferencesMap* ArrayObjectReferences = FindOrCreateArrayObjectReferences(InObjectReferencesMap, Property, Offset, ParentIndex, bNewArrayMap);
+
+	FScriptArrayHelper ArrayHelper(Property, Data);
+	const int32 ElementSize = Property->Inner->ElementSize;
+
+	TMap<int32, int32> IdToIndex;
+	IdToIndex.Reserve(ItemIds.Num());
+	for (int32 ItemIndex = 0; ItemIndex < ItemIds.Num(); ItemIndex++)
+	{
+		IdToIndex.Add(ItemIds[ItemIndex], ItemIndex);
+	}
+
+	// Deltas hold everything that changed since the last full send, so items may already have been removed by an earlier one.
+	// Removed items are swapped with the last item, as native fast array replication does.
+	const uint32 NumRemovedItems = Schema_GetInt32Count(DeltaObject, SpatialConstants::FAST_ARRAY_DELTA_REMOVED_ITEM_IDS_ID);
+	for (uint32 i = 0; i < NumRemovedItems; i++)
+	{
+		int32 ItemIndex = INDEX_NONE;
+		if (!IdToIndex.RemoveAndCopyValue(Schema_IndexInt32(DeltaObject, SpatialConstants::FAST_ARRAY_DELTA_REMOVED_ITEM_IDS_ID, i), ItemIndex))
+		{
+			continue;
+		}
+
+		const int32 LastIndex = ArrayHelper.Num() - 1;
+		ArrayObjectReferences->Remove(ItemIndex * ElementSize);
+
+		if (ItemIndex != LastIndex)
+		{
+			ArrayHelper.SwapValues(ItemIndex, LastIndex);
+			IdToIndex[ItemIds[LastIndex]] = ItemIndex;
+
+			// Pending references are keyed by element offset, so they move with the item.
+			if (FObjectReferences* LastItemReferences = ArrayObjectReferences->Find(LastIndex * ElementSize))
+			{
+				FObjectReferences MovedReferences(MoveTemp(*LastItemReferences));
+				ArrayObjectReferences->Remove(LastIndex * ElementSize);
+				ArrayObjectReferences->Add(ItemIndex * ElementSize, MoveTemp(MovedReferences));
+			}
+		}
+
+		ArrayHelper.RemoveValues(LastIndex, 1);
+		ItemIds.RemoveAtSwap(ItemIndex);
+	}
+
+	const uint32 NumChangedItems = Schema_GetInt32Count(DeltaObject, SpatialConstants::FAST_ARRAY_DELTA_ITEM_IDS_ID);
+	for (uint32 i = 0; i < NumChangedItems; i++)
+	{
+		const int32 ItemId = Schema_IndexInt32(DeltaObject, SpatialConstants::FAST_ARRAY_DELTA_ITEM_IDS_ID, i);
+
+		int32 ItemIndex = INDEX_NONE;
+		if (const int32* ExistingIndex = IdToIndex.Find(ItemId))
+		{
+			ItemIndex = *ExistingIndex;
+		}
+		else
+		{
+			ItemIndex = ArrayHelper.AddValue();
+			ItemIds.Add(ItemId);
+			IdToIndex.Add(ItemId, ItemIndex);
+		}
+
+		ApplyProperty(DeltaObject, SpatialConstants::ARRAY_DELTA_VALUES_ID, *ArrayObjectReferences, i, Property->Inner, ArrayHelper.GetRawPtr(ItemIndex), ItemIndex * ElementSize, ParentIndex);
+	}
+
+	StoreArrayObjectReferences(InObjectReferencesMap, ArrayObjectReferences, bNewArrayMap, Property, Offset, ParentIndex);
+}
+
+FObjectReferencesMap* ComponentReader::FindOrCreateArrayObjectReferences(FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, int32 Offset, int32 ParentIndex, bool& bOutNewArrayMap)
+{
+	if (FObjectReferences* ExistingEntry = InObjectReferencesMap.Find(Offset))
+	{
+		check(ExistingEntry->Array);
+		check(ExistingEntry->ParentIndex == ParentIndex && ExistingEntry->Property == Property);
+		bOutNewArrayMap = false;
+		return ExistingEntry->Array.Get();
+	}
+
+	bOutNewArrayMap = true;
+	return new FObjectReferencesMap();
+}
+
+void ComponentReader::StoreArrayObjectReferences(FObjectReferencesMap& InObjectReferencesMap, FObjectReferencesMap* ArrayObjectReferences, bool bNewArrayMap, UArrayProperty* Property, int32 Offset, int32 ParentIndex)
+{
 	if (ArrayObjectReferences->Num() > 0)
 	{
 		if (bNewArrayMap)
@@ -0,0 +1,131 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/OutgoingByteProfiler.h"
+
+#include "Misc/FileHelper.h"
+
+#include "SpatialGDKSettings.h"
+
+bool FOutgoingByteProfiler::IsEnabled() const
+{
+	return GetDefault<USpatialGDKSettings>()->bEnableOutgoingByteProfiling;
+}
+
+void FOutgoingByteProfiler::RecordObjectSend(const UClass* Class, uint32 Bytes)
+{
+	FNamedStats* Entry = ClassStats.Find(Class);
+	if (Entry == nullptr)
+	{
+		Entry = &ClassStats.Add(Class);
+		Entry->Name = Class->GetName();
+	}
+
+	Entry->Stats.Count++;
+	Entry->Stats.Bytes += Bytes;
+}
+
+void FOutgoingByteProfiler::RecordProperty(const UClass* Class, uint16 Handle, const UProperty* ParentProperty, const UProperty* Property, uint32 Bytes)
+{
+	const FPropertyKey Key{ Class, Handle };
+
+	FNamedStats* Entry = PropertyStats.Find(Key);
+	if (Entry == nullptr)
+	{
+		Entry = &PropertyStats.Add(Key);
+		Entry->Name = FString::Printf(TEXT("%s.%s"), *Class->GetName(), *ParentProperty->GetName());
+		if (Property != ParentProperty)
+		{
+			// Members of replicated structs have handles of their own.
+			Entry->Name += TEXT(".") + Property->GetName();
+		}
+	}
+
+	Entry->Stats.Count++;
+	Entry->Stats.Bytes += Bytes;
+}
+
+void FOutgoingByteProfiler::RecordRPC(const UFunction* Function, uint32 Bytes)
+{
+	FNamedStats* Entry = RPCStats.Find(Function);
+	if (Entry == nullptr)
+	{
+		Entry = &RPCStats.Add(Function);
+		Entry->Name = FString::Printf(TEXT("%s::%s"), *Function->GetOuter()->GetName(), *Function->GetName());
+	}
+
+	Entry->Stats.Count++;
+	Entry->Stats.Bytes += Bytes;
+}
+
+void FOutgoingByteProfiler::Reset()
+{
+	ClassStats.Empty();
+	PropertyStats.Empty();
+	RPCStats.Empty();
+}
+
+template <typename KeyType>
+TArray<const FOutgoingByteProfiler::FNamedStats*> FOutgoingByteProfiler::SortByBytes(const TMap<KeyType, FNamedStats>& Map)
+{
+	TArray<const FNamedStats*> Entries;
+	Entries.Reserve(Map.Num());
+	for (const auto& Pair : Map)
+	{
+		Entries.Add(&Pair.Value);
+	}
+
+	Entries.Sort([](const FNamedStats& A, const FNamedStats& B)
+	{
+		return A.Stats.Bytes > B.Stats.Bytes;
+	});
+
+	return Entries;
+}
+
+void FOutgoingByteProfiler::DumpTop(FOutputDevice& Ar, int32 NumEntries) const
+{
+	auto DumpSection = [&Ar, NumEntries](const TCHAR* Title, const TArray<const FNamedStats*>& Entries)
+	{
+		uint64 TotalBytes = 0;
+		for (const FNamedStats* Entry : Entries)
+		{
+			TotalBytes += Entry->Stats.Bytes;
+		}
+
+		Ar.Logf(TEXT("%s: %d entries, %llu bytes"), Title, Entries.Num(), TotalBytes);
+		for (int32 i = 0; i < Entries.Num() && i < NumEntries; i++)
+		{
+			const FNamedStats& Entry = *Entries[i];
+			Ar.Logf(TEXT("    %s: %llu bytes (%.1f%%), %llu sends, %.1f bytes per send"), *Entry.Name, Entry.Stats.Bytes,
+				TotalBytes > 0 ? 100.0 * Entry.Stats.Bytes / TotalBytes : 0.0, Entry.Stats.Count, Entry.Stats.Count > 0 ? (double)Entry.Stats.Bytes / Entry.Stats.Count : 0.0);
+		}
+	};
+
+	DumpSection(TEXT("Classes"), SortByBytes(ClassStats));
+	DumpSection(TEXT("Properties"), SortByBytes(PropertyStats));
+	DumpSection(TEXT("RPCs"), SortByBytes(RPCStats));
+}
+
+bool FOutgoingByteProfiler::WriteCSV(const FString& FilePath) const
+{
+	if (ClassStats.Num() == 0 && RPCStats.Num() == 0)
+	{
+		return false;
+	}
+
+	FString CSV = TEXT("Type,Name,Sends,Bytes\n");
+
+	auto WriteSection = [&CSV](const TCHAR* Type, const TArray<const FNamedStats*>& Entries)
+	{
+		for (const FNamedStats* Entry : Entries)
+		{
+			CSV += FString::Printf(TEXT("%s,%s,%llu,%llu\n"), Type, *Entry->Name, Entry->Stats.Count, Entry->Stats.Bytes);
+		}
+	};
+
+	WriteSection(TEXT("Class"), SortByBytes(ClassStats));
+	WriteSection(TEXT("Property"), SortByBytes(PropertyStats));
+	WriteSection(TEXT("RPC"), SortByBytes(RPCStats));
+
+	return FFileHelper::SaveStringToFile(CSV, *FilePath);
+}
@@ -0,0 +1,89 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/ParallelPropertyComparer.h"
+
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformAtomics.h"
+#include "Net/DataReplication.h"
+#include "Net/RepLayout.h"
+
+#include "SpatialGDKSettings.h"
+
+void FParallelPropertyComparer::AddObject(UObject* Object, FObjectReplicator& Replicator, const FReplicationFlags& RepFlags)
+{
+	AddObject(Object, *Replicator.ChangelistMgr, Replicator.RepState->LastCompareIndex, RepFlags);
+}
+
+void FParallelPropertyComparer::AddObject(UObject* Object, FReplicationChangelistMgr& ChangelistMgr, int32& LastCompareIndex, const FReplicationFlags& RepFlags)
+{
+	PendingComparisons.Add(FPendingComparison{ Object, &ChangelistMgr, &LastCompareIndex, RepFlags });
+}
+
+void FParallelPropertyComparer::Run(uint32 ReplicationFrame)
+{
+	if (PendingComparisons.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 NumObjects = PendingComparisons.Num();
+	const bool bSingleThreaded = NumObjects < (int32)GetDefault<USpatialGDKSettings>()->ParallelPropertyComparisonMinObjects;
+	const int32 NumTasks = bSingleThreaded ? 1 : FMath::Min(GetNumTasks(), NumObjects);
+
+	// Objects are handed out one at a time rather than in fixed ranges, as comparison cost varies a lot between classes.
+	volatile int32 NextObjectIndex = 0;
+	volatile int64 TotalTaskCycles = 0;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	ParallelFor(NumTasks, [this, ReplicationFrame, NumObjects, &NextObjectIndex, &TotalTaskCycles](int32 TaskIndex)
+	{
+		const uint64 TaskStartCycles = FPlatformTime::Cycles64();
+
+		for (int32 ObjectIndex = FPlatformAtomics::InterlockedIncrement(&NextObjectIndex) - 1; ObjectIndex < NumObjects; ObjectIndex = FPlatformAtomics::InterlockedIncrement(&NextObjectIndex) - 1)
+		{
+			const FPendingComparison& Comparison = PendingComparisons[ObjectIndex];
+			Comparison.ChangelistMgr->Update(Comparison.Object, ReplicationFrame, *Comparison.LastCompareIndex, Comparison.RepFlags, false);
+		}
+
+		FPlatformAtomics::InterlockedAdd(&TotalTaskCycles, (int64)(FPlatformTime::Cycles64() - TaskStartCycles));
+	}, NumTasks == 1);
+
+	Stats.NumRuns++;
+	Stats.NumObjectsCompared += NumObjects;
+	Stats.NumTasks += NumTasks;
+	Stats.WallCycles += FPlatformTime::Cycles64() - StartCycles;
+	Stats.TaskCycles += TotalTaskCycles;
+
+	PendingComparisons.Reset();
+}
+
+void FParallelPropertyComparer::SetMaxTasks(int32 InMaxTasks)
+{
+	MaxTasks = FMath::Max(InMaxTasks, 0);
+}
+
+int32 FParallelPropertyComparer::GetNumTasks() const
+{
+	const int32 AvailableThreads = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	return MaxTasks > 0 ? FMath::Min(MaxTasks, AvailableThreads) : AvailableThreads;
+}
+
+void FParallelPropertyComparer::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Parallel property comparison: up to %d tasks (%d task graph worker threads)"), GetNumTasks(), FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+	if (Stats.NumRuns == 0)
+	{
+		Ar.Logf(TEXT("    No runs yet"));
+		return;
+	}
+
+	const double WallMs = FPlatformTime::ToMilliseconds64(Stats.WallCycles);
+	const double TaskMs = FPlatformTime::ToMilliseconds64(Stats.TaskCycles);
+
+	Ar.Logf(TEXT("    Runs: %llu, %.1f objects and %.2f tasks per run"), Stats.NumRuns, (double)Stats.NumObjectsCompared / Stats.NumRuns, (double)Stats.NumTasks / Stats.NumRuns);
+	Ar.Logf(TEXT("    Wall time: %.3f ms per run, %.3f us per object"), WallMs / Stats.NumRuns, Stats.NumObjectsCompared > 0 ? WallMs * 1000.0 / Stats.NumObjectsCompared : 0.0);
+	Ar.Logf(TEXT("    Task time: %.3f ms per run, speedup over one thread: %.2fx"), TaskMs / Stats.NumRuns, WallMs > 0.0 ? TaskMs / WallMs : 0.0);
+}
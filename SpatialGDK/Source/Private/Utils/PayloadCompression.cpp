@@ -0,0 +1,195 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/PayloadCompression.h"
+
+#include "Misc/Compression.h"
+#include "Misc/ScopeLock.h"
+
+#include "SpatialGDKSettings.h"
+
+DEFINE_LOG_CATEGORY(LogSpatialPayloadCompression);
+
+namespace
+{
+
+enum class EPayloadEncoding : uint8
+{
+	Raw = 0,
+	// Followed by the uncompressed size as a uint32, then the zlib compressed payload.
+	Zlib = 1,
+};
+
+const ECompressionFlags PayloadCompressionFlags = (ECompressionFlags)(COMPRESS_ZLIB | COMPRESS_BiasSpeed);
+
+const uint32 CompressedHeaderSize = sizeof(EPayloadEncoding) + sizeof(uint32);
+
+FPayloadCompressionStats Stats;
+FCriticalSection StatsCriticalSection;
+
+void RecordRejectedPayload()
+{
+	FScopeLock StatsLock(&StatsCriticalSection);
+	Stats.NumPayloadsRejected++;
+}
+
+void AddBytes(Schema_Object* Object, Schema_FieldId Id, const uint8* Header, uint32 HeaderSize, const uint8* Data, uint32 Size)
+{
+	uint8* Buffer = Schema_AllocateBuffer(Object, HeaderSize + Size);
+	FMemory::Memcpy(Buffer, Header, HeaderSize);
+	FMemory::Memcpy(Buffer + HeaderSize, Data, Size);
+	Schema_AddBytes(Object, Id, Buffer, HeaderSize + Size);
+}
+
+}
+
+namespace improbable
+{
+
+void AddCompressiblePayloadToSchema(Schema_Object* Object, Schema_FieldId Id, const uint8* Data, uint32 Size)
+{
+	const USpatialGDKSettings* Settings = GetDefault<USpatialGDKSettings>();
+
+	if (!Settings->bEnablePayloadCompression)
+	{
+		AddBytes(Object, Id, nullptr, 0, Data, Size);
+		return;
+	}
+
+	// Initial entity data can be written from several threads at once, see ComponentFactory::CreateInitialComponentDatas.
+	FPayloadCompressionStats PayloadStats;
+	PayloadStats.NumPayloadsWritten = 1;
+
+	bool bWroteCompressed = false;
+
+	if (Size >= Settings->PayloadCompressionThreshold && Size > CompressedHeaderSize)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		TArray<uint8> CompressedData;
+		CompressedData.SetNumUninitialized(FCompression::CompressMemoryBound(PayloadCompressionFlags, Size));
+		int32 CompressedSize = CompressedData.Num();
+		const bool bCompressed = FCompression::CompressMemory(PayloadCompressionFlags, CompressedData.GetData(), CompressedSize, Data, Size);
+
+		PayloadStats.CompressCycles = FPlatformTime::Cycles64() - StartCycles;
+
+		if (bCompressed && (uint32)CompressedSize + CompressedHeaderSize < Size)
+		{
+			uint8 Header[CompressedHeaderSize];
+			Header[0] = (uint8)EPayloadEncoding::Zlib;
+			FMemory::Memcpy(Header + 1, &Size, sizeof(uint32));
+
+			AddBytes(Object, Id, Header, CompressedHeaderSize, CompressedData.GetData(), CompressedSize);
+			bWroteCompressed = true;
+
+			PayloadStats.NumPayloadsCompressed = 1;
+			PayloadStats.UncompressedBytes = Size;
+			PayloadStats.CompressedBytes = CompressedSize + CompressedHeaderSize;
+		}
+		else
+		{
+			PayloadStats.NumIncompressible = 1;
+		}
+	}
+
+	if (!bWroteCompressed)
+	{
+		const uint8 Header = (uint8)EPayloadEncoding::Raw;
+		AddBytes(Object, Id, &Header, sizeof(Header), Data, Size);
+	}
+
+	FScopeLock StatsLock(&StatsCriticalSection);
+	Stats.NumPayloadsWritten += PayloadStats.NumPayloadsWritten;
+	Stats.NumPayloadsCompressed += PayloadStats.NumPayloadsCompressed;
+	Stats.NumIncompressible += PayloadStats.NumIncompressible;
+	Stats.UncompressedBytes += PayloadStats.UncompressedBytes;
+	Stats.CompressedBytes += PayloadStats.CompressedBytes;
+	Stats.CompressCycles += PayloadStats.CompressCycles;
+}
+
+TArray<uint8> IndexCompressiblePayloadFromSchema(const Schema_Object* Object, Schema_FieldId Id, uint32 Index)
+{
+	const uint8* Bytes = (const uint8*)Schema_IndexBytes(Object, Id, Index);
+	const uint32 Length = Schema_IndexBytesLength(Object, Id, Index);
+
+	if (!GetDefault<USpatialGDKSettings>()->bEnablePayloadCompression)
+	{
+		return TArray<uint8>(Bytes, Length);
+	}
+
+	if (Length == 0)
+	{
+		UE_LOG(LogSpatialPayloadCompression, Error, TEXT("Received a payload without an encoding header. Check that all workers use the same payload compression setting."));
+		return TArray<uint8>();
+	}
+
+	switch ((EPayloadEncoding)Bytes[0])
+	{
+	case EPayloadEncoding::Raw:
+		return TArray<uint8>(Bytes + 1, Length - 1);
+	case EPayloadEncoding::Zlib:
+	{
+		if (Length < CompressedHeaderSize)
+		{
+			UE_LOG(LogSpatialPayloadCompression, Error, TEXT("Received a compressed payload of %u bytes, too short for its header. Dropping it."), Length);
+			RecordRejectedPayload();
+			return TArray<uint8>();
+		}
+
+		uint32 UncompressedSize = 0;
+		FMemory::Memcpy(&UncompressedSize, Bytes + 1, sizeof(uint32));
+
+		// The size comes from the sender, so it is checked before anything is allocated for it.
+		const uint32 MaxUncompressedSize = FMath::Min<uint32>(GetDefault<USpatialGDKSettings>()->MaxUncompressedPayloadSize, MAX_int32);
+		if (UncompressedSize > MaxUncompressedSize)
+		{
+			UE_LOG(LogSpatialPayloadCompression, Error, TEXT("Received a compressed payload claiming %u bytes uncompressed, above the %u byte limit. Dropping it."), UncompressedSize, MaxUncompressedSize);
+			RecordRejectedPayload();
+			return TArray<uint8>();
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		TArray<uint8> Payload;
+		Payload.SetNumUninitialized(UncompressedSize);
+		const bool bDecompressed = FCompression::UncompressMemory(PayloadCompressionFlags, Payload.GetData(), UncompressedSize, Bytes + CompressedHeaderSize, Length - CompressedHeaderSize);
+
+		{
+			FScopeLock StatsLock(&StatsCriticalSection);
+			Stats.NumPayloadsDecompressed++;
+			Stats.DecompressCycles += FPlatformTime::Cycles64() - StartCycles;
+		}
+
+		if (!bDecompressed)
+		{
+			RecordRejectedPayload();
+			UE_LOG(LogSpatialPayloadCompression, Error, TEXT("Failed to decompress a %u byte payload."), Length);
+			return TArray<uint8>();
+		}
+
+		return Payload;
+	}
+	}
+
+	UE_LOG(LogSpatialPayloadCompression, Error, TEXT("Received a payload with an unknown encoding header. Check that all workers use the same payload compression setting."));
+	return TArray<uint8>();
+}
+
+FPayloadCompressionStats& GetPayloadCompressionStats()
+{
+	return Stats;
+}
+
+void DumpPayloadCompressionStats(FOutputDevice& Ar)
+{
+	Ar.Logf(TEXT("Payload compression: %llu payloads written, %llu compressed, %llu at or above the threshold but incompressible"),
+		Stats.NumPayloadsWritten, Stats.NumPayloadsCompressed, Stats.NumIncompressible);
+	Ar.Logf(TEXT("    Compressed payloads: %llu bytes down to %llu bytes (ratio %.2f)"), Stats.UncompressedBytes, Stats.CompressedBytes,
+		Stats.CompressedBytes > 0 ? (double)Stats.UncompressedBytes / Stats.CompressedBytes : 0.0);
+	Ar.Logf(TEXT("    Compression: %.3f ms total, %.2f us per payload compressed or attempted"), FPlatformTime::ToMilliseconds64(Stats.CompressCycles),
+		Stats.NumPayloadsCompressed + Stats.NumIncompressible > 0 ? FPlatformTime::ToMilliseconds64(Stats.CompressCycles) * 1000.0 / (Stats.NumPayloadsCompressed + Stats.NumIncompressible) : 0.0);
+	Ar.Logf(TEXT("    Decompression: %llu payloads, %.3f ms total, %.2f us per payload"), Stats.NumPayloadsDecompressed, FPlatformTime::ToMilliseconds64(Stats.DecompressCycles),
+		Stats.NumPayloadsDecompressed > 0 ? FPlatformTime::ToMilliseconds64(Stats.DecompressCycles) * 1000.0 / Stats.NumPayloadsDecompressed : 0.0);
+	Ar.Logf(TEXT("    Rejected: %llu received payloads truncated, oversized or undecodable"), Stats.NumPayloadsRejected);
+}
+
+}
@@ -0,0 +1,169 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/PushModelTracker.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "SpatialGDKSettings.h"
+#include "Utils/EntityRegistry.h"
+
+namespace
+{
+FPushModelTracker* GetTracker(const UObject* Object)
+{
+	if (Object == nullptr)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = Object->GetWorld();
+	if (World == nullptr)
+	{
+		return nullptr;
+	}
+
+	USpatialNetDriver* NetDriver = Cast<USpatialNetDriver>(World->GetNetDriver());
+	if (NetDriver == nullptr || !NetDriver->IsServer())
+	{
+		return nullptr;
+	}
+
+	return &NetDriver->PushModelTracker;
+}
+}
+
+namespace improbable
+{
+namespace PushModel
+{
+void MarkPropertyDirty(UObject* Object, const UProperty* Property)
+{
+	if (FPushModelTracker* Tracker = GetTracker(Object))
+	{
+		Tracker->MarkPropertyDirty(Object, Property);
+	}
+}
+
+void MarkPropertyDirty(UObject* Object, FName PropertyName)
+{
+	if (FPushModelTracker* Tracker = GetTracker(Object))
+	{
+		UProperty* Property = FindField<UProperty>(Object->GetClass(), PropertyName);
+		if (Property == nullptr)
+		{
+			UE_LOG(LogSpatialOSNetDriver, Warning, TEXT("MarkPropertyDirty: %s has no property named %s"), *Object->GetName(), *PropertyName.ToString());
+			Tracker->MarkObjectDirty(Object);
+			return;
+		}
+
+		Tracker->MarkPropertyDirty(Object, Property);
+	}
+}
+
+void MarkObjectDirty(UObject* Object)
+{
+	if (FPushModelTracker* Tracker = GetTracker(Object))
+	{
+		Tracker->MarkObjectDirty(Object);
+	}
+}
+}
+}
+
+void FPushModelTracker::MarkPropertyDirty(const UObject* Object, const UProperty* Property)
+{
+	if ((Property->PropertyFlags & CPF_Net) == 0)
+	{
+		return;
+	}
+
+	MarkObjectDirty(Object);
+}
+
+void FPushModelTracker::MarkObjectDirty(const UObject* Object)
+{
+	if (!ShouldTrack(Object))
+	{
+		return;
+	}
+
+	DirtyObjects.Add(Object);
+}
+
+bool FPushModelTracker::ConsumeDirtyState(const UObject* Object)
+{
+	return DirtyObjects.Remove(Object) > 0;
+}
+
+void FPushModelTracker::Remove(const UObject* Object)
+{
+	DirtyObjects.Remove(Object);
+}
+
+void FPushModelTracker::PruneObjectsWithoutChannels(USpatialNetDriver* NetDriver)
+{
+	// Without an entity registry no actor can have a channel yet.
+	UEntityRegistry* EntityRegistry = NetDriver->GetEntityRegistry();
+
+	for (auto It = DirtyObjects.CreateIterator(); It; ++It)
+	{
+		const UObject* Object = It->Get();
+		const AActor* Actor = Cast<AActor>(Object);
+		if (Actor == nullptr && Object != nullptr)
+		{
+			Actor = Object->GetTypedOuter<AActor>();
+		}
+
+		if (Actor == nullptr || EntityRegistry == nullptr || NetDriver->GetActorChannelByEntityId(EntityRegistry->GetEntityIdFromActor(Actor)) == nullptr)
+		{
+			It.RemoveCurrent();
+			Stats.NumPrunedObjects++;
+		}
+	}
+}
+
+bool FPushModelTracker::IsPushModelClass(const UClass* ActorClass)
+{
+	if (bool* bCachedResult = PushModelClassCache.Find(ActorClass))
+	{
+		return *bCachedResult;
+	}
+
+	bool bIsPushModelClass = false;
+
+	const USpatialGDKSettings* Settings = GetDefault<USpatialGDKSettings>();
+	if (Settings->bEnablePushModel)
+	{
+		for (const UClass* Class = ActorClass; Class != nullptr && !bIsPushModelClass; Class = Class->GetSuperClass())
+		{
+			bIsPushModelClass = Settings->PushModelActorClasses.Contains(TSoftClassPtr<AActor>(Class));
+		}
+	}
+
+	PushModelClassCache.Add(ActorClass, bIsPushModelClass);
+	return bIsPushModelClass;
+}
+
+bool FPushModelTracker::ShouldTrack(const UObject* Object)
+{
+	const AActor* Actor = Cast<AActor>(Object);
+	if (Actor == nullptr)
+	{
+		Actor = Object->GetTypedOuter<AActor>();
+	}
+
+	return Actor != nullptr && IsPushModelClass(Actor->GetClass());
+}
+
+void FPushModelTracker::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Push model: %d objects with dirty properties"), DirtyObjects.Num());
+	Ar.Logf(TEXT("    Skipped (clean) objects: %llu"), Stats.NumSkippedObjects);
+	Ar.Logf(TEXT("    Pruned objects without a channel: %llu"), Stats.NumPrunedObjects);
+	Ar.Logf(TEXT("    Push compares: %llu, %.3f us average"),
+		Stats.NumPushCompares, Stats.NumPushCompares > 0 ? FPlatformTime::ToMilliseconds64(Stats.PushCompareCycles) * 1000.0 / Stats.NumPushCompares : 0.0);
+	Ar.Logf(TEXT("    Full compares: %llu, %.3f us average"),
+		Stats.NumFullCompares, Stats.NumFullCompares > 0 ? FPlatformTime::ToMilliseconds64(Stats.FullCompareCycles) * 1000.0 / Stats.NumFullCompares : 0.0);
+}
@@ -7,6 +7,30 @@
 namespace improbable
 {
 
+void AddObjectRefToSchema(Schema_Object* Object, Schema_FieldId Id, const FUnrealObjectRef& ObjectRef, UObjectRefPathDictionary* PathDictionary /*= nullptr*/)
+{
+	Schema_Object* ObjectRefObject = Schema_AddObject(Object, Id);
+
+	Schema_AddEntityId(ObjectRefObject, 1, ObjectRef.Entity);
+	Schema_AddUint32(ObjectRefObject, 2, ObjectRef.Offset);
+	if (ObjectRef.Path)
+	{
+		uint32 PathId;
+		if (PathDictionary != nullptr && PathDictionary->FindOrRequestPathId(*ObjectRef.Path, PathId))
+		{
+			Schema_AddUint32(ObjectRefObject, 5, PathId);
+		}
+		else
+		{
+			AddStringToSchema(ObjectRefObject, 3, *ObjectRef.Path);
+		}
+	}
+	if (ObjectRef.Outer)
+	{
+		AddObjectRefToSchema(ObjectRefObject, 4, *ObjectRef.Outer, PathDictionary);
+	}
+}
+
 void GetFullPathFromUnrealObjectReference(const FUnrealObjectRef& ObjectRef, FString& OutPath)
 {
 	if (!ObjectRef.Path.IsSet())
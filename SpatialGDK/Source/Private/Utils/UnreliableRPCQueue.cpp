@@ -0,0 +1,96 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/UnreliableRPCQueue.h"
+
+#include "Containers/BitArray.h"
+
+#include "Interop/SpatialSender.h"
+#include "SpatialGDKSettings.h"
+
+void FUnreliableRPCQueue::Enqueue(TSharedRef<FPendingRPCParams> Params)
+{
+	const FSpatialUnreliableRPCSettings& RPCSettings = GetDefault<USpatialGDKSettings>()->GetUnreliableRPCSettings(Params->Function);
+
+	Queue.Add(FQueuedRPC{ Params, RPCSettings.Priority, FPlatformTime::Seconds() + RPCSettings.MaxAge });
+	Stats.FindOrAdd(Params->Function).Queued++;
+}
+
+void FUnreliableRPCQueue::Flush(uint32 MaxRPCs, TFunctionRef<void(TSharedRef<FPendingRPCParams>)> SendRPC)
+{
+	if (Queue.Num() == 0)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	Queue.RemoveAll([this, Now](const FQueuedRPC& QueuedRPC)
+	{
+		if (QueuedRPC.ExpiryTime < Now)
+		{
+			Stats.FindOrAdd(QueuedRPC.Params->Function).Dropped++;
+			return true;
+		}
+		return false;
+	});
+
+	TBitArray<> bSendThisTick(true, Queue.Num());
+
+	if (MaxRPCs > 0 && (uint32)Queue.Num() > MaxRPCs)
+	{
+		// Pick the highest priority RPCs. The sort is stable, so among equal priorities the oldest are picked first.
+		TArray<int32> QueueIndices;
+		QueueIndices.Reserve(Queue.Num());
+		for (int32 i = 0; i < Queue.Num(); i++)
+		{
+			QueueIndices.Add(i);
+		}
+
+		QueueIndices.StableSort([this](int32 A, int32 B)
+		{
+			return Queue[A].Priority > Queue[B].Priority;
+		});
+
+		for (int32 i = MaxRPCs; i < QueueIndices.Num(); i++)
+		{
+			bSendThisTick[QueueIndices[i]] = false;
+		}
+	}
+
+	TArray<FQueuedRPC> DeferredRPCs;
+	for (int32 i = 0; i < Queue.Num(); i++)
+	{
+		FUnreliableRPCStats& FunctionStats = Stats.FindOrAdd(Queue[i].Params->Function);
+
+		if (bSendThisTick[i])
+		{
+			SendRPC(Queue[i].Params);
+			FunctionStats.Sent++;
+		}
+		else
+		{
+			DeferredRPCs.Add(Queue[i]);
+			FunctionStats.Deferred++;
+		}
+	}
+
+	Queue = MoveTemp(DeferredRPCs);
+}
+
+void FUnreliableRPCQueue::DumpStats(FOutputDevice& Ar) const
+{
+	TArray<const UFunction*> Functions;
+	Stats.GetKeys(Functions);
+	Functions.Sort([this](const UFunction& A, const UFunction& B)
+	{
+		return Stats[&A].Dropped > Stats[&B].Dropped;
+	});
+
+	Ar.Logf(TEXT("Unreliable RPC queue: %d queued"), Queue.Num());
+	for (const UFunction* Function : Functions)
+	{
+		const FUnreliableRPCStats& FunctionStats = Stats[Function];
+		Ar.Logf(TEXT("    %s::%s: queued %llu, sent %llu, deferred %llu, dropped %llu (%.1f%%)"), *Function->GetOuter()->GetName(), *Function->GetName(),
+			FunctionStats.Queued, FunctionStats.Sent, FunctionStats.Deferred, FunctionStats.Dropped, FunctionStats.Queued > 0 ? 100.0 * FunctionStats.Dropped / FunctionStats.Queued : 0.0);
+	}
+}
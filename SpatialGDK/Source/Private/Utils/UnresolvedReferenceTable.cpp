@@ -0,0 +1,194 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/UnresolvedReferenceTable.h"
+
+template <typename T>
+int32 FUnresolvedReferenceTable::AllocateSlot(TArray<T>& Slots, int32& FirstFree)
+{
+	if (FirstFree == INDEX_NONE)
+	{
+		return Slots.AddDefaulted();
+	}
+
+	int32 Index = FirstFree;
+	FirstFree = Slots[Index].NextFree;
+	Slots[Index].NextFree = INDEX_NONE;
+	return Index;
+}
+
+template <typename T>
+void FUnresolvedReferenceTable::ReleaseSlot(TArray<T>& Slots, int32& FirstFree, int32 Index)
+{
+	Slots[Index].NextFree = FirstFree;
+	FirstFree = Index;
+}
+
+void FUnresolvedReferenceTable::Add(const FChannelObjectPair& ChannelObjectPair, uint16 Handle, bool bIsDynamicArray, const TSet<const UObject*>& UnresolvedObjects)
+{
+	Remove(ChannelObjectPair, Handle);
+
+	if (UnresolvedObjects.Num() == 0)
+	{
+		return;
+	}
+
+	int32 PropertyIndex = AllocateSlot(PropertySlots, FirstFreePropertySlot);
+	{
+		FPropertySlot& PropertySlot = PropertySlots[PropertyIndex];
+		PropertySlot.Property.ChannelObjectPair = ChannelObjectPair;
+		PropertySlot.Property.Handle = Handle;
+		PropertySlot.Property.bIsDynamicArray = bIsDynamicArray;
+		PropertySlot.FirstLink = INDEX_NONE;
+		PropertySlot.NumUnresolved = UnresolvedObjects.Num();
+	}
+
+	for (const UObject* Object : UnresolvedObjects)
+	{
+		int32 ObjectIndex = FindOrAddObjectSlot(Object);
+		int32 LinkIndex = AllocateSlot(Links, FirstFreeLink);
+
+		// Slot arrays may have grown, so take references only after allocating.
+		FLink& Link = Links[LinkIndex];
+		FPropertySlot& PropertySlot = PropertySlots[PropertyIndex];
+		FObjectSlot& ObjectSlot = ObjectSlots[ObjectIndex];
+
+		Link.PropertyIndex = PropertyIndex;
+		Link.ObjectIndex = ObjectIndex;
+
+		Link.NextInProperty = PropertySlot.FirstLink;
+		PropertySlot.FirstLink = LinkIndex;
+
+		Link.PrevInObject = INDEX_NONE;
+		Link.NextInObject = ObjectSlot.FirstLink;
+		if (ObjectSlot.FirstLink != INDEX_NONE)
+		{
+			Links[ObjectSlot.FirstLink].PrevInObject = LinkIndex;
+		}
+		ObjectSlot.FirstLink = LinkIndex;
+	}
+
+	PropertyKeyToHandle.Add(FPropertyKey(ChannelObjectPair, Handle), FPropertyHandle{ PropertyIndex, PropertySlots[PropertyIndex].Generation });
+}
+
+void FUnresolvedReferenceTable::Remove(const FChannelObjectPair& ChannelObjectPair, uint16 Handle)
+{
+	FPropertyHandle PropertyHandle;
+	if (!PropertyKeyToHandle.RemoveAndCopyValue(FPropertyKey(ChannelObjectPair, Handle), PropertyHandle))
+	{
+		return;
+	}
+
+	check(PropertySlots[PropertyHandle.Index].Generation == PropertyHandle.Generation);
+	ReleaseProperty(PropertyHandle.Index);
+}
+
+void FUnresolvedReferenceTable::Resolve(const UObject* Object, TArray<FPendingOutgoingProperty>& OutReadyProperties)
+{
+	int32 ObjectIndex;
+	if (!ObjectToSlot.RemoveAndCopyValue(Object, ObjectIndex))
+	{
+		return;
+	}
+
+	int32 LinkIndex = ObjectSlots[ObjectIndex].FirstLink;
+	while (LinkIndex != INDEX_NONE)
+	{
+		FLink& Link = Links[LinkIndex];
+		int32 NextLinkIndex = Link.NextInObject;
+
+		// Detach the link from the object. It stays in its property's list until the property is released.
+		Link.ObjectIndex = INDEX_NONE;
+		Link.PrevInObject = INDEX_NONE;
+		Link.NextInObject = INDEX_NONE;
+
+		FPropertySlot& PropertySlot = PropertySlots[Link.PropertyIndex];
+		if (--PropertySlot.NumUnresolved == 0)
+		{
+			OutReadyProperties.Add(PropertySlot.Property);
+			PropertyKeyToHandle.Remove(FPropertyKey(PropertySlot.Property.ChannelObjectPair, PropertySlot.Property.Handle));
+			ReleaseProperty(Link.PropertyIndex);
+		}
+
+		LinkIndex = NextLinkIndex;
+	}
+
+	FObjectSlot& ObjectSlot = ObjectSlots[ObjectIndex];
+	ObjectSlot.Object = nullptr;
+	ObjectSlot.FirstLink = INDEX_NONE;
+	ReleaseSlot(ObjectSlots, FirstFreeObjectSlot, ObjectIndex);
+}
+
+int32 FUnresolvedReferenceTable::FindOrAddObjectSlot(const UObject* Object)
+{
+	if (int32* ExistingIndex = ObjectToSlot.Find(Object))
+	{
+		return *ExistingIndex;
+	}
+
+	int32 ObjectIndex = AllocateSlot(ObjectSlots, FirstFreeObjectSlot);
+	ObjectSlots[ObjectIndex].Object = Object;
+	ObjectSlots[ObjectIndex].FirstLink = INDEX_NONE;
+	ObjectToSlot.Add(Object, ObjectIndex);
+	return ObjectIndex;
+}
+
+void FUnresolvedReferenceTable::UnlinkFromObject(int32 LinkIndex)
+{
+	FLink& Link = Links[LinkIndex];
+	if (Link.ObjectIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FObjectSlot& ObjectSlot = ObjectSlots[Link.ObjectIndex];
+
+	if (Link.PrevInObject != INDEX_NONE)
+	{
+		Links[Link.PrevInObject].NextInObject = Link.NextInObject;
+	}
+	else
+	{
+		ObjectSlot.FirstLink = Link.NextInObject;
+	}
+
+	if (Link.NextInObject != INDEX_NONE)
+	{
+		Links[Link.NextInObject].PrevInObject = Link.PrevInObject;
+	}
+
+	// Nothing depends on this object any more, so stop tracking it.
+	if (ObjectSlot.FirstLink == INDEX_NONE)
+	{
+		ObjectToSlot.Remove(ObjectSlot.Object);
+		ObjectSlot.Object = nullptr;
+		ReleaseSlot(ObjectSlots, FirstFreeObjectSlot, Link.ObjectIndex);
+	}
+
+	Link.ObjectIndex = INDEX_NONE;
+	Link.PrevInObject = INDEX_NONE;
+	Link.NextInObject = INDEX_NONE;
+}
+
+void FUnresolvedReferenceTable::ReleaseProperty(int32 PropertyIndex)
+{
+	FPropertySlot& PropertySlot = PropertySlots[PropertyIndex];
+
+	int32 LinkIndex = PropertySlot.FirstLink;
+	while (LinkIndex != INDEX_NONE)
+	{
+		UnlinkFromObject(LinkIndex);
+
+		int32 NextLinkIndex = Links[LinkIndex].NextInProperty;
+		Links[LinkIndex].PropertyIndex = INDEX_NONE;
+		Links[LinkIndex].NextInProperty = INDEX_NONE;
+		ReleaseSlot(Links, FirstFreeLink, LinkIndex);
+
+		LinkIndex = NextLinkIndex;
+	}
+
+	PropertySlot.Property.ChannelObjectPair = FChannelObjectPair();
+	PropertySlot.FirstLink = INDEX_NONE;
+	PropertySlot.NumUnresolved = 0;
+	PropertySlot.Generation++;
+	ReleaseSlot(PropertySlots, FirstFreePropertySlot, PropertyIndex);
+}
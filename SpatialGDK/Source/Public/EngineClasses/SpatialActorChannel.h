@@ -7,6 +7,8 @@
 #include "EngineClasses/SpatialNetDriver.h"
 #include "Interop/SpatialStaticComponentView.h"
 #include "Interop/SpatialTypebindingManager.h"
+#include "SpatialGDKSettings.h"
+#include "Utils/ParallelPropertyComparer.h"
 #include "Utils/RepDataUtils.h"
 
 #include <WorkerSDK/improbable/c_worker.h>
@@ -46,6 +48,12 @@ public:
 		return Actor->Role == ROLE_Authority;
 	}
 
+	// Whether the actor can stop replicating until its dormancy is flushed. Everything changed so far must have been sent.
+	FORCEINLINE bool IsReadyForSpatialDormancy() const
+	{
+		return IsReadyForReplication() && !bCreatingNewEntity;
+	}
+
 	// Called on the client when receiving an update.
 	FORCEINLINE bool IsClientAutonomousProxy()
 	{
@@ -83,10 +91,17 @@ public:
 	virtual int64 ReplicateActor() override;
 	virtual void SetChannelActor(AActor* InActor) override;
 
+	// Dormancy is handled by USpatialNetDriver without closing the channel, as closing it would delete the entity.
+	virtual bool ReadyForDormancy(bool bSuppressLogs = false) override { return false; }
+
 	void RegisterEntityId(const Worker_EntityId& ActorEntityId);
 	bool ReplicateSubobject(UObject* Obj, FClassInfo* Info, const FReplicationFlags& RepFlags);
 	virtual bool ReplicateSubobject(UObject* Obj, FOutBunch& Bunch, const FReplicationFlags& RepFlags) override;
 
+	// Queues the property comparisons of this channel's actor and its replicated components, so they can run in parallel
+	// with other channels' before ReplicateActor is called in the same replication frame.
+	void AddParallelPropertyComparisons(FParallelPropertyComparer& Comparer);
+
 	TMap<UObject*, FClassInfo*> GetHandoverSubobjects();
 
 	FRepChangeState CreateInitialRepChangeState(UObject* Object);
@@ -95,6 +110,21 @@ public:
 	// For an object that is replicated by this channel (i.e. this channel's actor or its component), find out whether a given handle is an array.
 	bool IsDynamicArrayHandle(UObject* Object, uint16 Handle);
 
+	FORCEINLINE FArrayDeltaStates& GetArrayDeltaStates(UObject* Object)
+	{
+		return ArrayDeltaStatesMap.FindOrAdd(Object);
+	}
+
+	FORCEINLINE FFieldValueHashes& GetFieldValueHashes(UObject* Object)
+	{
+		return FieldValueHashesMap.FindOrAdd(Object);
+	}
+
+	FORCEINLINE FFastArrayItemIds& GetFastArrayItemIds(UObject* Object)
+	{
+		return FastArrayItemIdsMap.FindOrAdd(Object);
+	}
+
 	void SpatialViewTick();
 	FObjectReplicator& PreReceiveSpatialUpdate(UObject* TargetObject);
 	void PostReceiveSpatialUpdate(UObject* TargetObject, const TArray<UProperty*>& RepNotifies);
@@ -113,9 +143,16 @@ private:
 	bool IsSingletonEntity();
 	bool IsStablyNamedEntity();
 
+	void OnEntityIdReserved(Worker_EntityId ReservedEntityId);
+
+	FReplicationFlags GetReplicationFlags() const;
+
 	void UpdateSpatialPosition();
 	void UpdateSpatialRotation();
 
+	// Runs the rep layout comparison for an object. For push model actors, objects with nothing marked dirty are skipped.
+	void CompareObjectProperties(UObject* Object, FObjectReplicator& Replicator, const FReplicationFlags& RepFlags);
+
 	void InitializeHandoverShadowData(TArray<uint8>& ShadowData, UObject* Object);
 	FHandoverChangeState GetHandoverChangeList(TArray<uint8>& ShadowData, UObject* Object);
 
@@ -135,6 +172,17 @@ private:
 
 	FVector LastSpatialPosition;
 	FRotator LastSpatialRotation;
+	float LastSpatialPositionUpdateTime;
+
+	// Thresholds and rate limit for this actor's class, resolved when the actor is set.
+	FSpatialTransformUpdateSettings TransformUpdateSettings;
+
+	// Whether this actor's class uses push model replication, resolved when the actor is set.
+	bool bUsePushModel;
+
+	// Set for replications that compare all properties of a push model actor, e.g. to pick up properties that weren't marked dirty.
+	bool bIsPushModelFullCompare;
+	float LastPushModelFullCompareTime;
 
 	// Shadow data for Handover properties.
 	// For each object with handover properties, we store a blob of memory which contains
@@ -143,6 +191,15 @@ private:
 	TArray<uint8>* ActorHandoverShadowData;
 	TMap<TWeakObjectPtr<UObject>, TSharedRef<TArray<uint8>>> HandoverShadowDataMap;
 
+	// Array delta encoding state for each object replicated by this channel.
+	TMap<TWeakObjectPtr<UObject>, FArrayDeltaStates> ArrayDeltaStatesMap;
+
+	// Hashes of the field values last sent for each object replicated by this channel.
+	TMap<TWeakObjectPtr<UObject>, FFieldValueHashes> FieldValueHashesMap;
+
+	// Item IDs of the FastArraySerializer arrays received for each object replicated by this channel.
+	TMap<TWeakObjectPtr<UObject>, FFastArrayItemIds> FastArrayItemIdsMap;
+
 	// If this actor channel is responsible for creating a new entity, this will be set to true during initial replication.
 	bool bCreatingNewEntity;
 };
@@ -6,12 +6,14 @@
 #include "UObject/CoreNet.h"
 #include "UObject/improbable/UnrealObjectRef.h"
 
+class UObjectRefPathDictionary;
 class USpatialPackageMapClient;
 
 class SPATIALGDK_API FSpatialNetBitWriter : public FNetBitWriter
 {
 public:
-	FSpatialNetBitWriter(USpatialPackageMapClient* InPackageMap, TSet<const UObject*>& InUnresolvedObjects);
+	// With a PathDictionary, paths in the dictionary are written as their ID. Only pass one when the payload is only read by servers.
+	FSpatialNetBitWriter(USpatialPackageMapClient* InPackageMap, TSet<const UObject*>& InUnresolvedObjects, UObjectRefPathDictionary* InPathDictionary = nullptr);
 
 	using FArchive::operator<<; // For visibility of the overloads we don't override
 
@@ -23,4 +25,6 @@ protected:
 	void SerializeObjectRef(FUnrealObjectRef& ObjectRef);
 
 	TSet<const UObject*>& UnresolvedObjects;
+
+	UObjectRefPathDictionary* PathDictionary;
 };
@@ -20,6 +20,7 @@ public:
 	virtual void LowLevelSend(void* Data, int32 CountBytes, int32 CountBits) override;
 	virtual bool ClientHasInitializedLevelFor(const AActor* TestActor) const override;
 	virtual void Tick() override;
+	virtual void FlushDormancy(class AActor* Actor) override;
 
 	// These functions don't make a lot of sense in a SpatialOS implementation.
 	virtual FString LowLevelGetRemoteAddress(bool bAppendPort = false) override { return TEXT(""); }
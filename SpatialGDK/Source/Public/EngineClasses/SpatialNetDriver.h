@@ -10,6 +10,10 @@
 #include "Interop/Connection/ConnectionConfig.h"
 #include "Interop/SpatialOutputDevice.h"
 #include "SpatialConstants.h"
+#include "Utils/OutgoingByteProfiler.h"
+#include "Utils/ParallelPropertyComparer.h"
+#include "Utils/PushModelTracker.h"
+#include "Utils/UnreliableRPCQueue.h"
 
 #include <WorkerSDK/improbable/c_worker.h>
 
@@ -28,11 +32,27 @@ class UGlobalStateManager;
 class USpatialPlayerSpawner;
 class USpatialStaticComponentView;
 class USnapshotManager;
+class USpatialEntityPool;
+class USpatialReplicationScheduler;
+class UObjectRefPathDictionary;
 
 class UEntityRegistry;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialOSNetDriver, Log, All);
 
+struct FReplicationBandwidthStats
+{
+	uint64 NumTicks = 0;
+	uint64 BytesReplicated = 0;
+	uint64 PeakBytesPerTick = 0;
+	uint64 NumTicksOverBudget = 0;
+	uint64 NumActorsDeferred = 0;
+	// Actors left out of the parallel comparison because the budget was expected to run out before reaching them.
+	uint64 NumActorsNotPrecompared = 0;
+	// Sender total when the stats were last reset, to tell RPCs and other sends apart from replication.
+	uint64 SenderBytesAtReset = 0;
+};
+
 class FSpatialWorkerUniqueNetId : public FUniqueNetId
 {
 public:
@@ -68,10 +88,28 @@ public:
 	virtual void TickFlush(float DeltaTime) override;
 	virtual bool IsLevelInitializedForActor(const AActor* InActor, const UNetConnection* InConnection) const override;
 	virtual void NotifyActorDestroyed(AActor* Actor, bool IsSeamlessTravel = false) override;
+	virtual void NotifyActorDormancyChange(AActor* Actor, ENetDormancy OldDormancyState) override;
+	virtual void Shutdown() override;
 	// End UNetDriver interface.
 
 #if !UE_BUILD_SHIPPING
 	bool HandleNetDumpCrossServerRPCCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpEntityPoolCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpTransformUpdateStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpArrayDeltaStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpPushModelStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpReplicationSchedulerCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpParallelCompareStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleSetParallelCompareTasksCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpBandwidthStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpOutgoingBytesCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpFieldValueHashStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpMulticastRPCStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpUnreliableRPCStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpCompressionStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpObjectRefPathStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpNetGUIDCacheStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleDumpTypebindingStatsCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 #endif
 
 	// Returns the "100% reliable" connection to SpatialOS.
@@ -120,9 +158,21 @@ public:
 	UEntityRegistry* EntityRegistry;
 	UPROPERTY()
 	USnapshotManager* SnapshotManager;
+	UPROPERTY()
+	USpatialEntityPool* EntityPool;
+	UPROPERTY()
+	USpatialReplicationScheduler* ReplicationScheduler;
+	UPROPERTY()
+	UObjectRefPathDictionary* ObjectRefPathDictionary;
 
 	TMap<UClass*, TPair<AActor*, USpatialActorChannel*>> SingletonActorChannels;
 
+	// Properties marked dirty by game code for push model actors.
+	FPushModelTracker PushModelTracker;
+
+	// Bytes sent per class, property and RPC, when enabled in the settings.
+	FOutgoingByteProfiler OutgoingByteProfiler;
+
 	bool IsAuthoritativeDestructionAllowed() const { return bAuthoritativeDestruction; }
 	void StartIgnoringAuthoritativeDestruction() { bAuthoritativeDestruction = false; }
 	void StopIgnoringAuthoritativeDestruction() { bAuthoritativeDestruction = true; }
@@ -141,6 +191,18 @@ private:
 	bool bWaitingForAcceptingPlayersToSpawn;
 	FString SnapshotToLoad;
 
+	// Compares the properties of actors due for replication in parallel, before they are replicated on the game thread.
+	FParallelPropertyComparer ParallelPropertyComparer;
+
+	// Bits written by ReplicateActor during the current ServerReplicateActors, checked against MaxReplicationBytesPerTick.
+	int64 ReplicationBitsThisTick;
+	// Moving average of the bits written per ReplicateActor call, used to estimate how many actors the budget will reach.
+	float AverageReplicationBitsPerActor;
+	FReplicationBandwidthStats BandwidthStats;
+
+	// Unreliable RPCs called during the frame, sent at the start of TickFlush when bQueueUnreliableRPCs is set.
+	FUnreliableRPCQueue UnreliableRPCQueue;
+
 	UFUNCTION()
 	void OnMapLoaded(UWorld* LoadedWorld);
 
@@ -158,7 +220,9 @@ private:
 	//SpatialGDK: These functions all exist in UNetDriver, but we need to modify/simplify them in certain ways.
 	// Could have marked them virtual in base class but that's a pointless source change as these functions are not meant to be called from anywhere except USpatialNetDriver::ServerReplicateActors.
 	int32 ServerReplicateActors_PrepConnections(const float DeltaSeconds);
+	void ServerReplicateActors_BuildScheduledConsiderList(TArray<FNetworkObjectInfo*>& OutConsiderList);
 	int32 ServerReplicateActors_PrioritizeActors(UNetConnection* Connection, const TArray<FNetViewer>& ConnectionViewers, const TArray<FNetworkObjectInfo*> ConsiderList, const bool bCPUSaturated, FActorPriority*& OutPriorityList, FActorPriority**& OutPriorityActors);
+	void ServerReplicateActors_CompareProperties(FActorPriority** PriorityActors, const int32 FinalSortedCount);
 	int32 ServerReplicateActors_ProcessPrioritizedActors(UNetConnection* Connection, const TArray<FNetViewer>& ConnectionViewers, FActorPriority** PriorityActors, const int32 FinalSortedCount, int32& OutUpdated);
 #endif
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Queue.h"
 #include "Engine/PackageMapClient.h"
 
 #include "Schema/UnrealMetadata.h"
@@ -25,6 +26,13 @@ public:
 	void RemoveEntityActor(Worker_EntityId EntityId);
 
 	FNetworkGUID ResolveStablyNamedObject(UObject* Object);
+
+	// Queues the non-replicated, stably named actors of the world's loaded levels and their stably named components,
+	// so their object refs can be registered ahead of the first references to them.
+	void QueueStablyNamedObjectRegistration(UWorld* World);
+	// Registers queued objects until TimeBudgetSeconds is used up, or all of them if it is 0.
+	void RegisterQueuedStablyNamedObjects(double TimeBudgetSeconds);
+	bool HasQueuedStablyNamedObjects() const { return NextQueuedStablyNamedObject < QueuedStablyNamedObjects.Num(); }
 	
 	FUnrealObjectRef GetUnrealObjectRefFromNetGUID(const FNetworkGUID& NetGUID) const;
 	FNetworkGUID GetNetGUIDFromUnrealObjectRef(const FUnrealObjectRef& ObjectRef) const;
@@ -38,6 +46,25 @@ public:
 private:
 	UPROPERTY()
 	USpatialTypebindingManager* TypebindingManager;
+
+	TArray<TWeakObjectPtr<UObject>> QueuedStablyNamedObjects;
+	int32 NextQueuedStablyNamedObject = 0;
+
+	// Registration timings, logged once the queue is empty.
+	double StablyNamedGatherSeconds = 0.0;
+	double StablyNamedRegisterSeconds = 0.0;
+	int32 StablyNamedRegistrationSlices = 0;
+};
+
+struct FSpatialNetGUIDCacheStats
+{
+	uint64 NumEntitiesRemoved = 0;
+	uint64 NumNetGUIDsReleased = 0;
+	uint64 NumNetGUIDsRecycled = 0;
+	// Released NetGUIDs whose object was still alive when they left quarantine, so were never reused.
+	uint64 NumNetGUIDsStillInUse = 0;
+	// Released NetGUIDs an engine replicator was still waiting to map when they left quarantine, so were never reused.
+	uint64 NumNetGUIDsStillReferenced = 0;
 };
 
 class SPATIALGDK_API FSpatialNetGUIDCache : public FNetGUIDCache
@@ -49,23 +76,58 @@ public:
 	void RemoveEntityNetGUID(Worker_EntityId EntityId);
 	void RemoveNetGUID(const FNetworkGUID& NetGUID);
 
+	void DumpStats(FOutputDevice& Ar) const;
+	void ResetStats();
+
 	FNetworkGUID AssignNewStablyNamedObjectNetGUID(UObject* Object);
 	
 	FNetworkGUID GetNetGUIDFromUnrealObjectRef(const FUnrealObjectRef& ObjectRef);
 	FUnrealObjectRef GetUnrealObjectRefFromNetGUID(const FNetworkGUID& NetGUID) const;
 	FNetworkGUID GetNetGUIDFromEntityId(Worker_EntityId EntityId) const;
 
+	// Called when the object ref path dictionary is rebuilt, after which its path IDs can mean different paths.
+	void ClearReceivedPathRefs();
+
 private:
 	void NetworkRemapObjectRefPaths(FUnrealObjectRef& ObjectRef) const;
 	FNetworkGUID GetNetGUIDFromUnrealObjectRefInternal(const FUnrealObjectRef& ObjectRef);
 
 	FNetworkGUID GetOrAssignNetGUID_SpatialGDK(UObject* Object);
+	void RegisterLocalNetGUID(const FNetworkGUID& NetGUID, UObject* Object);
 	void RegisterObjectRef(FNetworkGUID NetGUID, const FUnrealObjectRef& ObjectRef);
+
+	// Like GetOrAssignNetGUID_SpatialGDK, but hands out a recycled NetGUID to dynamic objects when one is available.
+	FNetworkGUID GetOrAssignEntityObjectNetGUID(UObject* Object);
+	void ReleaseNetGUID(const FNetworkGUID& NetGUID);
+	bool PopRecycledNetGUID(FNetworkGUID& OutNetGUID);
 	
 	FNetworkGUID RegisterNetGUIDFromPath(const FString& PathName, const FNetworkGUID& OuterGUID);
 	FNetworkGUID GenerateNewNetGUID(const int32 IsStatic);
 
 	TMap<FNetworkGUID, FUnrealObjectRef> NetGUIDToUnrealObjectRef;
 	TMap<FUnrealObjectRef, FNetworkGUID> UnrealObjectRefToNetGUID;
+
+	// Refs with paths as they were received, before placeholder substitution and remapping, to the NetGUID they resolved to.
+	// Only refs that aren't inside an entity and resolved to a loaded object are cached, as those are never removed.
+	// Refs with interned path placeholders aren't cached, as path IDs are reused when the dictionary is rebuilt.
+	TMap<FUnrealObjectRef, FNetworkGUID> ReceivedPathRefToNetGUID;
+
+	// The NetGUIDs registered for each entity's actor, its subobjects and any path refs inside it, so they can all be
+	// removed with the entity without looking up its actor or class info.
+	TMap<Worker_EntityId, TArray<FNetworkGUID>> EntityNetGUIDs;
+
+	struct FQuarantinedNetGUID
+	{
+		FNetworkGUID NetGUID;
+		double ReleaseTime;
+	};
+
+	// Released NetGUIDs wait out NetGUIDRecycleDelay before being reused, so late references to the removed objects
+	// can't resolve to the objects that replace them.
+	TQueue<FQuarantinedNetGUID> QuarantinedNetGUIDs;
+	int32 NumQuarantinedNetGUIDs = 0;
+	TArray<FNetworkGUID> FreeNetGUIDs;
+
+	FSpatialNetGUIDCacheStats Stats;
 };
 
@@ -0,0 +1,109 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+
+#include "UObject/improbable/UnrealObjectRef.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+#include <WorkerSDK/improbable/c_worker.h>
+
+#include "ObjectRefPathDictionary.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogObjectRefPathDictionary, Log, All)
+
+class USpatialNetDriver;
+
+struct FObjectRefPathDictionaryStats
+{
+	uint64 NumPathsInterned = 0;
+	uint64 NumPathsWrittenInFull = 0;
+	// Estimated from the UTF-8 length of the paths and the varint size of their IDs, without field headers.
+	uint64 PathBytesReplaced = 0;
+	uint64 PathIdBytesWritten = 0;
+	uint64 NumUnknownPathIdsReceived = 0;
+	uint64 NumPendingRefsResolved = 0;
+	uint64 NumPathsRequested = 0;
+	uint64 NumPathsAdded = 0;
+};
+
+// A list of object ref paths shared by the server workers, kept in the ObjectRefPathDictionary component on the
+// GlobalStateManager entity. References written by servers for servers carry a path's index in the list instead of
+// the path itself. Clients can't read the GSM entity, so nothing they receive is ever interned.
+//
+// Paths are only ever appended. A writer only uses IDs it has received, and asks for unknown paths to be added,
+// writing them in full until the dictionary update arrives. The worker authoritative over the component appends
+// paths directly, others send it the add_paths command. Additions are batched and sent once per tick from TickFlush.
+//
+// Readers turn IDs into placeholder paths, which FSpatialNetGUIDCache swaps for the real path on lookup. A reader can
+// receive an ID before the dictionary update that adds it, in which case the reference stays unresolved until the
+// update arrives and is then resolved through USpatialReceiver::ResolvePendingOperations.
+UCLASS()
+class SPATIALGDK_API UObjectRefPathDictionary : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void Init(USpatialNetDriver* InNetDriver);
+
+	// Whether paths can be interned by this worker: interning is enabled and the dictionary has been received.
+	bool IsAvailable() const;
+
+	// Returns true and the ID of the path if it is in the dictionary. Otherwise the path is queued to be added and must be
+	// written in full. Can be called from the tasks writing initial entity data.
+	bool FindOrRequestPathId(const FString& Path, uint32& OutPathId);
+
+	static FString MakePlaceholderPath(uint32 PathId);
+
+	// Replaces the placeholders of interned paths in ObjectRef and its outers. Returns false if an ID isn't in the dictionary
+	// yet, in which case the ref is kept and resolved once it is.
+	bool ResolvePlaceholderPaths(const FUnrealObjectRef& ObjectRef, FUnrealObjectRef& OutObjectRef);
+
+	void ApplyData(Worker_EntityId EntityId, const Worker_ComponentData& Data);
+	void ApplyUpdate(const Worker_ComponentUpdate& Update);
+
+	void ReceiveAddPathsRequest(const Worker_CommandRequestOp& Op);
+	void ReceiveAddPathsResponse(const Worker_CommandResponseOp& Op);
+
+	// Sends the paths requested since the last flush.
+	void Flush();
+
+	void DumpStats(FOutputDevice& Ar) const;
+	void ResetStats();
+
+private:
+	bool HasAuthority() const;
+
+	// Appends paths that aren't in the dictionary yet, up to the size limit, and returns whether any were added.
+	bool AddPaths(const TArray<FString>& NewPaths);
+	void SendPathsUpdate();
+	void SetPaths(TArray<FString>&& NewPaths);
+
+	void ResolvePendingRefs();
+
+	static bool ParsePlaceholderPath(const FString& Path, uint32& OutPathId);
+
+	UPROPERTY()
+	USpatialNetDriver* NetDriver;
+
+	Worker_EntityId DictionaryEntityId = 0;
+	bool bHasData = false;
+
+	TArray<FString> Paths;
+	TMap<FString, uint32> PathToId;
+
+	// Paths that have been asked for and haven't arrived yet, so each is only requested once.
+	TSet<FString> RequestedPaths;
+	TArray<FString> PathsToRequest;
+	TMap<Worker_RequestId, TArray<FString>> InFlightRequests;
+
+	// Received refs with IDs that weren't in the dictionary.
+	TSet<FUnrealObjectRef> PendingRefs;
+
+	// Guards the requested paths and stats, which are written by the initial data tasks.
+	FCriticalSection CriticalSection;
+
+	FObjectRefPathDictionaryStats Stats;
+};
@@ -0,0 +1,83 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+
+#include <WorkerSDK/improbable/c_worker.h>
+
+#include "SpatialEntityPool.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialEntityPool, Log, All)
+
+class FTimerManager;
+class USpatialNetDriver;
+class USpatialReceiver;
+
+struct FEntityRange
+{
+	Worker_EntityId CurrentEntityId;
+	Worker_EntityId LastEntityId;
+};
+
+struct FEntityPoolStats
+{
+	uint32 RefillRequestsSent = 0;
+	uint32 RefillRequestsFailed = 0;
+	uint64 EntityIdsReserved = 0;
+	uint64 EntityIdsHandedOut = 0;
+
+	// Number of times an entity ID was requested while the pool was empty.
+	uint32 StarvationCount = 0;
+
+	double LastRefillLatencySeconds = 0.0;
+	double MaxRefillLatencySeconds = 0.0;
+};
+
+// Keeps a pool of pre-reserved entity IDs on server workers, so that newly spawned actors can
+// be given an entity ID synchronously instead of waiting for a reserve request round trip.
+UCLASS()
+class SPATIALGDK_API USpatialEntityPool : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void Init(USpatialNetDriver* InNetDriver, FTimerManager* InTimerManager);
+
+	// Returns a reserved entity ID, or SpatialConstants::INVALID_ENTITY_ID if the pool is empty.
+	Worker_EntityId GetNextEntityId();
+
+	FORCEINLINE bool IsReady() const { return bIsReady; }
+	FORCEINLINE int64 GetNumAvailableEntityIds() const { return NumAvailableEntityIds; }
+	FORCEINLINE const FEntityPoolStats& GetStats() const { return Stats; }
+
+	void DumpStats(FOutputDevice& Ar) const;
+
+private:
+	void ReserveEntityIds(uint32 NumEntityIds);
+	void OnEntityIdsReserved(const Worker_ReserveEntityIdsResponseOp& Op, uint32 NumRequested, double RequestTime);
+	void RefillIfBelowLowWatermark();
+
+private:
+	UPROPERTY()
+	USpatialNetDriver* NetDriver;
+
+	UPROPERTY()
+	USpatialReceiver* Receiver;
+
+	FTimerManager* TimerManager;
+
+	TArray<FEntityRange> ReservedRanges;
+	int64 NumAvailableEntityIds;
+
+	bool bIsReady;
+	bool bIsAwaitingResponse;
+	uint32 NumFailedAttempts;
+
+	// Read from the settings in Init, with the low watermark kept below the initial reservation and the high watermark above it.
+	uint32 LowWatermark;
+	uint32 HighWatermark;
+
+	FEntityPoolStats Stats;
+};
@@ -0,0 +1,138 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+
+#include "SpatialReplicationScheduler.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialReplicationScheduler, Log, All)
+
+class AActor;
+class USpatialNetDriver;
+struct FNetworkObjectInfo;
+
+struct FReplicationBucketStats
+{
+	uint64 NumActorsGathered = 0;
+	uint64 NumActorsReplicated = 0;
+	uint64 GatherCycles = 0;
+	uint64 ReplicateCycles = 0;
+};
+
+// Decides which actors are due for replication each tick, replacing the scan over every network object in
+// UNetDriver::ServerReplicateActors_BuildConsiderList.
+//
+// Actors are kept in buckets of equal update interval. Within a bucket, an actor is always rescheduled behind
+// every actor already queued, so each bucket is a FIFO ordered by due time and a tick only looks at actors that
+// are due. Actors which are dormant on the SpatialOS connection are moved to a dormant list until they wake up.
+//
+// Dormancy flushes and changes wake actors straight away, through the net driver and connection. Engine code can
+// still change when an actor is due without going through either (ForceNetUpdate, actors starting to replicate
+// after spawning), so a resync sweep over the network object list picks up
+// those changes. The sweep is spread over ticks: each tick visits the share of the list needed to cover all of it
+// once per resync interval, so no single tick walks every network object.
+UCLASS()
+class SPATIALGDK_API USpatialReplicationScheduler : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void Init(USpatialNetDriver* InNetDriver);
+
+	virtual void BeginDestroy() override;
+
+	// Adds the network object info of every actor due for replication at Time to OutDueActors,
+	// and schedules each of them for its next update.
+	void GatherDueActors(float Time, TArray<FNetworkObjectInfo*>& OutDueActors);
+
+	// Makes an actor due again on the next tick, e.g. because it couldn't be replicated this tick.
+	// Also wakes a dormant actor, for when its dormancy is flushed or changed.
+	void ScheduleImmediate(AActor* Actor);
+
+	void RemoveActor(AActor* Actor);
+
+	// Attributes time spent replicating an actor to its bucket.
+	void RecordReplication(AActor* Actor, uint64 Cycles);
+
+	void DumpStats(FOutputDevice& Ar) const;
+
+private:
+	struct FQueuedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		float DueTime;
+	};
+
+	struct FReplicationBucket
+	{
+		float UpdateInterval;
+		FString ExampleClassName;
+		TArray<FQueuedActor> Queue;
+		int32 QueueHead = 0;
+		int32 NumActors = 0;
+		FReplicationBucketStats Stats;
+	};
+
+	struct FScheduledActor
+	{
+		int32 BucketIndex = INDEX_NONE;
+		float DueTime = 0.0f;
+		bool bDormant = false;
+		bool bImmediate = false;
+	};
+
+	void OnActorSpawned(AActor* Actor);
+
+	// Also used for actors that were garbage collected without the net driver being told, whose weak pointers still find their entry.
+	void RemoveEntry(const TWeakObjectPtr<AActor>& Actor);
+
+	// Checks the next slice of the network object list for actors whose schedule is out of date.
+	void Resync(float Time, float DeltaTime);
+	void ResyncActor(FNetworkObjectInfo* ActorInfo, float Time);
+	void UpdateViewerCells();
+
+	// Queues an actor in the bucket for its current update interval.
+	void Schedule(AActor* Actor, FScheduledActor& Entry, float Time);
+	void SetBucket(FScheduledActor& Entry, int32 BucketIndex);
+	int32 FindOrAddBucket(float UpdateInterval, const AActor* Actor);
+	float GetUpdateInterval(const AActor* Actor) const;
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	// Returns the entry for a queued actor, or nullptr if the actor is gone or was scheduled again since it was queued.
+	FScheduledActor* ValidateQueuedActor(const FQueuedActor& QueuedActor, int32 BucketIndex);
+
+	bool IsActorDormant(const FNetworkObjectInfo* ActorInfo) const;
+
+private:
+	UPROPERTY()
+	USpatialNetDriver* NetDriver;
+
+	TArray<FReplicationBucket> Buckets;
+	TMap<uint32, int32> IntervalToBucketIndex;
+
+	TMap<TWeakObjectPtr<AActor>, FScheduledActor> ScheduledActors;
+
+	// Actors due on the next tick regardless of their bucket.
+	TArray<TWeakObjectPtr<AActor>> ImmediateActors;
+
+	// Actors spawned since the last tick. Their network object info may not exist yet when they are spawned.
+	TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+
+	// Cells containing, or next to, a pawn controlled by a player on this worker.
+	TSet<FIntPoint> ViewerCells;
+
+	// Position of the resync sweep in the sparse array of the network object list.
+	int32 ResyncCursor;
+	float LastGatherTime;
+	int32 NumDormantActors;
+	FDelegateHandle OnActorSpawnedHandle;
+
+	uint64 NumResyncPasses;
+	uint64 NumResyncVisits;
+	uint64 MaxResyncVisitsPerTick;
+	uint64 ResyncCycles;
+	uint64 NumThrottledSchedules;
+};
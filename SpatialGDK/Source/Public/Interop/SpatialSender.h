@@ -6,6 +6,7 @@
 
 #include "SpatialTypebindingManager.h"
 #include "Utils/RepDataUtils.h"
+#include "Utils/UnresolvedReferenceTable.h"
 
 #include <WorkerSDK/improbable/c_schema.h>
 #include <WorkerSDK/improbable/c_worker.h>
@@ -34,14 +35,54 @@ struct FPendingRPCParams
 	int Attempts; // For reliable RPCs
 };
 
+// Counts of Position and Rotation updates sent, and of checks where the actor had moved or rotated but the
+// thresholds and rate limits in FSpatialTransformUpdateSettings held the update back.
+struct FTransformUpdateStats
+{
+	uint64 PositionUpdatesSent = 0;
+	uint64 PositionUpdatesBelowThreshold = 0;
+	uint64 PositionUpdatesRateLimited = 0;
+	uint64 RotationUpdatesSent = 0;
+	uint64 RotationUpdatesBelowThreshold = 0;
+	// Wire size of the rotation fields of sent updates, see improbable::Rotation::GetEncodedSize.
+	uint64 RotationFieldBytesSent = 0;
+};
+
+// Counts of full and delta sends for a replicated array property. Serialized bytes are only measured while the outgoing
+// byte profiler is enabled, as measuring a delta send means serializing the full array as well.
+struct FArrayDeltaStats
+{
+	uint64 FullSends = 0;
+	uint64 DeltaSends = 0;
+	uint64 MeasuredSends = 0;
+	uint64 BytesSent = 0;
+	int64 BytesSaved = 0;
+};
+
+// Counts of changed fields of a property checked against the value hash last sent, and how many of them were dropped.
+struct FFieldValueHashStats
+{
+	uint64 FieldsChecked = 0;
+	uint64 FieldsSuppressed = 0;
+};
+
+// Multicast RPC events collected for an entity during a tick, with one component update per object.
+struct FPendingMulticastRPCs
+{
+	TMap<Worker_ComponentId, Worker_ComponentUpdate> Updates;
+	uint32 NumUnreliableEvents = 0;
+};
+
+// Counts of a NetMulticast RPC coalesced into per-tick updates, and dropped by the unreliable multicast cap.
+struct FMulticastRPCStats
+{
+	uint64 Coalesced = 0;
+	uint64 Dropped = 0;
+};
+
 // TODO: Clear TMap entries when USpatialActorChannel gets deleted - UNR:100
 // care for actor getting deleted before actor channel
-using FChannelObjectPair = TPair<TWeakObjectPtr<USpatialActorChannel>, TWeakObjectPtr<UObject>>;
 using FOutgoingRPCMap = TMap<const UObject*, TArray<TSharedRef<FPendingRPCParams>>>;
-using FUnresolvedEntry = TSharedPtr<TSet<const UObject*>>;
-using FHandleToUnresolved = TMap<uint16, FUnresolvedEntry>;
-using FChannelToHandleToUnresolved = TMap<FChannelObjectPair, FHandleToUnresolved>;
-using FOutgoingRepUpdates = TMap<const UObject*, FChannelToHandleToUnresolved>;
 
 UCLASS()
 class SPATIALGDK_API USpatialSender : public UObject
@@ -56,13 +97,38 @@ public:
 	void SendComponentInterest(AActor* Actor, Worker_EntityId EntityId);
 	void SendPositionUpdate(Worker_EntityId EntityId, const FVector& Location);
 	void SendRotationUpdate(Worker_EntityId EntityId, const FRotator& Rotation);
+	void RecordSkippedPositionUpdate(bool bRateLimited);
+	void RecordSkippedRotationUpdate();
+	void DumpTransformUpdateStats(FOutputDevice& Ar) const;
+
+	void RecordArrayReplication(const UProperty* Property, bool bWasDelta);
+	// FullBytes is the serialized size of the whole array, SentBytes the size of what was written for it.
+	void RecordArrayBytes(const UProperty* Property, uint32 FullBytes, uint32 SentBytes);
+	void DumpArrayDeltaStats(FOutputDevice& Ar) const;
+
+	// Property may be null, in which case only the totals are counted.
+	void RecordFieldValueHashCheck(const UProperty* Property, bool bSuppressed);
+	void DumpFieldValueHashStats(FOutputDevice& Ar) const;
+
+	// Serialized size of all entity creations, component updates and RPCs sent so far.
+	uint64 GetBytesSent() const { return BytesSent; }
+
 	void SendRPC(TSharedRef<FPendingRPCParams> Params);
+
+	// Sends the multicast RPCs collected this tick when USpatialGDKSettings::bCoalesceMulticastRPCs is set.
+	void FlushPendingMulticastRPCs();
+	void DumpMulticastRPCStats(FOutputDevice& Ar) const;
 	void SendCommandResponse(Worker_RequestId request_id, Worker_CommandResponse& Response);
 
 	void SendReserveEntityIdRequest(USpatialActorChannel* Channel);
 	void SendCreateEntityRequest(USpatialActorChannel* Channel);
 	void SendDeleteEntityRequest(Worker_EntityId EntityId);
 
+	// Spawn waves: create entity requests queued during a frame are sent in ProcessQueuedCreateEntityRequests,
+	// paced by USpatialGDKSettings::MaxEntityCreationsPerTick.
+	void QueueCreateEntityRequest(USpatialActorChannel* Channel);
+	void ProcessQueuedCreateEntityRequests();
+
 	void ResolveOutgoingOperations(UObject* Object, bool bIsHandover);
 	void ResolveOutgoingRPCs(UObject* Object);
 
@@ -79,6 +145,11 @@ private:
 	// RPC Construction
 	Worker_CommandRequest CreateRPCCommandRequest(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, Schema_FieldId CommandIndex, Worker_EntityId& OutEntityId, const UObject*& OutUnresolvedObject);
 	Worker_ComponentUpdate CreateMulticastUpdate(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, Schema_FieldId EventIndex, Worker_EntityId& OutEntityId, const UObject*& OutUnresolvedObject);
+	bool AddMulticastEvent(Schema_Object* EventsObject, UObject* TargetObject, UFunction* Function, void* Parameters, Schema_FieldId EventIndex, Worker_EntityId& OutEntityId, const UObject*& OutUnresolvedObject);
+	void QueueMulticastRPC(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, Schema_FieldId EventIndex, const UObject*& OutUnresolvedObject);
+	void SendPendingMulticastRPCs(Worker_EntityId EntityId, FPendingMulticastRPCs& PendingRPCs);
+
+	void RecordRPCBytes(const UFunction* Function, uint32 Bytes);
 
 	TArray<Worker_InterestOverride> CreateComponentInterest(AActor* Actor);
 	FString GetOwnerWorkerAttribute(AActor* Actor);
@@ -102,13 +173,25 @@ private:
 	UPROPERTY()
 	USpatialTypebindingManager* TypebindingManager;
 
-	FChannelToHandleToUnresolved RepPropertyToUnresolved;
-	FOutgoingRepUpdates RepObjectToUnresolved;
-
-	FChannelToHandleToUnresolved HandoverPropertyToUnresolved;
-	FOutgoingRepUpdates HandoverObjectToUnresolved;
+	FUnresolvedReferenceTable RepUnresolvedReferences;
+	FUnresolvedReferenceTable HandoverUnresolvedReferences;
 
 	FOutgoingRPCMap OutgoingRPCs;
 
 	TMap<Worker_RequestId, USpatialActorChannel*> PendingActorRequests;
+
+	TArray<TWeakObjectPtr<USpatialActorChannel>> QueuedCreateEntityRequests;
+
+	FTransformUpdateStats TransformUpdateStats;
+
+	TMap<const UProperty*, FArrayDeltaStats> ArrayDeltaStats;
+
+	FFieldValueHashStats TotalFieldValueHashStats;
+	TMap<const UProperty*, FFieldValueHashStats> FieldValueHashStats;
+
+	TMap<Worker_EntityId, FPendingMulticastRPCs> PendingMulticastRPCs;
+	TMap<const UFunction*, FMulticastRPCStats> MulticastRPCStats;
+	uint64 NumCoalescedMulticastUpdatesSent;
+
+	uint64 BytesSent;
 };
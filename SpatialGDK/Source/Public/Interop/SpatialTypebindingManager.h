@@ -3,12 +3,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
 #include "Utils/SchemaDatabase.h"
 
 #include <WorkerSDK/improbable/c_worker.h>
 
 #include "SpatialTypebindingManager.generated.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialTypebindingManager, Log, All)
+
 FORCEINLINE void ForAllSchemaComponentTypes(TFunction<void(ESchemaComponentType)> Callback)
 {
 	for (int32 Type = SCHEMA_Begin; Type < SCHEMA_Count; Type++)
@@ -57,6 +60,10 @@ struct FClassInfo
 
 	Worker_ComponentId SchemaComponents[ESchemaComponentType::SCHEMA_Count] = {};
 
+	// Rep handles of the bools written as one bitfield per group, in bit order. Only SCHEMA_Data and SCHEMA_OwnerOnly have entries.
+	TMap<ESchemaComponentType, TArray<uint16>> PackedBoolHandles;
+	TMap<uint16, FQuantizedFloatSchemaData> QuantizedFloats;
+
 	FName SubobjectName;
 
 	TMap<uint32, TSharedPtr<FClassInfo>> SubobjectInfo;
@@ -64,6 +71,25 @@ struct FClassInfo
 
 class USpatialNetDriver;
 
+struct FTypebindingStats
+{
+	double SchemaDatabaseLoadSeconds = 0.0;
+	double ComponentMapSeconds = 0.0;
+
+	// Classes loaded at startup, or requested through the streamable manager when loading asynchronously.
+	int32 NumStartupClasses = 0;
+	double StartupClassLoadSeconds = 0.0;
+	double AsyncClassLoadSeconds = 0.0;
+	bool bAsyncClassLoadComplete = false;
+
+	// Classes loaded synchronously because they were needed before the asynchronous load finished.
+	int32 NumClassesLoadedOnDemand = 0;
+	double OnDemandClassLoadSeconds = 0.0;
+
+	int32 NumClassInfosBuilt = 0;
+	double ClassInfoBuildSeconds = 0.0;
+};
+
 UCLASS()
 class SPATIALGDK_API USpatialTypebindingManager : public UObject
 {
@@ -74,20 +100,44 @@ public:
 
 	bool IsSupportedClass(UClass* Class);
 
+	// Class infos are built the first time they are asked for, so the returned pointers stay valid as more are added.
 	FClassInfo* FindClassInfoByClass(UClass* Class);
 	FClassInfo* FindClassInfoByActorClassAndOffset(UClass* Class, uint32 Offset);
 	FClassInfo* FindClassInfoByComponentId(Worker_ComponentId ComponentId);
 	FClassInfo* FindClassInfoByObject(UObject* Object);
 
+	// Loads the class if it hasn't been loaded yet.
 	UClass* FindClassByComponentId(Worker_ComponentId ComponentId);
 
 	bool FindOffsetByComponentId(Worker_ComponentId ComponentId, uint32& OutOffset);
 
 	ESchemaComponentType FindCategoryByComponentId(Worker_ComponentId ComponentId);
 
+	void DumpStats(FOutputDevice& Ar) const;
+
 private:
-	void FindSupportedClasses();
-	void CreateTypebindings();
+	void CreateComponentMaps();
+	void LoadSupportedClasses();
+	void RequestSupportedClassesAsync();
+	void OnSupportedClassesLoaded();
+
+	UClass* LoadClass(const FSoftClassPath& ClassPath);
+	FClassInfo& CreateClassInfo(UClass* Class, const FSchemaData& SchemaData);
+
+	// What a generated component stands for, read from the schema database without loading the class.
+	struct FComponentTypeInfo
+	{
+		FSoftClassPath ClassPath;
+		// Set once the class is loaded. SupportedClasses keeps it alive.
+		UClass* Class = nullptr;
+		// Set on the first FindClassInfoByComponentId.
+		FClassInfo* ClassInfo = nullptr;
+		uint32 Offset = 0;
+		ESchemaComponentType Category = SCHEMA_Invalid;
+	};
+
+	FComponentTypeInfo* FindComponentTypeInfo(Worker_ComponentId ComponentId);
+	const FComponentTypeInfo* FindComponentTypeInfo(Worker_ComponentId ComponentId) const;
 
 private:
 	UPROPERTY()
@@ -96,13 +146,22 @@ private:
 	UPROPERTY()
 	USchemaDatabase* SchemaDatabase;
 
+	// Every loaded class with an entry in the schema database.
 	UPROPERTY()
-	TArray<UClass*> SupportedClasses;
+	TSet<UClass*> SupportedClasses;
 
-	UPROPERTY()
-	TMap<UClass*, FClassInfo> ClassInfoMap;
+	TMap<UClass*, TSharedRef<FClassInfo>> ClassInfoMap;
+	TSet<TWeakObjectPtr<UClass>> UnsupportedClasses;
+
+	// Indexed by ComponentId - STARTING_GENERATED_COMPONENT_ID, as the schema generator hands out IDs densely from there.
+	// Entries for unused IDs have an invalid category. IDs outside the dense range are kept in SparseComponentTypeInfos.
+	TArray<FComponentTypeInfo> GeneratedComponentTypeInfos;
+	TMap<Worker_ComponentId, FComponentTypeInfo> SparseComponentTypeInfos;
+	int32 NumComponentTypeInfos = 0;
+
+	FStreamableManager StreamableManager;
+	TSharedPtr<FStreamableHandle> SupportedClassesHandle;
+	double AsyncClassLoadStartTime = 0.0;
 
-	TMap<Worker_ComponentId, UClass*> ComponentToClassMap;
-	TMap<Worker_ComponentId, uint32> ComponentToOffsetMap;
-	TMap<Worker_ComponentId, ESchemaComponentType> ComponentToCategoryMap;
+	FTypebindingStats Stats;
 };
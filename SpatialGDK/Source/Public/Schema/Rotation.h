@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Schema/Component.h"
+#include "Schema/RotationEncoding.h"
 #include "SpatialConstants.h"
 #include "Utils/SchemaUtils.h"
 
@@ -31,6 +32,8 @@ struct Rotation : Component
 		Pitch = Schema_GetFloat(ComponentObject, 1);
 		Yaw = Schema_GetFloat(ComponentObject, 2);
 		Roll = Schema_GetFloat(ComponentObject, 3);
+
+		ReadCompactFields(ComponentObject);
 	}
 
 	FRotator ToFRotator()
@@ -38,7 +41,7 @@ struct Rotation : Component
 		return{ Pitch, Yaw, Roll };
 	}
 
-	Worker_ComponentData CreateRotationData()
+	Worker_ComponentData CreateRotationData(ERotationEncoding Encoding = ERotationEncoding::Full)
 	{
 		Worker_ComponentData Data = {};
 		Data.component_id = ComponentId;
@@ -49,19 +52,30 @@ struct Rotation : Component
 		Schema_AddFloat(ComponentObject, 2, Yaw);
 		Schema_AddFloat(ComponentObject, 3, Roll);
 
+		// The float fields are always present in the component data. With a compact encoding, updates only
+		// write the compact field, which takes precedence when reading.
+		AddCompactField(ComponentObject, Encoding);
+
 		return Data;
 	}
 
-	Worker_ComponentUpdate CreateRotationUpdate()
+	Worker_ComponentUpdate CreateRotationUpdate(ERotationEncoding Encoding = ERotationEncoding::Full)
 	{
 		Worker_ComponentUpdate ComponentUpdate = {};
 		ComponentUpdate.component_id = ComponentId;
 		ComponentUpdate.schema_type = Schema_CreateComponentUpdate(ComponentId);
 		Schema_Object* ComponentObject = Schema_GetComponentUpdateFields(ComponentUpdate.schema_type);
 
-		Schema_AddFloat(ComponentObject, 1, Pitch);
-		Schema_AddFloat(ComponentObject, 2, Yaw);
-		Schema_AddFloat(ComponentObject, 3, Roll);
+		if (Encoding == ERotationEncoding::Full)
+		{
+			Schema_AddFloat(ComponentObject, 1, Pitch);
+			Schema_AddFloat(ComponentObject, 2, Yaw);
+			Schema_AddFloat(ComponentObject, 3, Roll);
+		}
+		else
+		{
+			AddCompactField(ComponentObject, Encoding);
+		}
 
 		return ComponentUpdate;
 	}
@@ -81,11 +95,163 @@ struct Rotation : Component
 		{
 			Roll = Schema_GetFloat(ComponentObject, 3);
 		}
+
+		ReadCompactFields(ComponentObject);
+	}
+
+	// Size in bytes of the fields an update with this encoding writes, including field tags.
+	// Compact encodings are written as varints, so their size depends on the rotation.
+	static uint32 GetEncodedSize(ERotationEncoding Encoding, const FRotator& Rotator)
+	{
+		switch (Encoding)
+		{
+		case ERotationEncoding::Quantized16:
+			return FIELD_TAG_SIZE + GetVarintSize(EncodeQuantized16(Rotator));
+		case ERotationEncoding::SmallestThree:
+			return FIELD_TAG_SIZE + GetVarintSize(EncodeSmallestThree(Rotator));
+		default:
+			return 3 * (FIELD_TAG_SIZE + sizeof(float));
+		}
+	}
+
+	static uint64 EncodeQuantized16(const FRotator& Rotator)
+	{
+		return (uint64)FRotator::CompressAxisToShort(Rotator.Pitch)
+			| ((uint64)FRotator::CompressAxisToShort(Rotator.Yaw) << 16)
+			| ((uint64)FRotator::CompressAxisToShort(Rotator.Roll) << 32);
+	}
+
+	static FRotator DecodeQuantized16(uint64 Packed)
+	{
+		return FRotator(
+			FRotator::DecompressAxisFromShort((uint16)(Packed & 0xFFFF)),
+			FRotator::DecompressAxisFromShort((uint16)((Packed >> 16) & 0xFFFF)),
+			FRotator::DecompressAxisFromShort((uint16)((Packed >> 32) & 0xFFFF)));
+	}
+
+	// Layout: bits 0-1 hold the index of the dropped (largest) quaternion component,
+	// followed by the remaining three components at SMALLEST_THREE_BITS bits each.
+	static uint32 EncodeSmallestThree(const FRotator& Rotator)
+	{
+		FQuat Quat = Rotator.Quaternion();
+		Quat.Normalize();
+		const float Components[4] = { Quat.X, Quat.Y, Quat.Z, Quat.W };
+
+		uint32 LargestIndex = 0;
+		for (uint32 i = 1; i < 4; i++)
+		{
+			if (FMath::Abs(Components[i]) > FMath::Abs(Components[LargestIndex]))
+			{
+				LargestIndex = i;
+			}
+		}
+
+		// Q and -Q are the same rotation, so flip the sign to make the dropped component positive.
+		const float Sign = Components[LargestIndex] < 0.0f ? -1.0f : 1.0f;
+
+		uint32 Packed = LargestIndex;
+		uint32 Shift = 2;
+		for (uint32 i = 0; i < 4; i++)
+		{
+			if (i == LargestIndex)
+			{
+				continue;
+			}
+
+			// The smaller components are in [-1/sqrt(2), 1/sqrt(2)].
+			const float Normalized = (Components[i] * Sign / SMALLEST_THREE_RANGE + 1.0f) * 0.5f;
+			const uint32 Quantized = (uint32)FMath::Clamp(FMath::RoundToInt(Normalized * SMALLEST_THREE_MAX), 0, (int32)SMALLEST_THREE_MAX);
+			Packed |= Quantized << Shift;
+			Shift += SMALLEST_THREE_BITS;
+		}
+
+		return Packed;
+	}
+
+	static FRotator DecodeSmallestThree(uint32 Packed)
+	{
+		const uint32 LargestIndex = Packed & 0x3;
+
+		float Components[4];
+		float SumOfSquares = 0.0f;
+		uint32 Shift = 2;
+		for (uint32 i = 0; i < 4; i++)
+		{
+			if (i == LargestIndex)
+			{
+				continue;
+			}
+
+			const uint32 Quantized = (Packed >> Shift) & SMALLEST_THREE_MAX;
+			Components[i] = ((float)Quantized / SMALLEST_THREE_MAX * 2.0f - 1.0f) * SMALLEST_THREE_RANGE;
+			SumOfSquares += Components[i] * Components[i];
+			Shift += SMALLEST_THREE_BITS;
+		}
+
+		Components[LargestIndex] = FMath::Sqrt(FMath::Max(0.0f, 1.0f - SumOfSquares));
+
+		FQuat Quat(Components[0], Components[1], Components[2], Components[3]);
+		Quat.Normalize();
+		return Quat.Rotator();
 	}
 
 	float Pitch;
 	float Yaw;
 	float Roll;
+
+private:
+	// Field IDs below 16 fit in a one byte tag.
+	static const uint32 FIELD_TAG_SIZE = 1;
+
+	static const uint32 SMALLEST_THREE_BITS = 10;
+	static const uint32 SMALLEST_THREE_MAX = (1 << SMALLEST_THREE_BITS) - 1;
+	static constexpr float SMALLEST_THREE_RANGE = 0.707106781f; // 1 / sqrt(2)
+
+	static uint32 GetVarintSize(uint64 Value)
+	{
+		uint32 Size = 1;
+		for (; Value >= 0x80; Value >>= 7)
+		{
+			Size++;
+		}
+		return Size;
+	}
+
+	void AddCompactField(Schema_Object* ComponentObject, ERotationEncoding Encoding)
+	{
+		switch (Encoding)
+		{
+		case ERotationEncoding::Quantized16:
+			Schema_AddUint64(ComponentObject, 4, EncodeQuantized16(ToFRotator()));
+			break;
+		case ERotationEncoding::SmallestThree:
+			Schema_AddUint32(ComponentObject, 5, EncodeSmallestThree(ToFRotator()));
+			break;
+		default:
+			break;
+		}
+	}
+
+	void ReadCompactFields(Schema_Object* ComponentObject)
+	{
+		FRotator Rotator;
+		if (Schema_GetUint64Count(ComponentObject, 4) == 1)
+		{
+			Rotator = DecodeQuantized16(Schema_GetUint64(ComponentObject, 4));
+		}
+		else if (Schema_GetUint32Count(ComponentObject, 5) == 1)
+		{
+			Rotator = DecodeSmallestThree(Schema_GetUint32(ComponentObject, 5));
+		}
+		else
+		{
+			return;
+		}
+
+		Pitch = Rotator.Pitch;
+		Yaw = Rotator.Yaw;
+		Roll = Rotator.Roll;
+	}
 };
 
 }
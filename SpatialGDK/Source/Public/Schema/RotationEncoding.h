@@ -0,0 +1,18 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "RotationEncoding.generated.h"
+
+UENUM()
+enum class ERotationEncoding : uint8
+{
+	// Pitch, yaw and roll as three floats.
+	Full UMETA(DisplayName = "Full precision"),
+	// Pitch, yaw and roll quantized to 16 bits each (~0.0055 degrees).
+	Quantized16 UMETA(DisplayName = "16 bits per axis"),
+	// Quaternion with the largest component dropped and the other three quantized to 10 bits each.
+	SmallestThree UMETA(DisplayName = "Smallest three quaternion")
+};
@@ -60,11 +60,30 @@ namespace SpatialConstants
 	const Worker_ComponentId GLOBAL_STATE_MANAGER_COMPONENT_ID				= 100005;
 	const Worker_ComponentId GLOBAL_STATE_MANAGER_DEPLOYMENT_COMPONENT_ID	= 100006;
 	const Worker_ComponentId SERVER_ONLY_SINGLETON_COMPONENT_ID				= 100007;
+	const Worker_ComponentId OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID		= 100008;
 	const Worker_ComponentId STARTING_GENERATED_COMPONENT_ID				= 100010;
 
 	const Schema_FieldId GLOBAL_STATE_MANAGER_MAP_URL_ID			= 1;
 	const Schema_FieldId GLOBAL_STATE_MANAGER_ACCEPTING_PLAYERS_ID	= 2;
 
+	const Schema_FieldId OBJECT_REF_PATH_DICTIONARY_PATHS_ID			= 1;
+	const Schema_FieldId OBJECT_REF_PATH_DICTIONARY_ADD_PATHS_COMMAND_ID	= 1;
+
+	// Element-level deltas for replicated arrays are written to a separate field, at the array's rep handle plus this offset.
+	const Schema_FieldId ARRAY_DELTA_FIELD_ID_OFFSET				= 1 << 16;
+	const Schema_FieldId ARRAY_DELTA_LENGTH_ID						= 1;
+	const Schema_FieldId ARRAY_DELTA_INDICES_ID						= 2;
+	const Schema_FieldId ARRAY_DELTA_VALUES_ID						= 3;
+
+	// FastArraySerializer items are identified by ReplicationID rather than index. Their IDs are written to a separate field
+	// at the array's rep handle plus this offset, and deltas list the IDs of changed and removed items.
+	const Schema_FieldId FAST_ARRAY_ITEM_IDS_FIELD_ID_OFFSET		= 3 << 16;
+	const Schema_FieldId FAST_ARRAY_DELTA_ITEM_IDS_ID				= 4;
+	const Schema_FieldId FAST_ARRAY_DELTA_REMOVED_ITEM_IDS_ID		= 5;
+
+	// All packed bools of a replicated property group share this field, see FFieldEncodingSchemaData.
+	const Schema_FieldId PACKED_BOOLS_FIELD_ID						= 2 << 16;
+
 	const float FIRST_COMMAND_RETRY_WAIT_SECONDS = 0.2f;
 	const float REPLICATED_STABLY_NAMED_ACTORS_DELETION_TIMEOUT_SECONDS = 5.0f;
 	const uint32 MAX_NUMBER_COMMAND_ATTEMPTS = 5u;
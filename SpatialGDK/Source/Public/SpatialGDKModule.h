@@ -19,5 +19,9 @@ public:
 	void ShutdownModule() override;
 
 private:
+	void RegisterSettings();
+	void UnregisterSettings();
+	bool HandleSettingsSaved();
+
 	FSpatialGDKLoader Loader;
 };
@@ -0,0 +1,230 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Schema/RotationEncoding.h"
+#include "UObject/NoExportTypes.h"
+
+#include "SpatialGDKSettings.generated.h"
+
+class AActor;
+
+USTRUCT()
+struct FSpatialTransformUpdateSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Distance in cm an actor has to move before its Position component is updated. */
+	UPROPERTY(EditAnywhere, config, meta = (ClampMin = "0.0", DisplayName = "Position distance threshold (cm)"))
+	float PositionDistanceThreshold = 100.0f;
+
+	/** Angle in radians an actor has to rotate before its Rotation component is updated. */
+	UPROPERTY(EditAnywhere, config, meta = (ClampMin = "0.0", DisplayName = "Rotation angle threshold (radians)"))
+	float RotationAngleThreshold = 0.1f;
+
+	/** Maximum number of Position component updates sent per second for an actor, independent of its NetUpdateFrequency. 0 means no limit. */
+	UPROPERTY(EditAnywhere, config, meta = (ClampMin = "0.0", DisplayName = "Maximum Position update frequency"))
+	float MaxPositionUpdateFrequency = 0.0f;
+};
+
+USTRUCT()
+struct FSpatialUnreliableRPCSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** When more unreliable RPCs are queued in a tick than the budget allows, higher priority RPCs are sent first. */
+	UPROPERTY(EditAnywhere, config, meta = (DisplayName = "Priority"))
+	float Priority = 1.0f;
+
+	/** Seconds a queued RPC can wait for budget before it is dropped. */
+	UPROPERTY(EditAnywhere, config, meta = (ClampMin = "0.0", DisplayName = "Maximum age (seconds)"))
+	float MaxAge = 0.25f;
+};
+
+UCLASS(config = SpatialGDKSettings, defaultconfig)
+class SPATIALGDK_API USpatialGDKSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	USpatialGDKSettings(const FObjectInitializer& ObjectInitializer);
+
+	/** Pre-reserve entity IDs on server workers so newly spawned actors can be created without waiting for a reserve request round trip. */
+	UPROPERTY(EditAnywhere, config, Category = "Entity Pool", meta = (ConfigRestartRequired = true, DisplayName = "Use entity pool"))
+	bool bEnableEntityPool;
+
+	/** Number of entity IDs reserved when the entity pool is first filled. */
+	UPROPERTY(EditAnywhere, config, Category = "Entity Pool", meta = (ConfigRestartRequired = true, EditCondition = "bEnableEntityPool", ClampMin = "1", DisplayName = "Initial entity ID reservation count"))
+	uint32 EntityPoolInitialReservationCount;
+
+	/** When the number of available entity IDs drops below this value, the pool requests more. Must be below the initial reservation count. */
+	UPROPERTY(EditAnywhere, config, Category = "Entity Pool", meta = (ConfigRestartRequired = true, EditCondition = "bEnableEntityPool", DisplayName = "Pool low watermark"))
+	uint32 EntityPoolLowWatermark;
+
+	/** A refill tops the pool back up to this number of available entity IDs. Must be above the low watermark. */
+	UPROPERTY(EditAnywhere, config, Category = "Entity Pool", meta = (ConfigRestartRequired = true, EditCondition = "bEnableEntityPool", DisplayName = "Pool high watermark"))
+	uint32 EntityPoolHighWatermark;
+
+	/** Collect entities created during a frame and send their create requests as a paced stream at the end of the frame, instead of one at a time during replication. */
+	UPROPERTY(EditAnywhere, config, Category = "Entity Creation", meta = (ConfigRestartRequired = false, DisplayName = "Batch entity creation for spawn waves"))
+	bool bBatchSpawnWaveEntityCreation;
+
+	/** Maximum number of create entity requests sent per tick when batching entity creation. Remaining requests are sent on later ticks. 0 means no limit. */
+	UPROPERTY(EditAnywhere, config, Category = "Entity Creation", meta = (ConfigRestartRequired = false, EditCondition = "bBatchSpawnWaveEntityCreation", DisplayName = "Maximum entity creations per tick"))
+	uint32 MaxEntityCreationsPerTick;
+
+	/** Position and rotation update settings for actor classes without an entry in ActorClassTransformUpdateSettings. */
+	UPROPERTY(EditAnywhere, config, Category = "Transform Updates", meta = (ConfigRestartRequired = false, DisplayName = "Default transform update settings"))
+	FSpatialTransformUpdateSettings DefaultTransformUpdateSettings;
+
+	/** Per-class position and rotation update settings. An actor uses the entry for its closest configured base class. */
+	UPROPERTY(EditAnywhere, config, Category = "Transform Updates", meta = (ConfigRestartRequired = false, DisplayName = "Actor class transform update settings"))
+	TMap<TSoftClassPtr<AActor>, FSpatialTransformUpdateSettings> ActorClassTransformUpdateSettings;
+
+	/** Encoding used for the Rotation component. All workers in a deployment must use the same encoding. */
+	UPROPERTY(EditAnywhere, config, Category = "Transform Updates", meta = (ConfigRestartRequired = true, DisplayName = "Rotation encoding"))
+	ERotationEncoding RotationEncoding;
+
+	/** Send changes to large replicated arrays as the changed elements and new length, instead of resending the whole array. Requires regenerated schema. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Use array delta encoding"))
+	bool bEnableArrayDeltaEncoding;
+
+	/** Arrays with fewer elements than this are always sent in full. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bEnableArrayDeltaEncoding", DisplayName = "Minimum array length for delta encoding"))
+	uint32 ArrayDeltaMinNumElements;
+
+	/** Only compare the replicated properties of objects that game code has marked dirty, for the actor classes in PushModelActorClasses. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = true, DisplayName = "Use push model replication"))
+	bool bEnablePushModel;
+
+	/** Actor classes, including subclasses, whose properties are marked dirty with MARK_SPATIAL_PROPERTY_DIRTY. Their replicated components use push model replication too. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = true, EditCondition = "bEnablePushModel", DisplayName = "Push model actor classes"))
+	TArray<TSoftClassPtr<AActor>> PushModelActorClasses;
+
+	/** Seconds between full property comparisons of push model actors, which pick up properties that were changed without being marked dirty. 0 disables them. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bEnablePushModel", ClampMin = "0.0", DisplayName = "Push model full compare interval"))
+	float PushModelFullCompareInterval;
+
+	/** Schedule actor replication with per-frequency buckets, so each tick only looks at actors that are due instead of every replicated actor. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication Scheduler", meta = (ConfigRestartRequired = true, DisplayName = "Use replication scheduler"))
+	bool bUseReplicationScheduler;
+
+	/** Seconds taken by one sweep over all replicated actors, which picks up forced updates, actors woken from dormancy and actors that started replicating late. The sweep is spread over the ticks in between. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication Scheduler", meta = (ConfigRestartRequired = false, EditCondition = "bUseReplicationScheduler", ClampMin = "0.0", DisplayName = "Resync interval"))
+	float ReplicationSchedulerResyncInterval;
+
+	/** Size in cm of the grid cells used to find actors near players on this worker. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication Scheduler", meta = (ConfigRestartRequired = false, EditCondition = "bUseReplicationScheduler", ClampMin = "1.0", DisplayName = "Cell size"))
+	float ReplicationSchedulerCellSize;
+
+	/**
+	 * Update frequency multiplier for actors that aren't in or next to a cell containing a player pawn on this worker. 1 disables throttling.
+	 * Clients connected through other workers can see these actors too, so only lower this if that isn't a concern.
+	 */
+	UPROPERTY(EditAnywhere, config, Category = "Replication Scheduler", meta = (ConfigRestartRequired = false, EditCondition = "bUseReplicationScheduler", ClampMin = "0.01", ClampMax = "1.0", DisplayName = "Remote cell update frequency scale"))
+	float ReplicationSchedulerRemoteCellFrequencyScale;
+
+	/** Run the property comparisons of actors due for replication on task graph worker threads before replicating them. Serialization and sending stay on the game thread. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Compare properties in parallel"))
+	bool bEnableParallelPropertyComparison;
+
+	/** Maximum number of tasks the comparisons are split into each tick. 0 uses every task graph worker thread and the game thread. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = true, EditCondition = "bEnableParallelPropertyComparison", ClampMin = "0", DisplayName = "Maximum parallel comparison tasks"))
+	int32 ParallelPropertyComparisonMaxTasks;
+
+	/** Ticks with fewer objects to compare than this compare them on the game thread, where splitting the work costs more than it saves. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bEnableParallelPropertyComparison", DisplayName = "Minimum objects for parallel comparison"))
+	uint32 ParallelPropertyComparisonMinObjects;
+
+	/** Write the initial component data of new entities on task graph worker threads, one task per component of the actor and its subobjects. Object references and struct serialization still go through the package map one task at a time. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Serialize initial entity data in parallel"))
+	bool bEnableParallelInitialDataSerialization;
+
+	/** Entities with fewer replicated data and handover components than this have their initial data written on the game thread. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bEnableParallelInitialDataSerialization", DisplayName = "Minimum components for parallel serialization"))
+	uint32 ParallelInitialDataSerializationMinComponents;
+
+	/** Maximum bytes of component data sent by actor replication per tick. Once it is used up, the remaining, lowest priority actors are deferred to the next tick, and actors it isn't expected to reach are left out of parallel property comparison. 0 disables the limit. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Maximum replication bytes per tick"))
+	uint32 MaxReplicationBytesPerTick;
+
+	/** Count the bytes sent per class, replicated property and RPC, and measure the bytes saved by array delta encoding. See DUMPSPATIALOUTGOINGBYTES and DUMPSPATIALARRAYDELTASTATS. A CSV of the counts is written to the profiling directory when the net driver shuts down. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Profile outgoing bytes"))
+	bool bEnableOutgoingByteProfiling;
+
+	/** Keep the last value sent for each numeric, enum, bool and name field, replicated or handover, and drop changed fields whose value is the same as what was last sent. Other fields are always sent. See DUMPSPATIALFIELDHASHSTATS. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Skip unchanged field values"))
+	bool bEnableFieldValueHashing;
+
+	/** Collect the NetMulticast RPCs sent on an entity during a tick and send them as one component update per object at the end of the tick, instead of one update per RPC. See DUMPSPATIALMULTICASTSTATS. */
+	UPROPERTY(EditAnywhere, config, Category = "RPCs", meta = (ConfigRestartRequired = false, DisplayName = "Coalesce multicast RPCs"))
+	bool bCoalesceMulticastRPCs;
+
+	/** Maximum number of unreliable NetMulticast RPCs collected for an entity per tick when coalescing. Further unreliable multicasts on the entity are dropped until the next tick. Reliable multicasts are never dropped. 0 means no limit. */
+	UPROPERTY(EditAnywhere, config, Category = "RPCs", meta = (ConfigRestartRequired = false, EditCondition = "bCoalesceMulticastRPCs", DisplayName = "Maximum unreliable multicast RPCs per entity per tick"))
+	uint32 MaxUnreliableMulticastRPCsPerEntityPerTick;
+
+	/** Compress struct property and RPC payloads of at least PayloadCompressionThreshold bytes with zlib. Adds a one byte header to every such payload, so all workers in a deployment must use the same setting. See DUMPSPATIALCOMPRESSIONSTATS. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = true, DisplayName = "Compress large payloads"))
+	bool bEnablePayloadCompression;
+
+	/** Payloads smaller than this many bytes are never compressed. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bEnablePayloadCompression", DisplayName = "Payload compression threshold (bytes)"))
+	uint32 PayloadCompressionThreshold;
+
+	/** Compressed payloads that claim to decompress to more than this many bytes are dropped without being decompressed. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bEnablePayloadCompression", ClampMin = "1", DisplayName = "Maximum uncompressed payload size (bytes)"))
+	uint32 MaxUncompressedPayloadSize;
+
+	/** Server workers write the paths of stably named object references that only servers read (handover properties, server only actors and cross server RPCs) as their index in a dictionary kept on the GlobalStateManager entity. New paths are added to the dictionary as they are first written. Needs a snapshot with the dictionary component. See DUMPSPATIALOBJECTREFPATHSTATS. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Intern object reference paths"))
+	bool bEnableObjectRefPathInterning;
+
+	/** Once the dictionary holds this many paths, no more are added and new paths are always written in full. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bEnableObjectRefPathInterning", DisplayName = "Maximum interned object reference paths"))
+	uint32 MaxInternedObjectRefPaths;
+
+	/** Register the object references of the stably named, non-replicated actors and components in the loaded levels once the map is loaded and connected, instead of the first time each one is referenced. Logs how long it took. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Pre-register stably named objects"))
+	bool bPreRegisterStablyNamedObjects;
+
+	/** Time per tick spent pre-registering stably named objects, before the tick's ops are processed. 0 registers them all at map load. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bPreRegisterStablyNamedObjects", DisplayName = "Stably named object registration budget (ms)"))
+	float StablyNamedObjectRegistrationBudgetMs;
+
+	/** Reuse the NetGUIDs of dynamic objects in deleted entities for new entities, so the NetGUID cache stays bounded on long running workers with high entity churn. See DUMPSPATIALNETGUIDCACHESTATS. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, DisplayName = "Recycle entity NetGUIDs"))
+	bool bRecycleEntityNetGUIDs;
+
+	/** Seconds a released NetGUID is kept for its old object before it can be reused. */
+	UPROPERTY(EditAnywhere, config, Category = "Replication", meta = (ConfigRestartRequired = false, EditCondition = "bRecycleEntityNetGUIDs", ClampMin = "0.0", DisplayName = "NetGUID recycle delay"))
+	float NetGUIDRecycleDelay;
+
+	/** Queue unreliable RPCs until the end of the frame and send them within MaxUnreliableRPCsPerTick, dropping stale and low priority RPCs under load. See DUMPSPATIALUNRELIABLERPCSTATS. */
+	UPROPERTY(EditAnywhere, config, Category = "RPCs", meta = (ConfigRestartRequired = false, DisplayName = "Queue unreliable RPCs"))
+	bool bQueueUnreliableRPCs;
+
+	/** Maximum number of queued unreliable RPCs sent per tick. The rest stay queued until they are older than their maximum age. 0 means no limit. */
+	UPROPERTY(EditAnywhere, config, Category = "RPCs", meta = (ConfigRestartRequired = false, EditCondition = "bQueueUnreliableRPCs", DisplayName = "Maximum unreliable RPCs per tick"))
+	uint32 MaxUnreliableRPCsPerTick;
+
+	/** Priority and maximum age for unreliable RPCs without an entry in FunctionUnreliableRPCSettings. */
+	UPROPERTY(EditAnywhere, config, Category = "RPCs", meta = (ConfigRestartRequired = false, EditCondition = "bQueueUnreliableRPCs", DisplayName = "Default unreliable RPC settings"))
+	FSpatialUnreliableRPCSettings DefaultUnreliableRPCSettings;
+
+	/** Per-function priority and maximum age for unreliable RPCs, keyed by function name, e.g. ServerMove. */
+	UPROPERTY(EditAnywhere, config, Category = "RPCs", meta = (ConfigRestartRequired = false, EditCondition = "bQueueUnreliableRPCs", DisplayName = "Function unreliable RPC settings"))
+	TMap<FName, FSpatialUnreliableRPCSettings> FunctionUnreliableRPCSettings;
+
+	/** Load the classes in the schema database through the streamable manager instead of all at once before connecting, and build their typebindings the first time each class is used. Classes needed before the load finishes are loaded synchronously. See DUMPSPATIALTYPEBINDINGSTATS. */
+	UPROPERTY(EditAnywhere, config, Category = "Startup", meta = (ConfigRestartRequired = true, DisplayName = "Load typebinding classes asynchronously"))
+	bool bLoadTypebindingClassesAsync;
+
+	const FSpatialTransformUpdateSettings& GetTransformUpdateSettings(const UClass* ActorClass) const;
+	const FSpatialUnreliableRPCSettings& GetUnreliableRPCSettings(const UFunction* Function) const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
@@ -12,6 +12,7 @@ class USpatialNetDriver;
 class USpatialPackageMap;
 class USpatialTypebindingManager;
 class USpatialPackageMapClient;
+class UObjectRefPathDictionary;
 
 class UNetDriver;
 class UProperty;
@@ -20,6 +21,30 @@ enum EReplicatedPropertyGroup : uint32;
 
 using FUnresolvedObjectsMap = TMap<Schema_FieldId, TSet<const UObject*>>;
 
+// An object of a new entity, and the initial component data written for it by ComponentFactory::CreateInitialComponentDatas.
+struct FInitialObjectData
+{
+	FInitialObjectData(UObject* InObject, FClassInfo* InInfo, const FRepChangeState& InRepChanges, const FHandoverChangeState& InHandoverChanges, FArrayDeltaStates* InArrayDeltaStates, FFieldValueHashes* InFieldValueHashes)
+		: Object(InObject)
+		, Info(InInfo)
+		, RepChanges(InRepChanges)
+		, HandoverChanges(InHandoverChanges)
+		, ArrayDeltaStates(InArrayDeltaStates)
+		, FieldValueHashes(InFieldValueHashes)
+	{}
+
+	UObject* Object;
+	FClassInfo* Info;
+	FRepChangeState RepChanges;
+	FHandoverChangeState HandoverChanges;
+	FArrayDeltaStates* ArrayDeltaStates;
+	FFieldValueHashes* FieldValueHashes;
+
+	TArray<Worker_ComponentData> ComponentDatas;
+	FUnresolvedObjectsMap RepUnresolvedObjects;
+	FUnresolvedObjectsMap HandoverUnresolvedObjects;
+};
+
 namespace improbable
 {
 
@@ -28,23 +53,51 @@ class SPATIALGDK_API ComponentFactory
 public:
 	ComponentFactory(FUnresolvedObjectsMap& RepUnresolvedObjectsMap, FUnresolvedObjectsMap& HandoverUnresolvedObjectsMap, USpatialNetDriver* InNetDriver);
 
-	TArray<Worker_ComponentData> CreateComponentDatas(UObject* Object, FClassInfo* Info, const FRepChangeState& RepChangeState, const FHandoverChangeState& HandoverChangeState);
-	TArray<Worker_ComponentUpdate> CreateComponentUpdates(UObject* Object, FClassInfo* Info, const FRepChangeState* RepChangeState, const FHandoverChangeState* HandoverChangeState);
+	// Passing ArrayDeltaStates enables delta encoding for the object's replicated arrays.
+	// Passing FieldValueHashes drops fields whose value is the same as when they were last sent.
+	TArray<Worker_ComponentData> CreateComponentDatas(UObject* Object, FClassInfo* Info, const FRepChangeState& RepChangeState, const FHandoverChangeState& HandoverChangeState, FArrayDeltaStates* ArrayDeltaStates = nullptr, FFieldValueHashes* FieldValueHashes = nullptr);
+	TArray<Worker_ComponentUpdate> CreateComponentUpdates(UObject* Object, FClassInfo* Info, const FRepChangeState* RepChangeState, const FHandoverChangeState* HandoverChangeState, FArrayDeltaStates* ArrayDeltaStates = nullptr, FFieldValueHashes* FieldValueHashes = nullptr);
 
 	static Worker_ComponentData CreateEmptyComponentData(Worker_ComponentId ComponentId);
 
+	// Writes the data, owner only and handover components of every object. With USpatialGDKSettings::bEnableParallelInitialDataSerialization,
+	// each component is written by its own task on the task graph, and the results are joined before returning.
+	static void CreateInitialComponentDatas(USpatialNetDriver* NetDriver, TArray<FInitialObjectData>& Objects);
+
 private:
-	Worker_ComponentData CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup);
-	Worker_ComponentUpdate CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool& bWroteSomething);
+	Worker_ComponentData CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, FArrayDeltaStates* ArrayDeltaStates, FFieldValueHashes* FieldValueHashes);
+	Worker_ComponentUpdate CreateComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, FArrayDeltaStates* ArrayDeltaStates, FFieldValueHashes* FieldValueHashes, bool& bWroteSomething);
+
+	bool FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, FClassInfo* Info, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool bIsInitialData, FArrayDeltaStates* ArrayDeltaStates, FFieldValueHashes* FieldValueHashes, TArray<Schema_FieldId>* ClearedIds = nullptr);
 
-	bool FillSchemaObject(Schema_Object* ComponentObject, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds = nullptr);
+	Worker_ComponentData CreateHandoverComponentData(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes, FFieldValueHashes* FieldValueHashes);
+	Worker_ComponentUpdate CreateHandoverComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes, FFieldValueHashes* FieldValueHashes, bool& bWroteSomething);
 
-	Worker_ComponentData CreateHandoverComponentData(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes);
-	Worker_ComponentUpdate CreateHandoverComponentUpdate(Worker_ComponentId ComponentId, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes, bool& bWroteSomething);
+	bool FillHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes, bool bIsInitialData, FFieldValueHashes* FieldValueHashes, TArray<Schema_FieldId>* ClearedIds = nullptr);
 
-	bool FillHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, FClassInfo* Info, const FHandoverChangeState& Changes, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds = nullptr);
+	// Returns false for properties that aren't hashed and are always sent: object references, strings, structs, arrays and text.
+	// The hashed properties (numeric, enum, bool and name) hash to their exact value, so a changed value is never dropped.
+	static bool GetFieldValueHash(UProperty* Property, const uint8* Data, uint64& OutHash);
+	// Checks a changed field against the hash last sent for it. Returns true if the field should be dropped from the update.
+	bool IsFieldValueUnchanged(TMap<uint16, uint64>& LastSentHashes, uint16 Handle, UProperty* Property, uint64 ValueHash);
 
 	void AddProperty(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, const uint8* Data, TSet<const UObject*>& UnresolvedObjects, TArray<Schema_FieldId>* ClearedIds);
+	static void AddQuantizedProperty(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, const uint8* Data, const FQuantizedFloatSchemaData& Quantization);
+
+	// Writes the current value of every packed bool of a group, followed by a mask of the ones that changed.
+	static void AddPackedBools(Schema_Object* ComponentObject, UObject* Object, const FRepLayout& RepLayout, const TArray<uint16>& PackedBoolHandles, const TBitArray<>& ChangedBools);
+
+	// Writes the changed elements of an array instead of the whole array. Returns false if the array should be sent in full.
+	bool AddArrayDelta(Schema_Object* ComponentObject, const FRepChangeState& Changes, const FRepHandleIterator& HandleIterator, const uint8* Data, FArrayDeltaState& DeltaState, TSet<const UObject*>& UnresolvedObjects);
+	static bool CanUseArrayDelta(const FRepLayout& RepLayout, int32 CmdIndex);
+
+	// Writes the FastArraySerializer items whose ReplicationKey changed since the last full send, and the ReplicationIDs of removed items.
+	bool AddFastArrayDelta(Schema_Object* ComponentObject, uint16 Handle, UArrayProperty* ArrayProperty, const uint8* Data, FArrayDeltaState& DeltaState, TSet<const UObject*>& UnresolvedObjects);
+	// Writes the ReplicationIDs of a fully sent FastArraySerializer array, and records the items' keys for later deltas.
+	static void AddFastArrayItemIds(Schema_Object* ComponentObject, uint16 Handle, UArrayProperty* ArrayProperty, const uint8* Data, FArrayDeltaState& DeltaState, TArray<Schema_FieldId>* ClearedIds);
+	static bool IsFastArrayItems(const FRepLayout& RepLayout, int32 CmdIndex);
+	// Records the serialized size of a delta written since SizeBeforeDelta, against the size of the whole array written in full.
+	void RecordArrayDeltaBytes(Schema_Object* ComponentObject, uint32 SizeBeforeDelta, uint16 Handle, UArrayProperty* ArrayProperty, const uint8* Data);
 
 	USpatialNetDriver* NetDriver;
 	USpatialPackageMapClient* PackageMap;
@@ -52,6 +105,13 @@ private:
 
 	FUnresolvedObjectsMap& PendingRepUnresolvedObjectsMap;
 	FUnresolvedObjectsMap& PendingHandoverUnresolvedObjectsMap;
+
+	// Set while components are written on several threads. Taken for everything that goes through the package map or the net driver,
+	// which are object references and struct serialization.
+	FCriticalSection* SerializationLock = nullptr;
+
+	// Set while writing components that only servers can read, so object ref paths can be written as dictionary IDs.
+	UObjectRefPathDictionary* PathDictionary = nullptr;
 };
 
 }
@@ -19,11 +19,21 @@ public:
 	void ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover);
 
 private:
-	void ApplySchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds = nullptr);
+	void ApplySchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, ESchemaComponentType PropertyGroup, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds = nullptr);
 	void ApplyHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>* ClearedIds = nullptr);
 
 	void ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, UProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex);
+	void ApplyQuantizedProperty(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, uint8* Data, const FQuantizedFloatSchemaData& Quantization);
 	void ApplyArray(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex);
+	void ApplyArrayDelta(Schema_Object* DeltaObject, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex);
+
+	// FastArraySerializer arrays are applied to a copy, which NetDeltaSerialize compares with the array to call the item callbacks.
+	void ApplyFastArray(Schema_Object* ComponentObject, Schema_FieldId FieldId, UObject* Object, USpatialActorChannel* Channel, const FRepLayoutCmd& Cmd, const FRepParentCmd& Parent, uint8* Data, int32 Offset, bool bIsArrayDelta);
+	// Applies a delta of FastArraySerializer items identified by ReplicationID. ItemIds holds the ID of each item of the array, and is kept up to date.
+	void ApplyFastArrayDelta(Schema_Object* DeltaObject, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex, TArray<int32>& ItemIds);
+
+	FObjectReferencesMap* FindOrCreateArrayObjectReferences(FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, int32 Offset, int32 ParentIndex, bool& bOutNewArrayMap);
+	void StoreArrayObjectReferences(FObjectReferencesMap& InObjectReferencesMap, FObjectReferencesMap* ArrayObjectReferences, bool bNewArrayMap, UArrayProperty* Property, int32 Offset, int32 ParentIndex);
 
 	uint32 GetPropertyCount(const Schema_Object* Object, Schema_FieldId Id, UProperty* Property);
 
@@ -0,0 +1,57 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FOutgoingByteStats
+{
+	uint64 Count = 0;
+	uint64 Bytes = 0;
+};
+
+// Counts the serialized bytes sent per class, per replicated property and per RPC, so the biggest contributors to
+// outgoing traffic can be found. Enabled with USpatialGDKSettings::bEnableOutgoingByteProfiling.
+// Property bytes are the growth of the schema object when the property is written, so they include the field headers.
+class SPATIALGDK_API FOutgoingByteProfiler
+{
+public:
+	bool IsEnabled() const;
+
+	// A component update or entity creation containing data of an object of this class.
+	void RecordObjectSend(const UClass* Class, uint32 Bytes);
+	void RecordProperty(const UClass* Class, uint16 Handle, const UProperty* ParentProperty, const UProperty* Property, uint32 Bytes);
+	void RecordRPC(const UFunction* Function, uint32 Bytes);
+
+	void Reset();
+
+	// Prints the NumEntries biggest classes, properties and RPCs by bytes sent.
+	void DumpTop(FOutputDevice& Ar, int32 NumEntries) const;
+
+	// Writes every entry to a CSV file. Returns false if there was nothing to write or the file couldn't be written.
+	bool WriteCSV(const FString& FilePath) const;
+
+private:
+	struct FPropertyKey
+	{
+		const UClass* Class;
+		uint16 Handle;
+
+		bool operator==(const FPropertyKey& Other) const { return Class == Other.Class && Handle == Other.Handle; }
+		friend uint32 GetTypeHash(const FPropertyKey& Key) { return HashCombine(::GetTypeHash(Key.Class), ::GetTypeHash(Key.Handle)); }
+	};
+
+	// Names are stored on first use, so entries can still be written out after their class has been unloaded.
+	struct FNamedStats
+	{
+		FString Name;
+		FOutgoingByteStats Stats;
+	};
+
+	template <typename KeyType>
+	static TArray<const FNamedStats*> SortByBytes(const TMap<KeyType, FNamedStats>& Map);
+
+	TMap<const UClass*, FNamedStats> ClassStats;
+	TMap<FPropertyKey, FNamedStats> PropertyStats;
+	TMap<const UFunction*, FNamedStats> RPCStats;
+};
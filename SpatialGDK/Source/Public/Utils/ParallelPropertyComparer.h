@@ -0,0 +1,57 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class FObjectReplicator;
+class FReplicationChangelistMgr;
+
+struct FParallelCompareStats
+{
+	uint64 NumRuns = 0;
+	uint64 NumObjectsCompared = 0;
+	uint64 NumTasks = 0;
+	// Time the game thread spent waiting for each run to finish.
+	uint64 WallCycles = 0;
+	// Time spent comparing, summed over all tasks. Divided by WallCycles, this is the speedup over a single thread.
+	uint64 TaskCycles = 0;
+};
+
+// Runs the rep layout comparison for many objects at once, spread over task graph worker threads.
+// Comparing only reads the replicated objects and writes to their changelist state, and the game thread waits
+// for every comparison to finish, so objects can be compared in any order on any thread.
+// Once an object has been compared, FReplicationChangelistMgr::Update skips comparing it again for the rest of the
+// replication frame, so ReplicateActor picks up the result on the game thread.
+class SPATIALGDK_API FParallelPropertyComparer
+{
+public:
+	void AddObject(UObject* Object, FObjectReplicator& Replicator, const FReplicationFlags& RepFlags);
+	void AddObject(UObject* Object, FReplicationChangelistMgr& ChangelistMgr, int32& LastCompareIndex, const FReplicationFlags& RepFlags);
+
+	// Compares every object added since the last call. Returns once all comparisons have finished.
+	void Run(uint32 ReplicationFrame);
+
+	// Limits the number of tasks a run is split into. 0 uses one task per task graph worker thread, plus the game thread.
+	void SetMaxTasks(int32 InMaxTasks);
+	int32 GetNumTasks() const;
+
+	const FParallelCompareStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FParallelCompareStats(); }
+	void DumpStats(FOutputDevice& Ar) const;
+
+private:
+	struct FPendingComparison
+	{
+		UObject* Object;
+		FReplicationChangelistMgr* ChangelistMgr;
+		int32* LastCompareIndex;
+		FReplicationFlags RepFlags;
+	};
+
+	TArray<FPendingComparison> PendingComparisons;
+	int32 MaxTasks = 0;
+
+	FParallelCompareStats Stats;
+};
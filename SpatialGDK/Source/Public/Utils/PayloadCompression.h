@@ -0,0 +1,39 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialPayloadCompression, Log, All);
+
+struct FPayloadCompressionStats
+{
+	uint64 NumPayloadsWritten = 0;
+	uint64 NumPayloadsCompressed = 0;
+	// Payloads at or above the threshold that didn't get any smaller, and were sent uncompressed.
+	uint64 NumIncompressible = 0;
+	uint64 UncompressedBytes = 0;
+	uint64 CompressedBytes = 0;
+	uint64 CompressCycles = 0;
+
+	uint64 NumPayloadsDecompressed = 0;
+	uint64 DecompressCycles = 0;
+	// Received payloads that were truncated or claimed an uncompressed size above the limit, and were dropped.
+	uint64 NumPayloadsRejected = 0;
+};
+
+namespace improbable
+{
+
+// Struct properties and RPC parameters are written to schema as bytes fields. With USpatialGDKSettings::bEnablePayloadCompression,
+// each such field starts with a byte saying how the rest is encoded, and payloads of at least PayloadCompressionThreshold bytes
+// are compressed with zlib when that makes them smaller. All workers in a deployment must use the same setting.
+void AddCompressiblePayloadToSchema(Schema_Object* Object, Schema_FieldId Id, const uint8* Data, uint32 Size);
+TArray<uint8> IndexCompressiblePayloadFromSchema(const Schema_Object* Object, Schema_FieldId Id, uint32 Index);
+
+FPayloadCompressionStats& GetPayloadCompressionStats();
+void DumpPayloadCompressionStats(FOutputDevice& Ar);
+
+}
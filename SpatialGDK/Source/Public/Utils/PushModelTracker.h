@@ -0,0 +1,78 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+// Marks a replicated property as changed on an object whose actor class uses push model replication.
+// Dirty state is tracked per object, not per property: see improbable::PushModel::MarkPropertyDirty.
+// For example: MARK_SPATIAL_PROPERTY_DIRTY(this, AMyCharacter, Health);
+#define MARK_SPATIAL_PROPERTY_DIRTY(Object, ClassName, PropertyName) \
+	do \
+	{ \
+		static UProperty* SpatialPushModelProperty = FindFieldChecked<UProperty>(ClassName::StaticClass(), GET_MEMBER_NAME_CHECKED(ClassName, PropertyName)); \
+		improbable::PushModel::MarkPropertyDirty(Object, SpatialPushModelProperty); \
+	} while (0)
+
+namespace improbable
+{
+namespace PushModel
+{
+// Marks a replicated property as changed, so the object is compared on its next replication.
+// Dirty state is tracked per object: the property only names what changed, and the next replication compares every
+// replicated property of the object. Marking one property is the same as MarkObjectDirty.
+SPATIALGDK_API void MarkPropertyDirty(UObject* Object, const UProperty* Property);
+
+// Slower version of MarkPropertyDirty for properties that can't be named from game code, e.g. protected engine properties.
+SPATIALGDK_API void MarkPropertyDirty(UObject* Object, FName PropertyName);
+
+// Marks every replicated property of the object as changed.
+SPATIALGDK_API void MarkObjectDirty(UObject* Object);
+}
+}
+
+struct FPushModelStats
+{
+	// Objects whose comparison was skipped because nothing was marked dirty.
+	uint64 NumSkippedObjects = 0;
+	uint64 NumPushCompares = 0;
+	uint64 NumFullCompares = 0;
+	// Dirty entries dropped because their object was destroyed or no longer has an actor channel.
+	uint64 NumPrunedObjects = 0;
+	uint64 PushCompareCycles = 0;
+	uint64 FullCompareCycles = 0;
+};
+
+// Records which objects game code has marked dirty, for actor classes using push model replication.
+// Only objects are tracked, not properties, as a dirty object is compared through its rep layout as a whole.
+class SPATIALGDK_API FPushModelTracker
+{
+public:
+	// Marks the whole object dirty. Property is only used to check that it's replicated.
+	void MarkPropertyDirty(const UObject* Object, const UProperty* Property);
+	void MarkObjectDirty(const UObject* Object);
+
+	// Clears the dirty state of an object. Returns false if nothing was marked.
+	bool ConsumeDirtyState(const UObject* Object);
+
+	void Remove(const UObject* Object);
+
+	// Drops entries for destroyed objects and for objects whose actor has no actor channel, which are never consumed.
+	void PruneObjectsWithoutChannels(class USpatialNetDriver* NetDriver);
+
+	// Whether actors of this class, and their replicated subobjects, use push model replication.
+	bool IsPushModelClass(const UClass* ActorClass);
+
+	FPushModelStats& GetStats() { return Stats; }
+	void DumpStats(FOutputDevice& Ar) const;
+
+private:
+	// Whether the object belongs to a push model actor, so marks on other objects are dropped instead of piling up.
+	bool ShouldTrack(const UObject* Object);
+
+	TSet<TWeakObjectPtr<const UObject>> DirtyObjects;
+	TMap<const UClass*, bool> PushModelClassCache;
+
+	FPushModelStats Stats;
+};
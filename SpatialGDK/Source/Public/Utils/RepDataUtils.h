@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Containers/Array.h"
+#include "Containers/BitArray.h"
+#include "Containers/Map.h"
 #include "HAL/Platform.h"
 #include "Net/RepLayout.h"
 
@@ -14,3 +16,36 @@ struct FRepChangeState
 };
 
 using FHandoverChangeState = TArray<uint16>; // changed handover properties
+
+// Delta encoding state for a replicated array. Tracks every element written since the array was last sent in full,
+// so a delta containing those elements and the new length brings the last full copy of the array up to date.
+struct FArrayDeltaState
+{
+	TBitArray<> DirtyIndices;
+	int32 MinNumSinceFullSend = 0;
+
+	// Set when the last full send didn't go out, e.g. because of unresolved object references.
+	bool bNeedsFullSend = true;
+
+	// Whether a delta has been sent since the last full send, which then has to clear it.
+	bool bHasSentDelta = false;
+
+	// For FastArraySerializer items, the ReplicationKey of each item at the last full send, keyed by ReplicationID.
+	// Used instead of DirtyIndices, as removing items moves the others to different indices.
+	TMap<int32, int32> FastArrayItemKeys;
+};
+
+using FArrayDeltaStates = TMap<uint16, FArrayDeltaState>; // keyed by rep handle
+
+// ReplicationIDs the sending worker gave the items of a received FastArraySerializer array, in the order of the local array.
+using FFastArrayItemIds = TMap<uint16, TArray<int32>>; // keyed by rep handle
+
+// Value hashes of the scalar fields last sent for an object, keyed by handle. A field whose current value hashes the same
+// as what was last sent is dropped from the update, even if the rep layout or handover comparison reported it as changed.
+// That happens when a value changes and changes back while its actor is deferred: the comparisons of the deferred ticks
+// are merged into one changelist, which includes the field although its value is what the entity already holds.
+struct FFieldValueHashes
+{
+	TMap<uint16, uint64> RepHashes;
+	TMap<uint16, uint64> HandoverHashes;
+};
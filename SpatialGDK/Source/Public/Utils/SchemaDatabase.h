@@ -33,6 +33,40 @@ struct FSchemaData
 	TMap<uint32, FSubobjectSchemaData> SubobjectData;
 };
 
+// Floats written as an unsigned integer of NumBits bits, spread evenly over [Min, Max].
+USTRUCT()
+struct FQuantizedFloatSchemaData
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(VisibleAnywhere)
+	float Min = 0.0f;
+
+	UPROPERTY(VisibleAnywhere)
+	float Max = 0.0f;
+
+	UPROPERTY(VisibleAnywhere)
+	uint32 NumBits = 0;
+};
+
+// Replicated fields that aren't written as their own schema field, keyed by rep handle.
+USTRUCT()
+struct FFieldEncodingSchemaData
+{
+	GENERATED_USTRUCT_BODY()
+
+	// Bools written together as one bitfield, in bit order.
+	UPROPERTY(VisibleAnywhere)
+	TArray<uint32> MultiClientPackedBoolHandles;
+
+	UPROPERTY(VisibleAnywhere)
+	TArray<uint32> SingleClientPackedBoolHandles;
+
+	// Floats and vectors written with quantization metadata, see SchemaGenerator.
+	UPROPERTY(VisibleAnywhere)
+	TMap<uint32, FQuantizedFloatSchemaData> QuantizedFloats;
+};
+
 UCLASS()
 class SPATIALGDK_API USchemaDatabase : public UDataAsset
 {
@@ -41,4 +75,8 @@ class SPATIALGDK_API USchemaDatabase : public UDataAsset
 public:
 	UPROPERTY(VisibleAnywhere)
 	TMap<FString, FSchemaData> ClassPathToSchema;
+
+	// Only classes with packed or quantized fields have an entry.
+	UPROPERTY(VisibleAnywhere)
+	TMap<FString, FFieldEncodingSchemaData> ClassPathToFieldEncoding;
 };
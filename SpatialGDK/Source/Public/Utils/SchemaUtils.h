@@ -3,7 +3,10 @@
 #pragma once
 
 #include "EngineClasses/SpatialNetBitWriter.h"
+#include "Interop/ObjectRefPathDictionary.h"
 #include "UObject/improbable/UnrealObjectRef.h"
+#include "Utils/PayloadCompression.h"
+#include "Utils/SchemaDatabase.h"
 
 #include <WorkerSDK/improbable/c_schema.h>
 #include <WorkerSDK/improbable/c_worker.h>
@@ -38,16 +41,12 @@ inline FString GetStringFromSchema(const Schema_Object* Object, Schema_FieldId I
 
 inline void AddPayloadToSchema(Schema_Object* Object, Schema_FieldId Id, FSpatialNetBitWriter& Writer)
 {
-	uint32 PayloadSize = Writer.GetNumBytes();
-	uint8* PayloadBuffer = Schema_AllocateBuffer(Object, sizeof(char) * PayloadSize);
-	FMemory::Memcpy(PayloadBuffer, Writer.GetData(), sizeof(char) * PayloadSize);
-	Schema_AddBytes(Object, Id, PayloadBuffer, sizeof(char) * PayloadSize);
+	AddCompressiblePayloadToSchema(Object, Id, Writer.GetData(), Writer.GetNumBytes());
 }
 
 inline TArray<uint8> IndexPayloadFromSchema(const Schema_Object* Object, Schema_FieldId Id, uint32 Index)
 {
-	int32 PayloadSize = (int32)Schema_IndexBytesLength(Object, Id, Index);
-	return TArray<uint8>((const uint8*)Schema_IndexBytes(Object, Id, Index), PayloadSize);
+	return IndexCompressiblePayloadFromSchema(Object, Id, Index);
 }
 
 inline TArray<uint8> GetPayloadFromSchema(const Schema_Object* Object, Schema_FieldId Id)
@@ -55,6 +54,83 @@ inline TArray<uint8> GetPayloadFromSchema(const Schema_Object* Object, Schema_Fi
 	return IndexPayloadFromSchema(Object, Id, 0);
 }
 
+inline uint32 GetMaxQuantizedValue(const FQuantizedFloatSchemaData& Quantization)
+{
+	return Quantization.NumBits >= 32 ? MAX_uint32 : (1u << Quantization.NumBits) - 1;
+}
+
+// Values are clamped to [Min, Max] and rounded to the nearest of the 2^NumBits evenly spaced steps.
+// NaN, and any value of an empty range, is written as Min, as casting NaN to an integer is undefined.
+inline void AddQuantizedFloatToSchema(Schema_Object* Object, Schema_FieldId Id, float Value, const FQuantizedFloatSchemaData& Quantization)
+{
+	if (FMath::IsNaN(Value) || !(Quantization.Max > Quantization.Min))
+	{
+		Schema_AddUint32(Object, Id, 0);
+		return;
+	}
+
+	const double Alpha = ((double)FMath::Clamp(Value, Quantization.Min, Quantization.Max) - Quantization.Min) / ((double)Quantization.Max - Quantization.Min);
+	Schema_AddUint32(Object, Id, (uint32)(Alpha * GetMaxQuantizedValue(Quantization) + 0.5));
+}
+
+inline float IndexQuantizedFloatFromSchema(const Schema_Object* Object, Schema_FieldId Id, uint32 Index, const FQuantizedFloatSchemaData& Quantization)
+{
+	const uint32 MaxQuantizedValue = GetMaxQuantizedValue(Quantization);
+	if (MaxQuantizedValue == 0)
+	{
+		return Quantization.Min;
+	}
+
+	const uint32 QuantizedValue = FMath::Min(Schema_IndexUint32(Object, Id, Index), MaxQuantizedValue);
+	return (float)(Quantization.Min + (double)QuantizedValue / MaxQuantizedValue * ((double)Quantization.Max - Quantization.Min));
+}
+
+// Writes the values of a set of bools as a bitfield, followed by a bitfield of the ones that changed.
+inline void AddPackedBoolsToSchema(Schema_Object* Object, Schema_FieldId Id, const TBitArray<>& Values, const TBitArray<>& ChangedMask)
+{
+	check(Values.Num() == ChangedMask.Num());
+	const int32 NumBytes = (Values.Num() + 7) / 8;
+	uint8* Buffer = Schema_AllocateBuffer(Object, NumBytes * 2);
+	FMemory::Memzero(Buffer, NumBytes * 2);
+
+	for (int32 BitIndex = 0; BitIndex < Values.Num(); BitIndex++)
+	{
+		const uint8 BitMask = 1 << (BitIndex % 8);
+		if (Values[BitIndex])
+		{
+			Buffer[BitIndex / 8] |= BitMask;
+		}
+		if (ChangedMask[BitIndex])
+		{
+			Buffer[NumBytes + BitIndex / 8] |= BitMask;
+		}
+	}
+
+	Schema_AddBytes(Object, Id, Buffer, NumBytes * 2);
+}
+
+// Returns false if the field doesn't hold exactly NumBools packed bools.
+inline bool GetPackedBoolsFromSchema(const Schema_Object* Object, Schema_FieldId Id, int32 NumBools, TBitArray<>& OutValues, TBitArray<>& OutChangedMask)
+{
+	const int32 NumBytes = (NumBools + 7) / 8;
+	if (NumBytes == 0 || Schema_GetBytesCount(Object, Id) == 0 || (int32)Schema_GetBytesLength(Object, Id) != NumBytes * 2)
+	{
+		return false;
+	}
+
+	const uint8* Bits = (const uint8*)Schema_GetBytes(Object, Id);
+	OutValues.Init(false, NumBools);
+	OutChangedMask.Init(false, NumBools);
+	for (int32 BitIndex = 0; BitIndex < NumBools; BitIndex++)
+	{
+		const uint8 BitMask = 1 << (BitIndex % 8);
+		OutValues[BitIndex] = (Bits[BitIndex / 8] & BitMask) != 0;
+		OutChangedMask[BitIndex] = (Bits[NumBytes + BitIndex / 8] & BitMask) != 0;
+	}
+
+	return true;
+}
+
 inline void AddWorkerRequirementSetToSchema(Schema_Object* Object, Schema_FieldId Id, const WorkerRequirementSet& Value)
 {
 	Schema_Object* RequirementSetObject = Schema_AddObject(Object, Id);
@@ -96,21 +172,9 @@ inline WorkerRequirementSet GetWorkerRequirementSetFromSchema(Schema_Object* Obj
 	return RequirementSet;
 }
 
-inline void AddObjectRefToSchema(Schema_Object* Object, Schema_FieldId Id, const FUnrealObjectRef& ObjectRef)
-{
-	Schema_Object* ObjectRefObject = Schema_AddObject(Object, Id);
-
-	Schema_AddEntityId(ObjectRefObject, 1, ObjectRef.Entity);
-	Schema_AddUint32(ObjectRefObject, 2, ObjectRef.Offset);
-	if (ObjectRef.Path)
-	{
-		AddStringToSchema(ObjectRefObject, 3, *ObjectRef.Path);
-	}
-	if (ObjectRef.Outer)
-	{
-		AddObjectRefToSchema(ObjectRefObject, 4, *ObjectRef.Outer);
-	}
-}
+// With a PathDictionary, paths in the dictionary are written as their ID, see UObjectRefPathDictionary.
+// Only pass one when every worker that can read the field is a server.
+void AddObjectRefToSchema(Schema_Object* Object, Schema_FieldId Id, const FUnrealObjectRef& ObjectRef, UObjectRefPathDictionary* PathDictionary = nullptr);
 
 FUnrealObjectRef GetObjectRefFromSchema(Schema_Object* Object, Schema_FieldId Id);
 
@@ -126,6 +190,10 @@ inline FUnrealObjectRef IndexObjectRefFromSchema(Schema_Object* Object, Schema_F
 	{
 		ObjectRef.Path = GetStringFromSchema(ObjectRefObject, 3);
 	}
+	else if (Schema_GetUint32Count(ObjectRefObject, 5) > 0)
+	{
+		ObjectRef.Path = UObjectRefPathDictionary::MakePlaceholderPath(Schema_GetUint32(ObjectRefObject, 5));
+	}
 	if (Schema_GetObjectCount(ObjectRefObject, 4) > 0)
 	{
 		ObjectRef.Outer = FUnrealObjectRef(GetObjectRefFromSchema(ObjectRefObject, 4));
@@ -183,6 +251,23 @@ inline Schema_ComponentData* DeepCopyComponentData(Schema_ComponentData* Source)
 	return Copy;
 }
 
+// Serialized sizes of the schema payloads the worker SDK sends, used for bandwidth accounting.
+inline uint32 GetComponentDataSize(const Worker_ComponentData& Data)
+{
+	return Schema_GetWriteBufferLength(Schema_GetComponentDataFields(Data.schema_type));
+}
+
+inline uint32 GetComponentUpdateSize(const Worker_ComponentUpdate& Update)
+{
+	return Schema_GetWriteBufferLength(Schema_GetComponentUpdateFields(Update.schema_type))
+		+ Schema_GetWriteBufferLength(Schema_GetComponentUpdateEvents(Update.schema_type));
+}
+
+inline uint32 GetCommandRequestSize(const Worker_CommandRequest& Request)
+{
+	return Schema_GetWriteBufferLength(Schema_GetCommandRequestObject(Request.schema_type));
+}
+
 // Generates the full path from an ObjectRef, if it has paths. Writes the result to OutPath.
 // Does not clear OutPath first.
 void GetFullPathFromUnrealObjectReference(const FUnrealObjectRef& ObjectRef, FString& OutPath);
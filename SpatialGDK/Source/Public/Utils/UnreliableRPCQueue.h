@@ -0,0 +1,47 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FPendingRPCParams;
+
+struct FUnreliableRPCStats
+{
+	uint64 Queued = 0;
+	uint64 Sent = 0;
+	// Times an RPC was left in the queue because the tick's budget was used up by higher priority RPCs.
+	uint64 Deferred = 0;
+	// RPCs that waited longer than their max age and were never sent.
+	uint64 Dropped = 0;
+};
+
+// Holds outgoing unreliable RPCs until the end of the frame, so they can be sent within a per-tick budget.
+// When more RPCs are queued than the budget allows, the highest priority ones are sent and the rest wait for
+// later ticks until they're older than their max age. Priority and max age are configured per function in
+// USpatialGDKSettings. RPCs that are sent go out in the order they were called.
+class SPATIALGDK_API FUnreliableRPCQueue
+{
+public:
+	void Enqueue(TSharedRef<FPendingRPCParams> Params);
+
+	// Drops stale RPCs and sends up to MaxRPCs of the rest through SendRPC. 0 sends every queued RPC.
+	void Flush(uint32 MaxRPCs, TFunctionRef<void(TSharedRef<FPendingRPCParams>)> SendRPC);
+
+	int32 Num() const { return Queue.Num(); }
+
+	void ResetStats() { Stats.Empty(); }
+	void DumpStats(FOutputDevice& Ar) const;
+
+private:
+	struct FQueuedRPC
+	{
+		TSharedRef<FPendingRPCParams> Params;
+		float Priority;
+		double ExpiryTime;
+	};
+
+	TArray<FQueuedRPC> Queue;
+
+	TMap<const UFunction*, FUnreliableRPCStats> Stats;
+};
@@ -0,0 +1,101 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class USpatialActorChannel;
+
+using FChannelObjectPair = TPair<TWeakObjectPtr<USpatialActorChannel>, TWeakObjectPtr<UObject>>;
+
+// A replicated property that could not be sent because it references objects which do not have an entity yet.
+struct FPendingOutgoingProperty
+{
+	FChannelObjectPair ChannelObjectPair;
+	uint16 Handle;
+
+	// Dynamic arrays need extra handles when the property is put back into a changelist.
+	bool bIsDynamicArray;
+};
+
+// Tracks outgoing properties waiting on unresolved object references.
+//
+// Pending properties, unresolved objects and the links between them live in flat slot arrays with free lists,
+// so queueing and resolving references doesn't allocate once the table has warmed up. Each unresolved object
+// heads an intrusive list of links to the properties depending on it, so resolving an object only touches
+// its own dependents.
+class SPATIALGDK_API FUnresolvedReferenceTable
+{
+public:
+	// Starts tracking a property. Replaces any existing entry for the same property.
+	void Add(const FChannelObjectPair& ChannelObjectPair, uint16 Handle, bool bIsDynamicArray, const TSet<const UObject*>& UnresolvedObjects);
+
+	// Stops tracking a property, e.g. because it has been sent again with a new value.
+	void Remove(const FChannelObjectPair& ChannelObjectPair, uint16 Handle);
+
+	// Marks an object as resolved. Properties that no longer depend on any unresolved object are appended to OutReadyProperties.
+	void Resolve(const UObject* Object, TArray<FPendingOutgoingProperty>& OutReadyProperties);
+
+	int32 GetNumPendingProperties() const { return PropertyKeyToHandle.Num(); }
+	int32 GetNumUnresolvedObjects() const { return ObjectToSlot.Num(); }
+
+private:
+	using FPropertyKey = TPair<FChannelObjectPair, uint16>;
+
+	// Generation-checked index into PropertySlots.
+	struct FPropertyHandle
+	{
+		int32 Index;
+		uint32 Generation;
+	};
+
+	struct FPropertySlot
+	{
+		FPendingOutgoingProperty Property;
+		uint32 Generation = 0;
+		int32 FirstLink = INDEX_NONE;
+		int32 NumUnresolved = 0;
+		int32 NextFree = INDEX_NONE;
+	};
+
+	struct FObjectSlot
+	{
+		const UObject* Object = nullptr;
+		int32 FirstLink = INDEX_NONE;
+		int32 NextFree = INDEX_NONE;
+	};
+
+	// Connects one pending property to one unresolved object.
+	// Each link is in a singly linked list owned by its property, and a doubly linked list owned by its object.
+	struct FLink
+	{
+		int32 PropertyIndex = INDEX_NONE;
+		int32 ObjectIndex = INDEX_NONE; // INDEX_NONE once the object has been resolved
+		int32 NextInProperty = INDEX_NONE;
+		int32 PrevInObject = INDEX_NONE;
+		int32 NextInObject = INDEX_NONE;
+		int32 NextFree = INDEX_NONE;
+	};
+
+	template <typename T>
+	static int32 AllocateSlot(TArray<T>& Slots, int32& FirstFree);
+
+	template <typename T>
+	static void ReleaseSlot(TArray<T>& Slots, int32& FirstFree, int32 Index);
+
+	int32 FindOrAddObjectSlot(const UObject* Object);
+	void UnlinkFromObject(int32 LinkIndex);
+	void ReleaseProperty(int32 PropertyIndex);
+
+	TArray<FPropertySlot> PropertySlots;
+	TArray<FObjectSlot> ObjectSlots;
+	TArray<FLink> Links;
+
+	int32 FirstFreePropertySlot = INDEX_NONE;
+	int32 FirstFreeObjectSlot = INDEX_NONE;
+	int32 FirstFreeLink = INDEX_NONE;
+
+	TMap<FPropertyKey, FPropertyHandle> PropertyKeyToHandle;
+	TMap<const UObject*, int32> ObjectToSlot;
+};
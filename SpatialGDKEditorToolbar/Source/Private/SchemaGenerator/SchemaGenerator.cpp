@@ -5,7 +5,9 @@
 #include "Algo/Reverse.h"
 
 #include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/NetSerialization.h"
 #include "Engine/SCS_Node.h"
+#include "SpatialConstants.h"
 #include "SpatialTypebindingManager.h"
 #include "Utils/CodeWriter.h"
 #include "Utils/ComponentIdGenerator.h"
@@ -155,15 +157,178 @@ FString PropertyToSchemaType(UProperty* Property, bool bIsRPCProperty)
 	return DataType;
 }
 
-void WriteSchemaRepField(FCodeWriter& Writer, const TSharedPtr<FUnrealProperty> RepProp, const int FieldCounter)
+void WriteSchemaRepField(FCodeWriter& Writer, const TSharedPtr<FUnrealProperty> RepProp, const int FieldCounter, bool bIsQuantized)
 {
+	// Quantized floats are written as integers, and vectors as a list of three of them.
+	const FString DataType = bIsQuantized
+		? FString(RepProp->Property->IsA<UFloatProperty>() ? TEXT("uint32") : TEXT("list<uint32>"))
+		: PropertyToSchemaType(RepProp->Property, false);
+
 	Writer.Printf("{0} {1} = {2};",
-		*PropertyToSchemaType(RepProp->Property, false),
+		*DataType,
 		*SchemaFieldName(RepProp),
 		FieldCounter
 	);
 }
 
+// Returns the handles of the bools that are written together as one bitfield, in bit order.
+// The bitfield's field header is bigger than a bool field, so there have to be a few bools before packing them pays off.
+TArray<uint16> GetPackedBoolHandles(const FCmdHandlePropertyMap& RepProps)
+{
+	const int32 MinNumPackedBools = 4;
+
+	TArray<uint16> BoolHandles;
+	for (auto& RepProp : RepProps)
+	{
+		if (RepProp.Value->Property->IsA<UBoolProperty>())
+		{
+			BoolHandles.Add(RepProp.Key);
+		}
+	}
+
+	if (BoolHandles.Num() < MinNumPackedBools)
+	{
+		BoolHandles.Reset();
+	}
+
+	return BoolHandles;
+}
+
+// Floats and FVectors are quantized when the property, or a struct property it's a member of, has metadata such as
+// meta = (SpatialQuantizeMin = "-1000", SpatialQuantizeMax = "1000", SpatialQuantizeBits = "16").
+bool GetQuantizedFloatData(const TSharedPtr<FUnrealProperty> RepProp, FQuantizedFloatSchemaData& OutData)
+{
+	UProperty* Property = RepProp->Property;
+	UStructProperty* StructProperty = Cast<UStructProperty>(Property);
+	if (!Property->IsA<UFloatProperty>() && (StructProperty == nullptr || StructProperty->Struct != TBaseStructure<FVector>::Get()))
+	{
+		return false;
+	}
+
+	// Metadata closest to the leaf property wins.
+	TArray<TSharedPtr<FUnrealProperty>> PropertyChain = GetPropertyChain(RepProp);
+	for (int32 i = PropertyChain.Num() - 1; i >= 0; i--)
+	{
+		UProperty* ChainProperty = PropertyChain[i]->Property;
+		if (!ChainProperty->HasMetaData(TEXT("SpatialQuantizeBits")))
+		{
+			continue;
+		}
+
+		OutData.Min = FCString::Atof(*ChainProperty->GetMetaData(TEXT("SpatialQuantizeMin")));
+		OutData.Max = FCString::Atof(*ChainProperty->GetMetaData(TEXT("SpatialQuantizeMax")));
+		OutData.NumBits = FMath::Clamp(FCString::Atoi(*ChainProperty->GetMetaData(TEXT("SpatialQuantizeBits"))), 1, 32);
+
+		if (!(OutData.Max > OutData.Min))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Ignoring quantization of %s: SpatialQuantizeMax must be greater than SpatialQuantizeMin."), *SchemaFieldName(RepProp));
+			return false;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+// Matches ComponentFactory::IsFastArrayItems: the items array of a replicated FFastArraySerializer.
+bool IsFastArrayItemsProperty(const TSharedPtr<FUnrealProperty> RepProp)
+{
+	UArrayProperty* ArrayProperty = Cast<UArrayProperty>(RepProp->Property);
+	UStructProperty* InnerStruct = ArrayProperty ? Cast<UStructProperty>(ArrayProperty->Inner) : nullptr;
+	if (InnerStruct == nullptr || !InnerStruct->Struct->IsChildOf(FFastArraySerializerItem::StaticStruct()))
+	{
+		return false;
+	}
+
+	UStructProperty* ParentStruct = Cast<UStructProperty>(GetPropertyChain(RepProp)[0]->Property);
+	return ParentStruct != nullptr && ParentStruct->Struct->IsChildOf(FFastArraySerializer::StaticStruct());
+}
+
+// Writes the types used to send changed elements of replicated arrays, see ComponentFactory::AddArrayDelta.
+void WriteSchemaArrayDeltaTypes(FCodeWriter& Writer, EReplicatedPropertyGroup Group, UClass* Class, const FCmdHandlePropertyMap& RepProps)
+{
+	for (auto& RepProp : RepProps)
+	{
+		UArrayProperty* ArrayProperty = Cast<UArrayProperty>(RepProp.Value->Property);
+		if (ArrayProperty == nullptr)
+		{
+			continue;
+		}
+
+		Writer.PrintNewLine();
+		Writer.Printf("type {0} {", *SchemaArrayDeltaTypeName(Group, Class, RepProp.Key));
+		Writer.Indent();
+		Writer.Printf("uint32 length = {0};", SpatialConstants::ARRAY_DELTA_LENGTH_ID);
+		Writer.Printf("list<uint32> indices = {0};", SpatialConstants::ARRAY_DELTA_INDICES_ID);
+		Writer.Printf("{0} values = {1};", *PropertyToSchemaType(ArrayProperty, false), SpatialConstants::ARRAY_DELTA_VALUES_ID);
+		if (IsFastArrayItemsProperty(RepProp.Value))
+		{
+			// Fast array deltas identify items by ReplicationID rather than by index.
+			Writer.Printf("list<int32> item_ids = {0};", SpatialConstants::FAST_ARRAY_DELTA_ITEM_IDS_ID);
+			Writer.Printf("list<int32> removed_item_ids = {0};", SpatialConstants::FAST_ARRAY_DELTA_REMOVED_ITEM_IDS_ID);
+		}
+		Writer.Outdent().Print("}");
+	}
+}
+
+void WriteSchemaArrayDeltaField(FCodeWriter& Writer, EReplicatedPropertyGroup Group, UClass* Class, const TSharedPtr<FUnrealProperty> RepProp, const uint16 Handle)
+{
+	if (!RepProp->Property->IsA<UArrayProperty>())
+	{
+		return;
+	}
+
+	Writer.Printf("option<{0}> {1}_delta = {2};",
+		*SchemaArrayDeltaTypeName(Group, Class, Handle),
+		*SchemaFieldName(RepProp),
+		Handle + SpatialConstants::ARRAY_DELTA_FIELD_ID_OFFSET
+	);
+}
+
+// Writes the fields of a replicated property group, and records the packed and quantized ones for the runtime.
+void WriteSchemaRepFields(FCodeWriter& Writer, EReplicatedPropertyGroup Group, UClass* Class, const FCmdHandlePropertyMap& RepProps)
+{
+	TArray<uint16> PackedBoolHandles = GetPackedBoolHandles(RepProps);
+
+	for (auto& RepProp : RepProps)
+	{
+		const uint16 Handle = RepProp.Value->ReplicationData->Handle;
+		if (PackedBoolHandles.Contains(Handle))
+		{
+			continue;
+		}
+
+		FQuantizedFloatSchemaData QuantizedData;
+		const bool bIsQuantized = GetQuantizedFloatData(RepProp.Value, QuantizedData);
+		if (bIsQuantized)
+		{
+			ClassPathToFieldEncoding.FindOrAdd(Class->GetPathName()).QuantizedFloats.Add(Handle, QuantizedData);
+		}
+
+		WriteSchemaRepField(Writer, RepProp.Value, Handle, bIsQuantized);
+		WriteSchemaArrayDeltaField(Writer, Group, Class, RepProp.Value, Handle);
+
+		if (IsFastArrayItemsProperty(RepProp.Value))
+		{
+			Writer.Printf("list<int32> {0}_item_ids = {1};", *SchemaFieldName(RepProp.Value), Handle + SpatialConstants::FAST_ARRAY_ITEM_IDS_FIELD_ID_OFFSET);
+		}
+	}
+
+	if (PackedBoolHandles.Num() > 0)
+	{
+		Writer.Printf("bytes packed_bools = {0};", SpatialConstants::PACKED_BOOLS_FIELD_ID);
+
+		FFieldEncodingSchemaData& FieldEncoding = ClassPathToFieldEncoding.FindOrAdd(Class->GetPathName());
+		TArray<uint32>& GroupPackedBoolHandles = Group == REP_MultiClient ? FieldEncoding.MultiClientPackedBoolHandles : FieldEncoding.SingleClientPackedBoolHandles;
+		GroupPackedBoolHandles.Reset();
+		for (uint16 Handle : PackedBoolHandles)
+		{
+			GroupPackedBoolHandles.Add(Handle);
+		}
+	}
+}
+
 void WriteSchemaHandoverField(FCodeWriter& Writer, const TSharedPtr<FUnrealProperty> HandoverProp, const int FieldCounter)
 {
 	Writer.Printf("{0} {1} = {2};",
@@ -251,15 +416,12 @@ void GenerateSubobjectSchema(UClass* Class, TSharedPtr<FUnrealType> TypeInfo, FS
 			continue;
 		}
 
+		WriteSchemaArrayDeltaTypes(Writer, Group, Class, RepData[Group]);
+
 		Writer.PrintNewLine();
 		Writer.Printf("type {0} {", *SchemaReplicatedDataName(Group, Class));
 		Writer.Indent();
-		for (auto& RepProp : RepData[Group])
-		{
-			WriteSchemaRepField(Writer,
-				RepProp.Value,
-				RepProp.Value->ReplicationData->Handle);
-		}
+		WriteSchemaRepFields(Writer, Group, Class, RepData[Group]);
 		Writer.Outdent().Print("}");
 	}
 
@@ -313,6 +475,8 @@ int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType>
 			continue;
 		}
 
+		WriteSchemaArrayDeltaTypes(Writer, Group, Class, RepData[Group]);
+
 		Writer.PrintNewLine();
 
 		Writer.Printf("component {0} {", *SchemaReplicatedDataName(Group, Class));
@@ -321,14 +485,7 @@ int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType>
 
 		ActorSchemaData.SchemaComponents[PropertyGroupToSchemaComponentType(Group)] = IdGenerator.GetCurrentId();
 
-		int FieldCounter = 0;
-		for (auto& RepProp : RepData[Group])
-		{
-			FieldCounter++;
-			WriteSchemaRepField(Writer,
-				RepProp.Value,
-				RepProp.Value->ReplicationData->Handle);
-		}
+		WriteSchemaRepFields(Writer, Group, Class, RepData[Group]);
 
 		Writer.Outdent().Print("}");
 	}
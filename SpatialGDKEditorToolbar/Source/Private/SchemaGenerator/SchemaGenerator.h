@@ -10,6 +10,7 @@ struct FComponentIdGenerator;
 
 extern TArray<UClass*> SchemaGeneratedClasses;
 extern TMap<FString, FSchemaData> ClassPathToSchema;
+extern TMap<FString, FFieldEncodingSchemaData> ClassPathToFieldEncoding;
 
 // Generates a schema file, given an output code writer, component ID, Unreal type and type info.
 int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType> TypeInfo, FString SchemaPath);
@@ -25,6 +25,7 @@ DEFINE_LOG_CATEGORY(LogSpatialGDKSchemaGenerator);
 
 TArray<UClass*> SchemaGeneratedClasses;
 TMap<FString, FSchemaData> ClassPathToSchema;
+TMap<FString, FFieldEncodingSchemaData> ClassPathToFieldEncoding;
 
 namespace
 {
@@ -106,6 +107,7 @@ void SaveSchemaDatabase()
 
 		USchemaDatabase* SchemaDatabase = NewObject<USchemaDatabase>(Package, USchemaDatabase::StaticClass(), FName("SchemaDatabase"), EObjectFlags::RF_Public | EObjectFlags::RF_Standalone);
 		SchemaDatabase->ClassPathToSchema = ClassPathToSchema;
+		SchemaDatabase->ClassPathToFieldEncoding = ClassPathToFieldEncoding;
 
 		FAssetRegistryModule::AssetCreated(SchemaDatabase);
 		SchemaDatabase->MarkPackageDirty();
@@ -184,6 +186,7 @@ TArray<UClass*> GetAllSupportedClasses()
 bool SpatialGDKGenerateSchema()
 {
 	ClassPathToSchema.Empty();
+	ClassPathToFieldEncoding.Empty();
 
 	const USpatialGDKEditorToolbarSettings* SpatialGDKToolbarSettings = GetDefault<USpatialGDKEditorToolbarSettings>();
 
@@ -43,6 +43,11 @@ FString SchemaReplicatedDataName(EReplicatedPropertyGroup Group, UStruct* Type,
 	return FString::Printf(TEXT("%s%s%s"), bPrependNamespace ? *GetNamespace(Type) : TEXT(""), *UnrealNameToSchemaComponentName(Type->GetName()), *GetReplicatedPropertyGroupName(Group));
 }
 
+FString SchemaArrayDeltaTypeName(EReplicatedPropertyGroup Group, UStruct* Type, uint16 Handle)
+{
+	return FString::Printf(TEXT("%sArrayDelta%d"), *SchemaReplicatedDataName(Group, Type), Handle);
+}
+
 FString SchemaHandoverDataName(UStruct* Type, bool bPrependNamespace /*= false*/)
 {
 	return FString::Printf(TEXT("%s%sHandover"), bPrependNamespace ? *GetNamespace(Type) : TEXT(""), *UnrealNameToSchemaComponentName(Type->GetName()));
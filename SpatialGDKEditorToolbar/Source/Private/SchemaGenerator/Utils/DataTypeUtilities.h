@@ -19,6 +19,10 @@ FString UnrealNameToSchemaComponentName(const FString& UnrealName);
 // For example: UnrealCharacterMultiClientRepData
 FString SchemaReplicatedDataName(EReplicatedPropertyGroup Group, UStruct* Type, bool bPrependNamespace = false);
 
+// Given a replicated property group, Unreal type and array rep handle, generates the name of the type which holds delta updates to that array.
+// For example: UnrealCharacterMultiClientRepDataArrayDelta12
+FString SchemaArrayDeltaTypeName(EReplicatedPropertyGroup Group, UStruct* Type, uint16 Handle);
+
 // Given an unreal type, generates the name of the component which stores server to server replication data.
 // For example: UnrealCharacterHandoverData
 FString SchemaHandoverDataName(UStruct* Type, bool bPrependNamespace = false);
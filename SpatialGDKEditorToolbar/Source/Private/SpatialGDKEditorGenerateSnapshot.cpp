@@ -121,6 +121,12 @@ Worker_ComponentData CreateDeploymentData()
 	return DeploymentData;
 }
 
+Worker_ComponentData CreateObjectRefPathDictionaryData()
+{
+	// The dictionary starts empty. Paths are added by the servers as they are first written.
+	return ComponentFactory::CreateEmptyComponentData(SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID);
+}
+
 bool CreateGlobalStateManager(Worker_SnapshotOutputStream* OutputStream)
 {
 	Worker_Entity GSM;
@@ -135,12 +141,14 @@ bool CreateGlobalStateManager(Worker_SnapshotOutputStream* OutputStream)
 	ComponentWriteAcl.Add(SpatialConstants::ENTITY_ACL_COMPONENT_ID, UnrealServerPermission);
 	ComponentWriteAcl.Add(SpatialConstants::GLOBAL_STATE_MANAGER_COMPONENT_ID, UnrealServerPermission);
 	ComponentWriteAcl.Add(SpatialConstants::GLOBAL_STATE_MANAGER_DEPLOYMENT_COMPONENT_ID, UnrealServerPermission);
+	ComponentWriteAcl.Add(SpatialConstants::OBJECT_REF_PATH_DICTIONARY_COMPONENT_ID, UnrealServerPermission);
 
 	Components.Add(improbable::Position(Origin).CreatePositionData());
 	Components.Add(improbable::Metadata(TEXT("GlobalStateManager")).CreateMetadataData());
 	Components.Add(improbable::Persistence().CreatePersistenceData());
 	Components.Add(CreateGlobalStateManagerData());
 	Components.Add(CreateDeploymentData());
+	Components.Add(CreateObjectRefPathDictionaryData());
 	Components.Add(improbable::EntityAcl(UnrealServerPermission, ComponentWriteAcl).CreateEntityAclData());
 
 	GSM.component_count = Components.Num();